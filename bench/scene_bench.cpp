@@ -0,0 +1,751 @@
+// Micro-benchmarks for the scene code, run under an offscreen EGL context.
+//
+//   scene_bench [--shaders dir] [--font file.ttf] [--benchmark_filter=...] [--benchmark_format=json]
+//
+// Use --benchmark_out=results.json --benchmark_out_format=json to keep results per commit.
+
+#include "headless.h"
+#include "scene.h"
+#include "camera_control.h"
+#include "imgui/imgui.h"
+#include "imgui/imgui_internal.h"
+#include "imgui/backends/imgui_impl_opengl3.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+static std::string vertexShaderPath = "../shaders/vertex_shader.glsl";
+static std::string fragmentShaderPath = "../shaders/fragment_shader.glsl";
+static std::string cjkFontPath; // --font: a font with CJK glyphs for BM_ImFontAtlasStartup
+
+// generateSphere()/generateCone() only keep the VAO; find its buffers through the bindings
+static void deleteMeshVAO(GLuint vao)
+{
+    GLint vbo = 0, ebo = 0;
+    glBindVertexArray(vao);
+    glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &vbo);
+    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &ebo);
+    glBindVertexArray(0);
+    GLuint buffers[2] = {(GLuint)vbo, (GLuint)ebo};
+    glDeleteBuffers(2, buffers);
+    glDeleteVertexArrays(1, &vao);
+}
+
+static void BM_GenerateSphere(benchmark::State& state)
+{
+    GLuint sceneVAO = sphereVAO;
+    int sceneCount = sphereVertexCount;
+    for (auto _ : state) {
+        generateSphere(0.5f, (int)state.range(0), (int)state.range(1));
+        glFinish(); // include the upload
+        deleteMeshVAO(sphereVAO);
+    }
+    state.counters["triangles"] = sphereVertexCount / 3;
+    sphereVAO = sceneVAO;
+    sphereVertexCount = sceneCount;
+}
+BENCHMARK(BM_GenerateSphere)->Args({18, 9})->Args({36, 18})->Args({72, 36})->Args({144, 72})->Args({288, 144})->Args({576, 288})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_GenerateCone(benchmark::State& state)
+{
+    GLuint sceneVAO = coneVAO;
+    int sceneCount = coneVertexCount;
+    for (auto _ : state) {
+        generateCone(0.5f, 1.0f, (int)state.range(0));
+        glFinish();
+        deleteMeshVAO(coneVAO);
+    }
+    state.counters["triangles"] = coneVertexCount / 3;
+    coneVAO = sceneVAO;
+    coneVertexCount = sceneCount;
+}
+BENCHMARK(BM_GenerateCone)->RangeMultiplier(4)->Range(16, 16384)->Unit(benchmark::kMicrosecond);
+
+static void BM_GenerateCheckerboardTexture(benchmark::State& state)
+{
+    GLubyte color1[3] = {255, 255, 255};
+    GLubyte color2[3] = {0, 0, 0};
+    int size = (int)state.range(0);
+    for (auto _ : state) {
+        GLuint texture = generateCheckerboardTexture(size, size, color1, color2);
+        glFinish();
+        glDeleteTextures(1, &texture);
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)size * size * 3);
+}
+BENCHMARK(BM_GenerateCheckerboardTexture)->RangeMultiplier(2)->Range(64, 2048)->Unit(benchmark::kMicrosecond);
+
+static void BM_GetCameraViewMatrix(benchmark::State& state)
+{
+    float angle = 0.0f;
+    for (auto _ : state) {
+        cameraAngleX = angle;
+        angle += 0.1f;
+        glm::mat4 view = getCameraViewMatrix();
+        benchmark::DoNotOptimize(view);
+    }
+}
+BENCHMARK(BM_GetCameraViewMatrix);
+
+static void BM_LoadShaders(benchmark::State& state)
+{
+    for (auto _ : state) {
+        GLuint program = loadShaders(vertexShaderPath.c_str(), fragmentShaderPath.c_str());
+        if (program == 0) {
+            state.SkipWithError("shaders not found, pass --shaders <dir>");
+            break;
+        }
+        glDeleteProgram(program);
+    }
+}
+BENCHMARK(BM_LoadShaders)->Unit(benchmark::kMillisecond);
+
+// Whole frame into an offscreen target, waiting for the GPU each time
+static void BM_DrawSceneFrame(benchmark::State& state)
+{
+    OffscreenTarget target;
+    if (!createOffscreenTarget(target, (int)state.range(0), (int)state.range(1))) {
+        state.SkipWithError("offscreen target unavailable");
+        return;
+    }
+    int frame = 0;
+    for (auto _ : state) {
+        setScriptedCamera((frame++ % 360) / 360.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        drawScene();
+        glFinish();
+    }
+    state.counters["draw_calls"] = renderStats.drawCalls;
+    state.counters["triangles"] = (double)renderStats.triangles;
+    destroyOffscreenTarget(target);
+}
+BENCHMARK(BM_DrawSceneFrame)->Args({640, 480})->Args({1280, 720})->Args({1920, 1080})->Unit(benchmark::kMillisecond);
+
+// A UI-heavy frame: many windows (one draw list each) full of text, plots and widgets
+static void buildHeavyGui(int windows)
+{
+    static float values[256];
+    for (int i = 0; i < IM_ARRAYSIZE(values); ++i)
+        values[i] = sinf(i * 0.1f);
+    for (int w = 0; w < windows; ++w) {
+        char name[32];
+        snprintf(name, sizeof(name), "Window %d", w);
+        ImGui::SetNextWindowPos(ImVec2((float)(w % 8) * 150.0f, (float)(w / 8 % 2) * 350.0f)); // overlapping, never clipped
+        ImGui::SetNextWindowSize(ImVec2(150.0f, 350.0f));
+        ImGui::Begin(name);
+        for (int line = 0; line < 24; ++line)
+            ImGui::Text("Line %d: %f %f", line, values[line], values[line + 1]);
+        ImGui::PlotLines("Plot", values, IM_ARRAYSIZE(values), 0, nullptr, -1.0f, 1.0f, ImVec2(0, 60));
+        float slider = 0.5f;
+        ImGui::SliderFloat("Slider", &slider, 0.0f, 1.0f);
+        ImGui::Button("Button");
+        ImGui::End();
+    }
+}
+
+// ImGui_ImplOpenGL3_RenderDrawData() for the same UI frame, classic (0) or streaming (1) mode.
+// The 720p UI goes to a tiny target so that the upload and submission cost
+// is measured rather than rasterization (which dominates on software GL).
+static void BM_ImGuiRenderDrawData(benchmark::State& state)
+{
+    OffscreenTarget target;
+    if (!createOffscreenTarget(target, 16, 16)) {
+        state.SkipWithError("offscreen target unavailable");
+        return;
+    }
+    ImGuiContext* context = ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 720.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui_ImplOpenGL3_Init("#version 330");
+    ImGui_ImplOpenGL3_SetStreamingMode(state.range(0) != 0);
+
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui::NewFrame();
+    buildHeavyGui((int)state.range(1));
+    ImGui::Render();
+    ImDrawData* drawData = ImGui::GetDrawData();
+    for (auto _ : state) {
+        ImGui_ImplOpenGL3_RenderDrawData(drawData);
+        glFinish();
+    }
+    state.counters["draw_lists"] = drawData->CmdListsCount;
+    state.counters["vertices"] = drawData->TotalVtxCount;
+    state.counters["indices"] = drawData->TotalIdxCount;
+
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui::DestroyContext(context);
+    destroyOffscreenTarget(target);
+}
+BENCHMARK(BM_ImGuiRenderDrawData)->ArgNames({"streaming", "windows"})->ArgsProduct({{0, 1}, {4, 16, 64}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Labels the way widgets hash them: short ("Button", "##value"), long (window
+// and table paths) or with a "###" override, numbered like a generated UI would be
+static std::vector<std::string> hashLabels(int kind)
+{
+    static const char* shortNames[] = {"Button", "##value", "Enabled", "Color", "Slider", "X", "Apply", "##hidden"};
+    static const char* longNames[] = {"Scene Settings/Materials/Diffuse", "Light Parameters##MainPanel",
+                                      "GPU Profiler/Passes/ShadowMap/Cascades", "Frame Pacing/Render on demand"};
+    std::vector<std::string> labels;
+    char buffer[96];
+    for (int i = 0; i < 4096; ++i) {
+        if (kind == 0)
+            snprintf(buffer, sizeof(buffer), "%s %d", shortNames[i % 8], i / 8);
+        else if (kind == 1)
+            snprintf(buffer, sizeof(buffer), "%s %d", longNames[i % 4], i / 4);
+        else
+            snprintf(buffer, sizeof(buffer), "Value %.2f###item%d", i * 0.37f, i);
+        labels.push_back(buffer);
+    }
+    return labels;
+}
+
+// ImHashStr() over a label set (kind: 0 short, 1 long, 2 "###"), table (1) or
+// hardware CRC32C (2). Also checks both backends hash every label alike and
+// counts ID collisions within the set.
+static void BM_ImHashStr(benchmark::State& state)
+{
+    std::vector<std::string> labels = hashLabels((int)state.range(0));
+    ImGuiHashBackend backend = (ImGuiHashBackend)state.range(1);
+    if (!ImHashSetBackend(ImGuiHashBackend_Crc32cHw) && backend == ImGuiHashBackend_Crc32cHw) {
+        ImHashSetBackend(ImGuiHashBackend_Auto);
+        state.SkipWithError("no CRC32C instructions");
+        return;
+    }
+    std::unordered_map<ImGuiID, size_t> ids;
+    size_t collisions = 0, mismatches = 0, bytes = 0;
+    for (const std::string& label : labels) {
+        ImHashSetBackend(ImGuiHashBackend_Table);
+        ImGuiID id = ImHashStr(label.c_str(), 0, 0x1234);
+        ImHashSetBackend(ImGuiHashBackend_Crc32cHw);
+        mismatches += ImHashStr(label.c_str(), 0, 0x1234) != id;
+        collisions += !ids.insert({id, 0}).second;
+        bytes += label.size();
+    }
+    if (mismatches != 0) {
+        ImHashSetBackend(ImGuiHashBackend_Auto);
+        state.SkipWithError("hash backends disagree");
+        return;
+    }
+
+    ImHashSetBackend(backend);
+    for (auto _ : state)
+        for (const std::string& label : labels)
+            benchmark::DoNotOptimize(ImHashStr(label.c_str(), 0, 0x1234));
+    ImHashSetBackend(ImGuiHashBackend_Auto);
+    state.SetItemsProcessed(state.iterations() * labels.size());
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["collisions"] = (double)collisions;
+}
+BENCHMARK(BM_ImHashStr)->ArgNames({"labels", "backend"})->ArgsProduct({{0, 1, 2}, {1, 2}})
+    ->Unit(benchmark::kMicrosecond);
+
+// ImHashData() on what PushID()/GetID() feed it: ints and pointers
+static void BM_ImHashData(benchmark::State& state)
+{
+    ImGuiHashBackend backend = (ImGuiHashBackend)state.range(0);
+    if (!ImHashSetBackend(backend)) {
+        state.SkipWithError("no CRC32C instructions");
+        return;
+    }
+    std::vector<void*> pointers(4096);
+    for (size_t i = 0; i < pointers.size(); ++i)
+        pointers[i] = &pointers[i];
+    for (auto _ : state) {
+        ImGuiID seed = 0;
+        for (int i = 0; i < 4096; ++i)
+            seed = ImHashData(&i, sizeof(i), seed);
+        for (void* pointer : pointers)
+            seed = ImHashData(&pointer, sizeof(pointer), seed);
+        benchmark::DoNotOptimize(seed);
+    }
+    ImHashSetBackend(ImGuiHashBackend_Auto);
+    state.SetItemsProcessed(state.iterations() * 8192);
+}
+BENCHMARK(BM_ImHashData)->ArgNames({"backend"})->Arg(1)->Arg(2)->Unit(benchmark::kMicrosecond);
+
+// Distinct ImGuiStorage keys shaped like ImGui IDs
+static std::vector<ImGuiID> storageKeys(size_t count, ImGuiID seed)
+{
+    std::vector<ImGuiID> keys(count);
+    for (size_t i = 0; i < count; ++i)
+        keys[i] = ImHashData(&i, sizeof(i), seed);
+    return keys;
+}
+
+// SetInt() of n new keys into an empty storage, in ID (i.e. random) order
+static void BM_ImGuiStorageInsert(benchmark::State& state)
+{
+    std::vector<ImGuiID> keys = storageKeys((size_t)state.range(0), 0);
+    for (auto _ : state) {
+        ImGuiStorage storage;
+        for (size_t i = 0; i < keys.size(); ++i)
+            storage.SetInt(keys[i], (int)i);
+        benchmark::DoNotOptimize(storage.Data.Data);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+#ifdef IMGUI_STORAGE_USE_HASH_MAP
+BENCHMARK(BM_ImGuiStorageInsert)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+#else
+// Sorted insertion is quadratic: 1M keys would take minutes
+BENCHMARK(BM_ImGuiStorageInsert)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+#endif
+
+// GetInt() on a storage of n keys, half of the lookups hitting, like tree nodes
+// queried every frame next to ones that were never toggled
+static void BM_ImGuiStorageLookup(benchmark::State& state)
+{
+    std::vector<ImGuiID> keys = storageKeys((size_t)state.range(0), 0);
+    ImGuiStorage storage;
+    for (size_t i = 0; i < keys.size(); ++i)
+        storage.Data.push_back(ImGuiStoragePair(keys[i], (int)i));
+    storage.BuildSortByKey();
+    std::vector<ImGuiID> queries = storageKeys(keys.size() / 2, 1);
+    queries.insert(queries.end(), keys.begin(), keys.begin() + keys.size() / 2);
+    std::shuffle(queries.begin(), queries.end(), std::mt19937(42));
+    for (auto _ : state) {
+        int sum = 0;
+        for (ImGuiID key : queries)
+            sum += storage.GetInt(key, 0);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_ImGuiStorageLookup)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+
+// 1M points of plot-like data, as 100 shapes of 10k so every primitive fits 16-bit indices
+static const int tessellationShapes = 100;
+static const int tessellationShapePoints = 10000;
+
+static std::vector<ImVec2> tessellationPoints(bool polygon)
+{
+    std::vector<ImVec2> points((size_t)tessellationShapes * tessellationShapePoints);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-3.0f, 3.0f);
+    for (int s = 0; s < tessellationShapes; ++s) {
+        for (int i = 0; i < tessellationShapePoints; ++i) {
+            ImVec2& p = points[(size_t)s * tessellationShapePoints + i];
+            if (polygon) {
+                // Convex: a circle of radius 500, sampled finely
+                float a = (float)i / tessellationShapePoints * 6.2831853f;
+                p = ImVec2(640.0f + cosf(a) * 500.0f, 360.0f + sinf(a) * 500.0f);
+            } else {
+                p = ImVec2((float)i * 0.128f, 360.0f + sinf(i * 0.05f + s) * 200.0f + noise(rng));
+            }
+        }
+    }
+    return points;
+}
+
+// kind 0: 1 px AA polyline, 1: 3 px AA polyline, 2: AA convex fill
+static void tessellate(ImDrawList& list, const std::vector<ImVec2>& points, int kind)
+{
+    list._ResetForNewFrame();
+    list.Flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill | ImDrawListFlags_AllowVtxOffset;
+    for (int s = 0; s < tessellationShapes; ++s) {
+        const ImVec2* shape = points.data() + (size_t)s * tessellationShapePoints;
+        if (kind == 2)
+            list.AddConvexPolyFilled(shape, tessellationShapePoints, IM_COL32(200, 120, 40, 255));
+        else
+            list.AddPolyline(shape, tessellationShapePoints, IM_COL32_WHITE, ImDrawFlags_None, kind == 0 ? 1.0f : 3.0f);
+    }
+}
+
+// ImDrawList::AddPolyline()/AddConvexPolyFilled() with the scalar (simd 0) or SSE2 (simd 1)
+// normal computation; both must produce the same vertices and indices
+static void BM_ImDrawListTessellate(benchmark::State& state)
+{
+    int kind = (int)state.range(0);
+    std::vector<ImVec2> points = tessellationPoints(kind == 2);
+    ImDrawListSharedData shared;
+    shared.TexUvWhitePixel = ImVec2(0.5f, 0.5f);
+    ImDrawList list(&shared), reference(&shared);
+
+    ImDrawListSetSimdEnabled(false);
+    tessellate(reference, points, kind);
+    if (!ImDrawListSetSimdEnabled(true)) {
+        ImDrawListSetSimdEnabled(true);
+        if (state.range(1) != 0) {
+            state.SkipWithError("built without SSE2");
+            return;
+        }
+    }
+    tessellate(list, points, kind);
+    if (list.VtxBuffer.Size != reference.VtxBuffer.Size || list.IdxBuffer.Size != reference.IdxBuffer.Size ||
+        memcmp(list.VtxBuffer.Data, reference.VtxBuffer.Data, list.VtxBuffer.size_in_bytes()) != 0 ||
+        memcmp(list.IdxBuffer.Data, reference.IdxBuffer.Data, list.IdxBuffer.size_in_bytes()) != 0) {
+        state.SkipWithError("SIMD and scalar output differ");
+        return;
+    }
+
+    ImDrawListSetSimdEnabled(state.range(1) != 0);
+    for (auto _ : state) {
+        tessellate(list, points, kind);
+        benchmark::DoNotOptimize(list.VtxBuffer.Data);
+    }
+    ImDrawListSetSimdEnabled(true);
+    state.SetItemsProcessed(state.iterations() * points.size());
+    state.counters["vertices"] = list.VtxBuffer.Size;
+}
+BENCHMARK(BM_ImDrawListTessellate)->ArgNames({"kind", "simd"})->ArgsProduct({{0, 1, 2}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+// A dashboard window with large custom-drawn plots (background, grid, 12k-point line, label).
+// A primitive must stay under 64K vertices with 16-bit indices: 4 per point here.
+static const int dashboardPlots = 32;
+static const int dashboardPlotPoints = 12000;
+
+static void drawDashboardPlot(ImDrawList* drawList, const ImVec2* points, int plot, ImVec2 origin)
+{
+    const ImVec2 size(300.0f, 160.0f);
+    drawList->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(20, 20, 30, 255), 4.0f);
+    for (int i = 1; i < 10; ++i) {
+        float x = origin.x + size.x * i / 10.0f;
+        drawList->AddLine(ImVec2(x, origin.y), ImVec2(x, origin.y + size.y), IM_COL32(60, 60, 80, 255));
+    }
+    drawList->AddPolyline(points, dashboardPlotPoints, IM_COL32(90, 200, 255, 255), ImDrawFlags_None, 1.5f);
+    char label[32];
+    snprintf(label, sizeof(label), "Channel %d", plot);
+    drawList->AddText(ImVec2(origin.x + 6.0f, origin.y + 4.0f), IM_COL32_WHITE, label);
+}
+
+// threads 0: everything on the UI thread into the window draw list. Otherwise one detached
+// list per plot, filled by that many threads (the UI thread included) and appended in order.
+static ImDrawList* buildDashboard(const std::vector<ImVec2>& points, int threads, const std::vector<ImDrawList*>& detached)
+{
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(1280.0f, 720.0f));
+    ImGui::Begin("Dashboard");
+    ImDrawList* window = ImGui::GetWindowDrawList();
+    auto plotOrigin = [](int plot) { return ImVec2(10.0f + (plot % 4) * 310.0f, 30.0f + (plot / 4) * 170.0f); };
+    if (threads == 0) {
+        for (int plot = 0; plot < dashboardPlots; ++plot)
+            drawDashboardPlot(window, &points[(size_t)plot * dashboardPlotPoints], plot, plotOrigin(plot));
+    } else {
+        for (ImDrawList* list : detached)
+            ImGui::ResetDetachedDrawList(list);
+        std::atomic<int> nextPlot(0);
+        auto worker = [&]() {
+            for (int plot = nextPlot++; plot < dashboardPlots; plot = nextPlot++)
+                drawDashboardPlot(detached[plot], &points[(size_t)plot * dashboardPlotPoints], plot, plotOrigin(plot));
+        };
+        std::vector<std::thread> workers;
+        for (int i = 1; i < threads; ++i)
+            workers.emplace_back(worker);
+        worker();
+        for (std::thread& w : workers)
+            w.join();
+        for (ImDrawList* list : detached)
+            window->AppendDrawList(list);
+    }
+    ImGui::End();
+    ImGui::Render();
+    return window;
+}
+
+// The list's triangles as a flat vertex sequence, independent of how commands are split
+static std::vector<ImDrawVert> resolvedTriangles(const ImDrawList* list)
+{
+    std::vector<ImDrawVert> vertices;
+    for (const ImDrawCmd& cmd : list->CmdBuffer)
+        for (unsigned int i = 0; i < cmd.ElemCount; ++i)
+            vertices.push_back(list->VtxBuffer[cmd.VtxOffset + list->IdxBuffer[cmd.IdxOffset + i]]);
+    return vertices;
+}
+
+static void BM_ImGuiDetachedDrawLists(benchmark::State& state)
+{
+    int threads = (int)state.range(0);
+    ImGuiContext* context = ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 720.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    std::vector<ImVec2> points((size_t)dashboardPlots * dashboardPlotPoints);
+    for (int plot = 0; plot < dashboardPlots; ++plot) {
+        ImVec2 origin(10.0f + (plot % 4) * 310.0f, 30.0f + (plot / 4) * 170.0f);
+        for (int i = 0; i < dashboardPlotPoints; ++i)
+            points[(size_t)plot * dashboardPlotPoints + i] =
+                ImVec2(origin.x + 300.0f * i / dashboardPlotPoints, origin.y + 80.0f + sinf(i * 0.01f + plot) * 70.0f);
+    }
+    std::vector<ImDrawList*> detached;
+    for (int plot = 0; plot < dashboardPlots; ++plot)
+        detached.push_back(ImGui::CreateDetachedDrawList());
+
+    buildDashboard(points, 0, detached); // the window's first frame looks different
+    std::vector<ImDrawVert> reference = resolvedTriangles(buildDashboard(points, 0, detached));
+    std::vector<ImDrawVert> spliced = resolvedTriangles(buildDashboard(points, threads, detached));
+    if (reference.size() != spliced.size() ||
+        memcmp(reference.data(), spliced.data(), reference.size() * sizeof(ImDrawVert)) != 0) {
+        state.SkipWithError("detached draw lists changed the output");
+    } else {
+        for (auto _ : state)
+            buildDashboard(points, threads, detached);
+        state.counters["vertices"] = ImGui::GetDrawData()->TotalVtxCount;
+        state.counters["draw_calls"] = ImGui::GetDrawData()->CmdLists[0]->CmdBuffer.Size;
+    }
+
+    for (ImDrawList* list : detached)
+        ImGui::DestroyDetachedDrawList(list);
+    ImGui::DestroyContext(context);
+}
+BENCHMARK(BM_ImGuiDetachedDrawLists)->ArgNames({"threads"})->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// A long noisy recording with rare spikes, the case where per-pixel point sampling drops the peaks
+static std::vector<float> plotSeries(int count)
+{
+    std::vector<float> values(count);
+    uint32_t seed = 1;
+    for (int i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        values[i] = sinf(i * 0.0001f) + (seed >> 8) * (0.1f / 16777216.0f) + ((seed & 0xffff) == 0 ? 5.0f : 0.0f);
+    }
+    return values;
+}
+
+// One frame with a 1000 px plot over the whole series: PlotLines() (plot 0) against
+// PlotLinesMinMax() (plot 1), whose pyramid is built before the timed frames
+static void BM_ImGuiPlotLargeSeries(benchmark::State& state)
+{
+    int count = (int)state.range(0);
+    bool minMax = state.range(1) != 0;
+    std::vector<float> values = plotSeries(count);
+    ImGuiPlotPyramid pyramid;
+
+    ImGuiContext* context = ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 720.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    for (auto _ : state) {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(ImVec2(1100.0f, 300.0f));
+        ImGui::Begin("Plot");
+        if (minMax)
+            ImGui::PlotLinesMinMax("##series", values.data(), count, &pyramid, 0, -1, nullptr, FLT_MAX, FLT_MAX,
+                                   ImVec2(1000.0f, 200.0f));
+        else
+            ImGui::PlotLines("##series", values.data(), count, 0, nullptr, FLT_MAX, FLT_MAX, ImVec2(1000.0f, 200.0f));
+        ImGui::End();
+        ImGui::Render();
+    }
+    state.counters["vertices"] = ImGui::GetDrawData()->TotalVtxCount;
+    ImGui::DestroyContext(context);
+}
+BENCHMARK(BM_ImGuiPlotLargeSeries)->ArgNames({"samples", "minmax"})->ArgsProduct({{1000000, 10000000}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Pyramid upkeep: a full build of 10M samples (appended 0), or reducing each appended batch of a growing series
+static void BM_ImGuiPlotPyramidUpdate(benchmark::State& state)
+{
+    int count = 10000000;
+    int appended = (int)state.range(0);
+    std::vector<float> values = plotSeries(count);
+    ImGuiPlotPyramid pyramid;
+    int reduced = count;
+    for (auto _ : state) {
+        if (reduced + appended > count || appended == 0) {
+            state.PauseTiming();
+            pyramid.Clear();
+            reduced = appended == 0 ? 0 : count / 2;
+            pyramid.Update(values.data(), reduced);
+            state.ResumeTiming();
+        }
+        reduced = appended == 0 ? count : reduced + appended;
+        pyramid.Update(values.data(), reduced);
+    }
+    state.SetItemsProcessed(state.iterations() * (appended == 0 ? count : appended));
+}
+BENCHMARK(BM_ImGuiPlotPyramidUpdate)->ArgNames({"appended"})->Arg(0)->Arg(1000)->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+
+// Startup of a GUI with text: atlas build, texture upload and a first frame drawing some text in every font.
+// Everything in the ranges is prebuilt (dynamic 0), or only measured and rasterized when first drawn (dynamic 1).
+// The default font at 8 sizes, plus the --font file with the full CJK ranges when given.
+static void BM_ImFontAtlasStartup(benchmark::State& state)
+{
+    bool dynamic = state.range(0) != 0;
+    OffscreenTarget target;
+    if (!createOffscreenTarget(target, 16, 16)) {
+        state.SkipWithError("offscreen target unavailable");
+        return;
+    }
+    ImFontAtlasDynamicStats stats = {};
+    size_t textureBytes = 0;
+    int vertices = 0;
+    for (auto _ : state) {
+        ImFontAtlas* atlas = IM_NEW(ImFontAtlas)();
+        for (int size = 10; size < 42; size += 4) {
+            ImFontConfig config;
+            config.SizePixels = (float)size;
+            config.DynamicGlyphs = dynamic;
+            atlas->AddFontDefault(&config);
+        }
+        if (!cjkFontPath.empty()) {
+            ImFontConfig config;
+            config.DynamicGlyphs = dynamic;
+            config.OversampleH = 1;
+            atlas->AddFontFromFileTTF(cjkFontPath.c_str(), 20.0f, &config, atlas->GetGlyphRangesChineseFull());
+        }
+        ImGuiContext* context = ImGui::CreateContext(atlas);
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.DisplaySize = ImVec2(1280.0f, 720.0f);
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui_ImplOpenGL3_Init("#version 330");
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(ImVec2(1280.0f, 720.0f)); // Not auto-fit: would be hidden on its first frame
+        ImGui::Begin("Text");
+        for (ImFont* font : atlas->Fonts) {
+            ImGui::PushFont(font);
+            ImGui::TextUnformatted("The quick brown fox jumps over the lazy dog 0123456789");
+            ImGui::TextUnformatted("\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e \xe4\xb8\xad\xe6\x96\x87 \xed\x95\x9c\xea\xb5\xad\xec\x96\xb4");
+            ImGui::PopFont();
+        }
+        ImGui::End();
+        ImGui::Render();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        glFinish();
+        vertices = ImGui::GetDrawData()->TotalVtxCount;
+        textureBytes = (size_t)atlas->TexWidth * atlas->TexHeight * 4;
+        ImFontAtlasDynamicGetStats(atlas, &stats);
+        ImGui_ImplOpenGL3_Shutdown();
+        ImGui::DestroyContext(context);
+        IM_DELETE(atlas);
+    }
+    state.counters["texture_bytes"] = (double)textureBytes;
+    state.counters["rasterized_on_use"] = stats.GlyphsRasterized;
+    state.counters["vertices"] = vertices;
+    destroyOffscreenTarget(target);
+}
+BENCHMARK(BM_ImFontAtlasStartup)->ArgNames({"dynamic"})->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// The default font at 8 sizes, plus the --font file with the full CJK ranges when given
+static void addBenchFonts(ImFontAtlas& atlas)
+{
+    for (int size = 10; size < 42; size += 4) {
+        ImFontConfig config;
+        config.SizePixels = (float)size;
+        atlas.AddFontDefault(&config);
+    }
+    if (!cjkFontPath.empty())
+        atlas.AddFontFromFileTTF(cjkFontPath.c_str(), 20.0f, nullptr, atlas.GetGlyphRangesChineseFull());
+}
+
+// ImFontAtlas::Build() alone with the glyphs rasterized on 1..8 threads
+static void BM_ImFontAtlasBuild(benchmark::State& state)
+{
+    int threads = (int)state.range(0);
+    double rasterizeSeconds = 0.0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ImFontAtlas atlas;
+        atlas.BuildThreadCount = threads;
+        addBenchFonts(atlas);
+        state.ResumeTiming();
+        atlas.Build();
+        state.PauseTiming();
+        rasterizeSeconds = 0.0;
+        for (ImFont* font : atlas.Fonts)
+            rasterizeSeconds += font->MetricsBuildTime;
+        state.ResumeTiming();
+    }
+    // Summed over the fonts (and threads), as reported per font in the metrics window
+    state.counters["rasterize_ms"] = rasterizeSeconds * 1000.0;
+}
+BENCHMARK(BM_ImFontAtlasBuild)->ArgNames({"threads"})->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// ImFontAtlas::Build() of the same fonts, full (cached 0) or loaded from
+// ImFontAtlas::BuildCacheFilename (cached 1), written by one build before the timed ones
+static void BM_ImFontAtlasCache(benchmark::State& state)
+{
+    bool cached = state.range(0) != 0;
+    const char* cachePath = "scene_bench_fonts.cache";
+    remove(cachePath);
+    if (cached) {
+        ImFontAtlas atlas;
+        atlas.BuildCacheFilename = cachePath;
+        addBenchFonts(atlas);
+        atlas.Build();
+    }
+    for (auto _ : state) {
+        state.PauseTiming();
+        ImFontAtlas atlas;
+        atlas.BuildCacheFilename = cached ? cachePath : nullptr;
+        addBenchFonts(atlas);
+        state.ResumeTiming();
+        atlas.Build();
+        if (cached && !atlas.BuildCacheLoaded) {
+            state.SkipWithError("cache not loaded");
+            break;
+        }
+    }
+    if (FILE* f = fopen(cachePath, "rb")) {
+        fseek(f, 0, SEEK_END);
+        state.counters["file_bytes"] = (double)ftell(f);
+        fclose(f);
+    }
+    remove(cachePath);
+}
+BENCHMARK(BM_ImFontAtlasCache)->ArgNames({"cached"})->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--shaders") == 0 && i + 1 < argc) {
+            std::string dir = argv[++i];
+            vertexShaderPath = dir + "/vertex_shader.glsl";
+            fragmentShaderPath = dir + "/fragment_shader.glsl";
+        } else if (strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+            cjkFontPath = argv[++i];
+        }
+    }
+
+    if (!initHeadlessContext())
+        return 1;
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+    if (!initScene(vertexShaderPath.c_str(), fragmentShaderPath.c_str())) {
+        std::cerr << "Shader loading error (pass --shaders <dir>)." << std::endl;
+        shutdownHeadlessContext();
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    shutdownScene();
+    shutdownHeadlessContext();
+    return 0;
+}
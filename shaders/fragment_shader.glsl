@@ -4,14 +4,22 @@ in vec3 fragPos;
 in vec3 normalInterp;
 in vec2 texCoordInterp;
 
-uniform sampler2D textureSampler;
+uniform sampler2DArray textureSampler;
 uniform bool useTexture; // Флаг использования текстуры
-uniform vec3 lightPos;
-uniform vec3 viewPos;
-uniform vec3 lightColor;
-uniform float lightIntensity;
+uniform float textureLayer; // Слой текстурного массива
+uniform vec4 textureUVRect; // Область текстуры на слое: смещение (xy) и масштаб (zw)
 uniform float alpha; // Альфа-канал для прозрачности
 
+// Общие для кадра параметры, одинаковый блок в обоих шейдерах (FrameUniforms в scene.cpp)
+layout(std140) uniform FrameUniforms {
+    mat4 viewMatrix;
+    mat4 projectionMatrix;
+    vec3 lightPos;
+    vec3 viewPos;
+    vec3 lightColor;
+    float lightIntensity;
+};
+
 uniform vec3 ambientLight; // Фоновый свет
 
 // Параметры материала
@@ -26,7 +34,10 @@ void main()
 {
     vec3 color;
     if (useTexture) {
-        color = texture(textureSampler, texCoordInterp).rgb;
+        // Повторение внутри своей области слоя (для текстур, упакованных в атлас)
+        vec2 uv = textureUVRect.xy + fract(texCoordInterp) * textureUVRect.zw;
+        // materialDiffuse тонирует текстуру (белый у встроенных объектов)
+        color = texture(textureSampler, vec3(uv, textureLayer)).rgb * materialDiffuse;
     } else {
         color = materialDiffuse;
     }
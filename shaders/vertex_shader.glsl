@@ -5,8 +5,16 @@ layout(location = 1) in vec3 normal;
 layout(location = 2) in vec2 texCoord;
 
 uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
-uniform mat4 projectionMatrix;
+
+// Общие для кадра параметры, одинаковый блок в обоих шейдерах (FrameUniforms в scene.cpp)
+layout(std140) uniform FrameUniforms {
+    mat4 viewMatrix;
+    mat4 projectionMatrix;
+    vec3 lightPos;
+    vec3 viewPos;
+    vec3 lightColor;
+    float lightIntensity;
+};
 
 out vec3 fragPos;
 out vec3 normalInterp;
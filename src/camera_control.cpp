@@ -1,4 +1,5 @@
 #include "camera_control.h"
+#include "frame_scheduler.h"
 #include <cmath>
 
 float cameraAngleX = 45.0f;  // Camera rotation angle around X-axis
@@ -27,7 +28,7 @@ void handleMouseMotion(int x, int y) {
         lastX = x;
         lastY = y;
 
-        glutPostRedisplay();  // Refresh the scene after changing angles
+        requestRedraw();  // Refresh the scene after changing angles
     }
 }
 
@@ -40,7 +41,7 @@ void handleMouseWheel(int wheel, int direction, int x, int y) {
     }
     if (cameraDistance < 1.0f) cameraDistance = 1.0f; // Minimum distance limit
 
-    glutPostRedisplay();  // Refresh the scene after zooming
+    requestRedraw();  // Refresh the scene after zooming
 }
 
 glm::vec3 getCameraPosition()
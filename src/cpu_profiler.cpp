@@ -0,0 +1,170 @@
+#include "cpu_profiler.h"
+#include "json.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+#if defined(CPU_PROFILER_USE_RDTSC) && (defined(__x86_64__) || defined(_M_X64))
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define CPU_PROFILER_RDTSC 1
+#endif
+
+struct CpuEvent {
+    const char* name;
+    uint64_t begin;
+    uint64_t end;
+};
+
+// Ring slot. The export reads slots while their owner may overwrite them, so
+// every field is a relaxed atomic: a copy can mix two events, which the export
+// drops, but it never holds a torn name pointer.
+struct CpuEventSlot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> begin{0};
+    std::atomic<uint64_t> end{0};
+};
+
+// Events per thread; older ones are overwritten
+static const uint64_t threadBufferCapacity = 1 << 16;
+
+struct CpuThreadBuffer {
+    CpuEventSlot events[threadBufferCapacity];
+    std::atomic<uint64_t> written{0};   // total events ever written, only the owner thread stores
+    std::atomic<uint64_t> clearedAt{0}; // events before this index are ignored by the export
+    uint32_t threadId = 0;
+    CpuThreadBuffer* next = nullptr;
+};
+
+// Buffers are pushed once per thread and never freed, so events of exited
+// threads still make it into the export.
+static std::atomic<CpuThreadBuffer*> threadBuffers{nullptr};
+static std::atomic<uint32_t> nextThreadId{0};
+static std::atomic<bool> profilerEnabled{false};
+static thread_local CpuThreadBuffer* localBuffer = nullptr;
+
+static uint64_t steadyNanoseconds()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef CPU_PROFILER_RDTSC
+// Reference pair for converting TSC ticks to time at export
+static const uint64_t calibrationTicks = __rdtsc();
+static const uint64_t calibrationNanoseconds = steadyNanoseconds();
+#endif
+
+static CpuThreadBuffer* registerThread()
+{
+    CpuThreadBuffer* buffer = new CpuThreadBuffer();
+    buffer->threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    CpuThreadBuffer* head = threadBuffers.load(std::memory_order_relaxed);
+    do {
+        buffer->next = head;
+    } while (!threadBuffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+    return buffer;
+}
+
+void cpuProfilerSetEnabled(bool enabled)
+{
+    profilerEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool cpuProfilerIsEnabled()
+{
+    return profilerEnabled.load(std::memory_order_relaxed);
+}
+
+uint64_t cpuProfilerNow()
+{
+#ifdef CPU_PROFILER_RDTSC
+    return __rdtsc();
+#else
+    return steadyNanoseconds();
+#endif
+}
+
+void cpuProfilerRecord(const char* name, uint64_t begin, uint64_t end)
+{
+    if (localBuffer == nullptr)
+        localBuffer = registerThread();
+    uint64_t index = localBuffer->written.load(std::memory_order_relaxed);
+    CpuEventSlot& slot = localBuffer->events[index % threadBufferCapacity];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    localBuffer->written.store(index + 1, std::memory_order_release);
+}
+
+void cpuProfilerClear()
+{
+    for (CpuThreadBuffer* buffer = threadBuffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->next)
+        buffer->clearedAt.store(buffer->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+bool cpuProfilerExportChromeTrace(const char* path)
+{
+    struct ExportEvent {
+        CpuEvent event;
+        uint32_t threadId;
+    };
+    std::vector<ExportEvent> events;
+
+    for (CpuThreadBuffer* buffer = threadBuffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->next) {
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t first = std::max(buffer->clearedAt.load(std::memory_order_relaxed),
+                                  written > threadBufferCapacity ? written - threadBufferCapacity : 0);
+        size_t copiedFrom = events.size();
+        for (uint64_t i = first; i < written; ++i) {
+            const CpuEventSlot& slot = buffer->events[i % threadBufferCapacity];
+            CpuEvent event = {slot.name.load(std::memory_order_relaxed), slot.begin.load(std::memory_order_relaxed),
+                              slot.end.load(std::memory_order_relaxed)};
+            events.push_back({event, buffer->threadId});
+        }
+
+        // The owner kept writing while we copied: drop the slots it may have
+        // overwritten, including the one it is writing before publishing it
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t writtenAfter = buffer->written.load(std::memory_order_relaxed) + 1;
+        if (writtenAfter > threadBufferCapacity && writtenAfter - threadBufferCapacity > first) {
+            size_t overwritten = (size_t)std::min(writtenAfter - threadBufferCapacity - first, written - first);
+            events.erase(events.begin() + copiedFrom, events.begin() + copiedFrom + overwritten);
+        }
+    }
+
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out.is_open())
+        return false;
+
+#ifdef CPU_PROFILER_RDTSC
+    double ticksPerMicrosecond = (double)(__rdtsc() - calibrationTicks) /
+                                 ((steadyNanoseconds() - calibrationNanoseconds) / 1000.0);
+    auto toMicroseconds = [&](uint64_t ticks) { return (double)(ticks - calibrationTicks) / ticksPerMicrosecond; };
+#else
+    auto toMicroseconds = [](uint64_t nanoseconds) { return nanoseconds / 1000.0; };
+#endif
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const ExportEvent& e : events) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":";
+        writeJsonString(out, e.event.name);
+        double begin = toMicroseconds(e.event.begin);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.threadId
+            << ",\"ts\":" << begin
+            << ",\"dur\":" << toMicroseconds(e.event.end) - begin << "}";
+    }
+    out << "\n]}\n";
+    return out.good();
+}
@@ -0,0 +1,45 @@
+#ifndef CPU_PROFILER_H
+#define CPU_PROFILER_H
+
+// Scoped CPU profiler. Every thread records completed scopes into its own
+// ring buffer (no locks, no allocation after the first event); the export
+// reads all rings lock-free and writes Chrome trace-event JSON that loads in
+// chrome://tracing or Perfetto.
+//
+// A thread's ring (about 1.5 MB) is never freed, so only record from
+// long-lived threads; scopes on short-lived workers leak a ring per thread.
+//
+// Timestamps come from steady_clock, or from the TSC when CPU_PROFILER_USE_RDTSC
+// is defined on x86 (calibrated against steady_clock).
+//
+// Header is self-contained (no GL) so it can also be used from imgui.cpp
+// through IMGUI_PROFILE_SCOPE, see imgui_user_config.h.
+
+#include <cstdint>
+
+void cpuProfilerSetEnabled(bool enabled);
+bool cpuProfilerIsEnabled();
+
+uint64_t cpuProfilerNow();
+void cpuProfilerRecord(const char* name, uint64_t begin, uint64_t end);
+
+// Writes every event still held in the per-thread rings. Returns false if the file can't be written.
+bool cpuProfilerExportChromeTrace(const char* path);
+// Drops all recorded events (the rings stay allocated)
+void cpuProfilerClear();
+
+struct CpuProfileScope {
+    const char* name;
+    uint64_t begin;
+    explicit CpuProfileScope(const char* scopeName) : name(scopeName), begin(cpuProfilerIsEnabled() ? cpuProfilerNow() : 0) {}
+    ~CpuProfileScope() { if (begin != 0) cpuProfilerRecord(name, begin, cpuProfilerNow()); }
+    CpuProfileScope(const CpuProfileScope&) = delete;
+    CpuProfileScope& operator=(const CpuProfileScope&) = delete;
+};
+
+#define CPU_PROFILE_CONCAT_(a, b) a##b
+#define CPU_PROFILE_CONCAT(a, b) CPU_PROFILE_CONCAT_(a, b)
+#define CPU_PROFILE_SCOPE(name) CpuProfileScope CPU_PROFILE_CONCAT(cpuProfileScope, __LINE__)(name)
+#define CPU_PROFILE_FUNCTION() CPU_PROFILE_SCOPE(__func__)
+
+#endif // CPU_PROFILER_H
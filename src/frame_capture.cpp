@@ -0,0 +1,371 @@
+#include "frame_capture.h"
+#include "cpu_profiler.h"
+#include "scene.h"
+#ifdef SCENE_PNG
+#include "png_io.h"
+#endif
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Three PBOs give the GPU two frames to finish a readback before we need the slot again
+static const int captureRingSize = 3;
+// Frames the encoder may lag behind before we start dropping (bounds memory)
+static const int maxQueuedFrames = 8;
+
+struct CaptureSlot {
+    GLuint pbo = 0;
+    GLsync fence = nullptr;
+};
+
+struct CapturedFrame {
+    std::vector<uint8_t> rgba; // bottom-up rows, as returned by glReadPixels
+    long long index = 0;
+};
+
+static bool captureActive = false;
+static CaptureFormat captureFormat = CaptureFormat::Y4M;
+// PNG frame names are framePrefix + zero-padded index + frameSuffix; the user's
+// pattern never reaches printf as a format string
+static std::string framePrefix, frameSuffix;
+static int frameDigits = 0;
+static int captureWidth = 0;
+static int captureHeight = 0;
+
+static CaptureSlot slots[captureRingSize];
+static int slotNext = 0;     // slot the next readback goes to
+static int slotsPending = 0; // readbacks in flight, oldest at slotNext - slotsPending
+
+static FrameCaptureStats stats;
+
+// Render thread -> encoder thread; buffers come back through freeFrames to avoid reallocating
+static std::mutex queueMutex;
+static std::condition_variable queueCondition;
+static std::deque<CapturedFrame> queuedFrames;
+static std::vector<std::vector<uint8_t>> freeFrames;
+static bool encoderStop = false;
+static std::thread encoderThread;
+static FILE* y4mFile = nullptr;
+
+static size_t frameBytes()
+{
+    return (size_t)captureWidth * captureHeight * 4;
+}
+
+// BT.601 full range, matching the C420jpeg colour space in the Y4M header
+static void writeY4MFrame(const std::vector<uint8_t>& rgba, std::vector<uint8_t>& yuv)
+{
+    int w = captureWidth, h = captureHeight;
+    int cw = (w + 1) / 2, ch = (h + 1) / 2;
+    yuv.resize((size_t)w * h + 2 * (size_t)cw * ch);
+    uint8_t* yPlane = yuv.data();
+    uint8_t* uPlane = yPlane + (size_t)w * h;
+    uint8_t* vPlane = uPlane + (size_t)cw * ch;
+
+    // Source rows are bottom-up
+    auto pixel = [&](int x, int y) { return &rgba[((size_t)(h - 1 - y) * w + x) * 4]; };
+
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            const uint8_t* p = pixel(x, y);
+            yPlane[(size_t)y * w + x] = (uint8_t)std::min(255, (77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+        }
+    }
+    for (int cy = 0; cy < ch; ++cy) {
+        for (int cx = 0; cx < cw; ++cx) {
+            int r = 0, g = 0, b = 0;
+            for (int j = 0; j < 2; ++j) {
+                for (int i = 0; i < 2; ++i) {
+                    const uint8_t* p = pixel(std::min(cx * 2 + i, w - 1), std::min(cy * 2 + j, h - 1));
+                    r += p[0];
+                    g += p[1];
+                    b += p[2];
+                }
+            }
+            // Sums of 4 samples: shift by 2 more than the per-pixel coefficients
+            int u = ((-43 * r - 85 * g + 128 * b + 512) >> 10) + 128;
+            int v = ((128 * r - 107 * g - 21 * b + 512) >> 10) + 128;
+            uPlane[(size_t)cy * cw + cx] = (uint8_t)std::min(std::max(u, 0), 255);
+            vPlane[(size_t)cy * cw + cx] = (uint8_t)std::min(std::max(v, 0), 255);
+        }
+    }
+
+    fputs("FRAME\n", y4mFile);
+    fwrite(yuv.data(), 1, yuv.size(), y4mFile);
+}
+
+#ifdef SCENE_PNG
+static void writePNGFrame(const CapturedFrame& frame, std::vector<uint8_t>& flipped)
+{
+    size_t rowBytes = (size_t)captureWidth * 4;
+    flipped.resize(frameBytes());
+    for (int y = 0; y < captureHeight; ++y)
+        memcpy(&flipped[y * rowBytes], &frame.rgba[(captureHeight - 1 - y) * rowBytes], rowBytes);
+
+    char number[32];
+    snprintf(number, sizeof(number), "%0*d", frameDigits, (int)frame.index);
+    std::string path = framePrefix + number + frameSuffix;
+    if (!writePNG(path.c_str(), flipped.data(), captureWidth, captureHeight))
+        std::cerr << "Unable to write capture frame: " << path << std::endl;
+}
+#endif
+
+static void encoderMain()
+{
+    std::vector<uint8_t> scratch;
+    for (;;) {
+        CapturedFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [] { return encoderStop || !queuedFrames.empty(); });
+            if (queuedFrames.empty())
+                return; // stop requested and everything written
+            frame = std::move(queuedFrames.front());
+            queuedFrames.pop_front();
+        }
+
+        {
+            CPU_PROFILE_SCOPE("EncodeCaptureFrame");
+            if (captureFormat == CaptureFormat::Y4M)
+                writeY4MFrame(frame.rgba, scratch);
+#ifdef SCENE_PNG
+            else
+                writePNGFrame(frame, scratch);
+#endif
+        }
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stats.encoded++;
+        freeFrames.push_back(std::move(frame.rgba));
+    }
+}
+
+// Maps the oldest pending readback and queues it for the encoder
+static void collectSlot(CaptureSlot& slot)
+{
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    slotsPending--;
+
+    std::vector<uint8_t> rgba;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if ((int)queuedFrames.size() >= maxQueuedFrames) {
+            stats.droppedEncoder++;
+            return;
+        }
+        if (!freeFrames.empty()) {
+            rgba = std::move(freeFrames.back());
+            freeFrames.pop_back();
+        }
+    }
+    rgba.resize(frameBytes());
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameBytes(), GL_MAP_READ_BIT);
+    if (mapped) {
+        memcpy(rgba.data(), mapped, frameBytes());
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (!mapped)
+        return;
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    CapturedFrame frame;
+    frame.rgba = std::move(rgba);
+    frame.index = stats.captured++;
+    queuedFrames.push_back(std::move(frame));
+    queueCondition.notify_one();
+}
+
+// Collects finished readbacks in order; with wait = false stops at the first one still in flight
+static void collectSlots(bool wait)
+{
+    while (slotsPending > 0) {
+        CaptureSlot& slot = slots[(slotNext - slotsPending + captureRingSize) % captureRingSize];
+        GLuint64 timeout = wait ? 1000000000ull : 0;
+        GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED) {
+            if (!wait)
+                return;
+            // Give up on a readback the GPU never finished rather than hang on shutdown
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+            slotsPending--;
+            stats.droppedGpu++;
+            continue;
+        }
+        collectSlot(slot);
+    }
+}
+
+// Splits "frames/frame_%05d.png" around its frame number. Fails unless the pattern
+// holds exactly one %d or %0Nd and no other conversion (%% is a literal %).
+static bool splitFramePattern(const std::string& pattern, std::string& prefix, std::string& suffix, int& digits)
+{
+    bool found = false;
+    prefix.clear();
+    suffix.clear();
+    digits = 0;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        std::string& part = found ? suffix : prefix;
+        if (pattern[i] != '%') {
+            part += pattern[i];
+            continue;
+        }
+        if (i + 1 < pattern.size() && pattern[i + 1] == '%') {
+            part += '%';
+            ++i;
+            continue;
+        }
+        size_t end = i + 1;
+        int width = 0;
+        if (end < pattern.size() && pattern[end] == '0') {
+            for (++end; end < pattern.size() && pattern[end] >= '0' && pattern[end] <= '9' && width < 100; ++end)
+                width = width * 10 + (pattern[end] - '0');
+        }
+        if (found || end >= pattern.size() || pattern[end] != 'd' || width > 20)
+            return false;
+        found = true;
+        digits = width;
+        i = end;
+    }
+    return found;
+}
+
+bool startFrameCapture(const char* path, CaptureFormat format, int width, int height, int fps)
+{
+    if (captureActive || width <= 0 || height <= 0)
+        return false;
+
+#ifndef SCENE_PNG
+    if (format == CaptureFormat::PNGSequence) {
+        std::cerr << "PNG capture needs libpng" << std::endl;
+        return false;
+    }
+#endif
+
+    if (format == CaptureFormat::PNGSequence && !splitFramePattern(path, framePrefix, frameSuffix, frameDigits)) {
+        // Not a usable pattern: take the path literally and number the frames before the extension
+        framePrefix = path;
+        size_t dot = framePrefix.find_last_of('.');
+        size_t slash = framePrefix.find_last_of("/\\");
+        size_t split = dot != std::string::npos && (slash == std::string::npos || dot > slash) ? dot : framePrefix.size();
+        frameSuffix = framePrefix.substr(split);
+        framePrefix = framePrefix.substr(0, split) + "_";
+        frameDigits = 5;
+    }
+
+    captureFormat = format;
+    captureWidth = width;
+    captureHeight = height;
+
+    if (format == CaptureFormat::Y4M) {
+        y4mFile = fopen(path, "wb");
+        if (!y4mFile) {
+            std::cerr << "Unable to open capture file: " << path << std::endl;
+            return false;
+        }
+        fprintf(y4mFile, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height, fps > 0 ? fps : 60);
+    }
+
+    for (CaptureSlot& slot : slots) {
+        glGenBuffers(1, &slot.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes(), nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slotNext = 0;
+    slotsPending = 0;
+
+    stats = FrameCaptureStats();
+    queuedFrames.clear();
+    freeFrames.clear();
+    encoderStop = false;
+    encoderThread = std::thread(encoderMain);
+    captureActive = true;
+    return true;
+}
+
+void captureFrame()
+{
+    if (!captureActive)
+        return;
+    CPU_PROFILE_FUNCTION();
+
+    // A Y4M stream cannot change size mid-file
+    if (viewportWidth != captureWidth || viewportHeight != captureHeight) {
+        std::cerr << "Viewport resized, stopping frame capture" << std::endl;
+        stopFrameCapture();
+        return;
+    }
+
+    collectSlots(false);
+
+    if (slotsPending == captureRingSize) {
+        stats.droppedGpu++;
+        return;
+    }
+
+    CaptureSlot& slot = slots[slotNext];
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, captureWidth, captureHeight, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slotNext = (slotNext + 1) % captureRingSize;
+    slotsPending++;
+}
+
+void stopFrameCapture()
+{
+    if (!captureActive)
+        return;
+
+    collectSlots(true);
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        encoderStop = true;
+    }
+    queueCondition.notify_one();
+    encoderThread.join();
+
+    for (CaptureSlot& slot : slots) {
+        glDeleteBuffers(1, &slot.pbo);
+        slot.pbo = 0;
+    }
+    if (y4mFile) {
+        fclose(y4mFile);
+        y4mFile = nullptr;
+    }
+    freeFrames.clear();
+    captureActive = false;
+    std::cout << "Frame capture: " << stats.encoded << " frames written, "
+              << stats.droppedGpu + stats.droppedEncoder << " dropped" << std::endl;
+}
+
+bool isFrameCaptureActive()
+{
+    return captureActive;
+}
+
+FrameCaptureStats getFrameCaptureStats()
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    FrameCaptureStats result = stats;
+    result.queuedFrames = (int)queuedFrames.size();
+    return result;
+}
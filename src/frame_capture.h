@@ -0,0 +1,35 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+// Session recording without stalling the render thread: each frame is read
+// into one of a small ring of PBOs with a fence, mapped a few frames later
+// once the fence has signalled, and handed to an encoder thread.
+
+enum class CaptureFormat {
+    Y4M,        // single raw YUV 4:2:0 file, playable with ffplay/mpv
+    PNGSequence // one PNG per frame, path holds the number as %d or %0Nd ("frames/frame_%05d.png"),
+                // anything else gets _NNNNN before the extension
+};
+
+struct FrameCaptureStats {
+    long long captured = 0;       // frames read back and queued for encoding
+    long long encoded = 0;        // frames written by the encoder thread
+    long long droppedGpu = 0;     // every PBO still in flight, GPU too far behind
+    long long droppedEncoder = 0; // encoder queue full, disk too slow
+    int queuedFrames = 0;         // waiting for the encoder right now
+};
+
+// Starts recording width x height frames; fps is only written to the Y4M header
+bool startFrameCapture(const char* path, CaptureFormat format, int width, int height, int fps);
+
+// Call after rendering and before the swap: queues a readback of the current
+// read buffer and collects older readbacks that are ready. Never blocks.
+void captureFrame();
+
+// Waits for the readbacks in flight, drains the encoder and closes the output
+void stopFrameCapture();
+
+bool isFrameCaptureActive();
+FrameCaptureStats getFrameCaptureStats();
+
+#endif // FRAME_CAPTURE_H
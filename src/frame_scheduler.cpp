@@ -0,0 +1,164 @@
+#include "frame_scheduler.h"
+
+#include <GL/freeglut.h>
+#ifdef __linux__
+#include <GL/glx.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+static FrameSchedulerSettings settings;
+static SimulateFunc simulateFunc = nullptr;
+
+static Clock::time_point lastUpdateTime;
+static Clock::time_point lastPresentTime;
+static bool hasPresented = false;
+static double accumulator = 0.0;
+static float interpolationAlpha = 0.0f;
+static bool redrawRequested = true;
+static bool simulationActive = false;
+
+static FrameHistogram histogram;
+
+// Below this much remaining time we stop sleeping and spin: sleep_for
+// routinely overshoots by a scheduler quantum.
+static const double spinThresholdSeconds = 0.002;
+
+static void waitUntil(Clock::time_point deadline)
+{
+    auto remaining = std::chrono::duration<double>(deadline - Clock::now()).count();
+    if (remaining > spinThresholdSeconds) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(remaining - spinThresholdSeconds));
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+static void recordFrameTime(double frameMs)
+{
+    int bucket = std::min((int)(frameMs / frameHistogramBucketMs), frameHistogramBuckets - 1);
+    histogram.buckets[bucket] += 1.0f;
+    if (histogram.frameCount == 0) {
+        histogram.minMs = histogram.maxMs = frameMs;
+    } else {
+        histogram.minMs = std::min(histogram.minMs, frameMs);
+        histogram.maxMs = std::max(histogram.maxMs, frameMs);
+    }
+    histogram.frameCount++;
+}
+
+static void schedulerIdle()
+{
+    auto now = Clock::now();
+    double elapsed = std::chrono::duration<double>(now - lastUpdateTime).count();
+    lastUpdateTime = now;
+
+    // Clamp long stalls (debugger, window drag) so they don't turn into a burst of steps
+    accumulator += std::min(elapsed, 0.25);
+
+    int steps = 0;
+    bool active = false;
+    while (accumulator >= settings.simulationStep && steps < settings.maxStepsPerFrame) {
+        if (simulateFunc != nullptr) {
+            active = simulateFunc(settings.simulationStep) || active;
+        }
+        accumulator -= settings.simulationStep;
+        ++steps;
+    }
+    if (steps == settings.maxStepsPerFrame && accumulator >= settings.simulationStep) {
+        accumulator = 0.0;
+    }
+    if (steps > 0) {
+        simulationActive = active;
+    }
+    interpolationAlpha = (float)(accumulator / settings.simulationStep);
+
+    bool wantFrame = settings.renderMode == RenderMode::Continuous || redrawRequested || simulationActive;
+    if (!wantFrame) {
+        // Nothing to draw: don't burn a core polling
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return;
+    }
+
+    if (settings.targetFps > 0.0 && hasPresented) {
+        auto frameDuration = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / settings.targetFps));
+        waitUntil(lastPresentTime + frameDuration);
+    }
+
+    redrawRequested = false;
+    glutPostRedisplay();
+}
+
+void initFrameScheduler(SimulateFunc simulate)
+{
+    simulateFunc = simulate;
+    lastUpdateTime = Clock::now();
+    accumulator = 0.0;
+    hasPresented = false;
+    redrawRequested = true;
+    setVSync(settings.vsync);
+    glutIdleFunc(schedulerIdle);
+}
+
+void frameRendered()
+{
+    auto now = Clock::now();
+    if (hasPresented) {
+        recordFrameTime(std::chrono::duration<double, std::milli>(now - lastPresentTime).count());
+    }
+    lastPresentTime = now;
+    hasPresented = true;
+}
+
+void requestRedraw()
+{
+    redrawRequested = true;
+}
+
+float getFrameInterpolationAlpha()
+{
+    return interpolationAlpha;
+}
+
+FrameSchedulerSettings& getFrameSchedulerSettings()
+{
+    return settings;
+}
+
+void setVSync(bool enabled)
+{
+    settings.vsync = enabled;
+#ifdef __linux__
+    typedef int (*SwapIntervalMESA)(unsigned int);
+    typedef int (*SwapIntervalSGI)(int);
+    auto swapIntervalMESA = (SwapIntervalMESA)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalMESA");
+    if (swapIntervalMESA != nullptr) {
+        swapIntervalMESA(enabled ? 1 : 0);
+        return;
+    }
+    // SGI variant can't disable vsync on every driver, but it's the most widely exposed
+    auto swapIntervalSGI = (SwapIntervalSGI)glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalSGI");
+    if (swapIntervalSGI != nullptr) {
+        swapIntervalSGI(enabled ? 1 : 0);
+        return;
+    }
+#endif
+    std::cerr << "Swap interval control is not available, VSync setting ignored" << std::endl;
+}
+
+const FrameHistogram& getFrameHistogram()
+{
+    return histogram;
+}
+
+void resetFrameHistogram()
+{
+    histogram = FrameHistogram();
+}
@@ -0,0 +1,51 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+enum class RenderMode {
+    Continuous, // redraw every frame
+    OnDemand    // redraw only after requestRedraw() or while the simulation is active
+};
+
+struct FrameSchedulerSettings {
+    double simulationStep = 1.0 / 60.0; // fixed simulation timestep, seconds
+    int maxStepsPerFrame = 5;           // drop simulation time instead of spiralling on slow frames
+    RenderMode renderMode = RenderMode::Continuous;
+    bool vsync = true;
+    double targetFps = 0.0;             // frame-rate cap, 0 = uncapped
+};
+
+// Frame-time histogram: fixed-width buckets, the last one collects everything slower
+const int frameHistogramBuckets = 64;
+const double frameHistogramBucketMs = 0.5;
+
+struct FrameHistogram {
+    float buckets[frameHistogramBuckets] = {};
+    long long frameCount = 0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+};
+
+// Simulation callback, called with the fixed timestep. Returns true while
+// something is still changing (keeps on-demand rendering going).
+typedef bool (*SimulateFunc)(double dt);
+
+// Installs the GLUT idle callback that drives simulation and rendering
+void initFrameScheduler(SimulateFunc simulate);
+
+// Must be called by the display callback right after the buffer swap
+void frameRendered();
+
+// Asks for a redraw; in on-demand mode this is the only way (besides an
+// active simulation) to get a new frame.
+void requestRedraw();
+
+// Fraction of a simulation step accumulated since the last step, for
+// interpolating between the previous and the current simulation state.
+float getFrameInterpolationAlpha();
+
+FrameSchedulerSettings& getFrameSchedulerSettings();
+void setVSync(bool enabled);
+const FrameHistogram& getFrameHistogram();
+void resetFrameHistogram();
+
+#endif // FRAME_SCHEDULER_H
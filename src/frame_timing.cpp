@@ -0,0 +1,161 @@
+#include "frame_timing.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct TimingRing {
+    float values[frameTimingHistorySize] = {};
+    int next = 0;  // slot the next sample goes to
+    int count = 0; // valid samples, up to frameTimingHistorySize
+};
+
+static TimingRing rings[FrameTiming_Count];
+static std::vector<float> frameLog;
+static int frameLogGeneration = 0;
+
+static Clock::time_point frameBeginTime;
+static bool hasPreviousFrame = false;
+
+// GL_TIME_ELAPSED results arrive a few frames late; a small ring of queries
+// lets us read them back only once they are available instead of stalling.
+static const int gpuQueryRingSize = 4;
+static GLuint gpuQueries[gpuQueryRingSize] = {};
+static bool gpuQueryPending[gpuQueryRingSize] = {};
+static int gpuQueryNext = 0;
+static bool gpuQueryActive = false;
+
+static void pushSample(FrameTimingSeries series, float ms)
+{
+    TimingRing& ring = rings[series];
+    ring.values[ring.next] = ms;
+    ring.next = (ring.next + 1) % frameTimingHistorySize;
+    ring.count = std::min(ring.count + 1, frameTimingHistorySize);
+}
+
+static void collectGpuQueries()
+{
+    // Oldest query first so samples stay in frame order
+    for (int i = 0; i < gpuQueryRingSize; ++i) {
+        int slot = (gpuQueryNext + i) % gpuQueryRingSize;
+        if (!gpuQueryPending[slot])
+            continue;
+        GLint available = 0;
+        glGetQueryObjectiv(gpuQueries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(gpuQueries[slot], GL_QUERY_RESULT, &elapsedNs);
+        gpuQueryPending[slot] = false;
+        pushSample(FrameTiming_GPU, (float)(elapsedNs / 1.0e6));
+    }
+}
+
+void initFrameTiming()
+{
+    glGenQueries(gpuQueryRingSize, gpuQueries);
+    for (int i = 0; i < FrameTiming_Count; ++i)
+        rings[i] = TimingRing();
+    frameLog.clear();
+    ++frameLogGeneration;
+    hasPreviousFrame = false;
+}
+
+void shutdownFrameTiming()
+{
+    glDeleteQueries(gpuQueryRingSize, gpuQueries);
+    for (int i = 0; i < gpuQueryRingSize; ++i) {
+        gpuQueries[i] = 0;
+        gpuQueryPending[i] = false;
+    }
+}
+
+void beginFrameTiming()
+{
+    auto now = Clock::now();
+    if (hasPreviousFrame) {
+        float ms = std::chrono::duration<float, std::milli>(now - frameBeginTime).count();
+        pushSample(FrameTiming_Frame, ms);
+        if ((int)frameLog.size() == frameTimingLogCapacity) {
+            frameLog.erase(frameLog.begin(), frameLog.begin() + frameTimingLogCapacity / 2);
+            ++frameLogGeneration;
+        }
+        frameLog.push_back(ms);
+    }
+    frameBeginTime = now;
+    hasPreviousFrame = true;
+
+    collectGpuQueries();
+
+    // If the GPU is so far behind that the slot is still in flight, skip this frame's GPU sample
+    gpuQueryActive = gpuQueries[gpuQueryNext] != 0 && !gpuQueryPending[gpuQueryNext];
+    if (gpuQueryActive)
+        glBeginQuery(GL_TIME_ELAPSED, gpuQueries[gpuQueryNext]);
+}
+
+void endFrameTiming()
+{
+    if (gpuQueryActive) {
+        glEndQuery(GL_TIME_ELAPSED);
+        gpuQueryPending[gpuQueryNext] = true;
+        gpuQueryNext = (gpuQueryNext + 1) % gpuQueryRingSize;
+        gpuQueryActive = false;
+    }
+
+    pushSample(FrameTiming_CPU, std::chrono::duration<float, std::milli>(Clock::now() - frameBeginTime).count());
+}
+
+const float* getFrameTimingHistory(FrameTimingSeries series, int* offset, int* count)
+{
+    const TimingRing& ring = rings[series];
+    // Until the ring wraps, the samples sit in [0, count) oldest first
+    *count = ring.count;
+    *offset = ring.count < frameTimingHistorySize ? 0 : ring.next;
+    return ring.values;
+}
+
+const float* getFrameTimingLog(int* count, int* generation)
+{
+    *count = (int)frameLog.size();
+    *generation = frameLogGeneration;
+    return frameLog.data();
+}
+
+static float percentile(const float* sorted, int count, float p)
+{
+    int index = (int)(p * (count - 1) + 0.5f);
+    return sorted[std::min(std::max(index, 0), count - 1)];
+}
+
+FrameTimingStats computeTimingStats(const float* samples, int count)
+{
+    FrameTimingStats stats;
+    if (count <= 0)
+        return stats;
+
+    std::vector<float> sorted(samples, samples + count);
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0.0;
+    for (float sample : sorted)
+        sum += sample;
+
+    stats.samples = count;
+    stats.mean = (float)(sum / count);
+    stats.p50 = percentile(sorted.data(), count, 0.50f);
+    stats.p95 = percentile(sorted.data(), count, 0.95f);
+    stats.p99 = percentile(sorted.data(), count, 0.99f);
+    stats.max = sorted[count - 1];
+    return stats;
+}
+
+FrameTimingStats computeFrameTimingStats(FrameTimingSeries series)
+{
+    // The ring is filled from slot 0, so the first count slots are always the valid ones
+    const TimingRing& ring = rings[series];
+    return computeTimingStats(ring.values, ring.count);
+}
@@ -0,0 +1,47 @@
+#ifndef FRAME_TIMING_H
+#define FRAME_TIMING_H
+
+// Number of frames kept in the timing ring buffers
+const int frameTimingHistorySize = 240;
+// Cap of the session log (about 9 hours at 60 Hz); the oldest half is dropped when full
+const int frameTimingLogCapacity = 1 << 21;
+
+enum FrameTimingSeries {
+    FrameTiming_Frame, // begin-to-begin frame interval
+    FrameTiming_CPU,   // CPU time spent between beginFrameTiming() and endFrameTiming()
+    FrameTiming_GPU,   // GPU time for the same span (GL_TIME_ELAPSED, a few frames late)
+    FrameTiming_Count
+};
+
+struct FrameTimingStats {
+    float mean = 0.0f;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+    int samples = 0;
+};
+
+void initFrameTiming();
+void shutdownFrameTiming();
+
+// Bracket the rendering work of a frame (before drawing, before the swap)
+void beginFrameTiming();
+void endFrameTiming();
+
+// Ring buffer in milliseconds holding *count valid samples, oldest at *offset
+// (as expected by ImGui::PlotLines)
+const float* getFrameTimingHistory(FrameTimingSeries series, int* offset, int* count);
+
+// Frame intervals since initFrameTiming() in milliseconds, oldest first, at most
+// frameTimingLogCapacity of them. Appended to until old samples are dropped, which
+// changes *generation: clear any ImGui::PlotLinesMinMax() pyramid built before.
+const float* getFrameTimingLog(int* count, int* generation);
+
+// Rolling statistics over the samples currently in the ring
+FrameTimingStats computeFrameTimingStats(FrameTimingSeries series);
+
+// Same statistics over an arbitrary sample array (ms)
+FrameTimingStats computeTimingStats(const float* samples, int count);
+
+#endif // FRAME_TIMING_H
@@ -0,0 +1,140 @@
+#include "gl_state_cache.h"
+
+static GLStateCache cache;
+static bool synced = false;
+
+static bool* enabledFlag(GLenum cap)
+{
+    switch (cap) {
+    case GL_BLEND: return &cache.blend;
+    case GL_CULL_FACE: return &cache.cullFace;
+    case GL_DEPTH_TEST: return &cache.depthTest;
+    case GL_STENCIL_TEST: return &cache.stencilTest;
+    case GL_SCISSOR_TEST: return &cache.scissorTest;
+    case GL_PRIMITIVE_RESTART: return &cache.primitiveRestart;
+    default: return nullptr;
+    }
+}
+
+void syncGLStateCache()
+{
+    GLint value = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &value);
+    cache.program = (GLuint)value;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &value);
+    cache.vertexArray = (GLuint)value;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &value);
+    cache.arrayBuffer = (GLuint)value;
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &value);
+    cache.activeTexture = (GLenum)value;
+
+    // Bindings of unit 0, where the GUI renderer draws from
+    glActiveTexture(GL_TEXTURE0);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &value);
+    cache.texture2D = (GLuint)value;
+    glGetIntegerv(GL_SAMPLER_BINDING, &value);
+    cache.sampler = (GLuint)value;
+    glActiveTexture(cache.activeTexture);
+
+    glGetIntegerv(GL_VIEWPORT, cache.viewport);
+    glGetIntegerv(GL_SCISSOR_BOX, cache.scissorBox);
+    GLint blend[6];
+    glGetIntegerv(GL_BLEND_SRC_RGB, &blend[0]);
+    glGetIntegerv(GL_BLEND_DST_RGB, &blend[1]);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &blend[2]);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &blend[3]);
+    glGetIntegerv(GL_BLEND_EQUATION_RGB, &blend[4]);
+    glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &blend[5]);
+    cache.blendSrcRgb = (GLenum)blend[0];
+    cache.blendDstRgb = (GLenum)blend[1];
+    cache.blendSrcAlpha = (GLenum)blend[2];
+    cache.blendDstAlpha = (GLenum)blend[3];
+    cache.blendEquationRgb = (GLenum)blend[4];
+    cache.blendEquationAlpha = (GLenum)blend[5];
+    GLint polygonMode[2] = {GL_FILL, GL_FILL};
+    glGetIntegerv(GL_POLYGON_MODE, polygonMode);
+    cache.polygonMode[0] = (GLenum)polygonMode[0];
+    cache.polygonMode[1] = (GLenum)polygonMode[1];
+
+    const GLenum caps[] = {GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_STENCIL_TEST, GL_SCISSOR_TEST, GL_PRIMITIVE_RESTART};
+    for (GLenum cap : caps)
+        *enabledFlag(cap) = glIsEnabled(cap) == GL_TRUE;
+    synced = true;
+}
+
+bool isGLStateCacheSynced()
+{
+    return synced;
+}
+
+const GLStateCache& getGLStateCache()
+{
+    return cache;
+}
+
+void cachedUseProgram(GLuint program)
+{
+    if (synced && cache.program == program)
+        return;
+    glUseProgram(program);
+    cache.program = program;
+}
+
+void cachedBindVertexArray(GLuint vertexArray)
+{
+    if (synced && cache.vertexArray == vertexArray)
+        return;
+    glBindVertexArray(vertexArray);
+    cache.vertexArray = vertexArray;
+}
+
+void cachedBindArrayBuffer(GLuint buffer)
+{
+    if (synced && cache.arrayBuffer == buffer)
+        return;
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    cache.arrayBuffer = buffer;
+}
+
+void cachedActiveTexture(GLenum unit)
+{
+    if (synced && cache.activeTexture == unit)
+        return;
+    glActiveTexture(unit);
+    cache.activeTexture = unit;
+}
+
+void cachedSetEnabled(GLenum cap, bool enabled)
+{
+    bool* flag = enabledFlag(cap);
+    if (synced && flag && *flag == enabled)
+        return;
+    if (enabled)
+        glEnable(cap);
+    else
+        glDisable(cap);
+    if (flag)
+        *flag = enabled;
+}
+
+void cachedBlendFunc(GLenum src, GLenum dst)
+{
+    if (synced && cache.blendSrcRgb == src && cache.blendDstRgb == dst && cache.blendSrcAlpha == src &&
+        cache.blendDstAlpha == dst)
+        return;
+    glBlendFunc(src, dst);
+    cache.blendSrcRgb = cache.blendSrcAlpha = src;
+    cache.blendDstRgb = cache.blendDstAlpha = dst;
+}
+
+void cachedViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    if (synced && cache.viewport[0] == x && cache.viewport[1] == y && cache.viewport[2] == width &&
+        cache.viewport[3] == height)
+        return;
+    glViewport(x, y, width, height);
+    cache.viewport[0] = x;
+    cache.viewport[1] = y;
+    cache.viewport[2] = width;
+    cache.viewport[3] = height;
+}
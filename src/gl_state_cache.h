@@ -0,0 +1,45 @@
+#ifndef GL_STATE_CACHE_H
+#define GL_STATE_CACHE_H
+
+#include <GL/glew.h>
+
+// Shadow copy of the GL state the application and the ImGui renderer both
+// touch. Everything in the app changes that state through the cached*()
+// setters below, so redundant calls are skipped and the GUI renderer can be
+// told what is bound instead of asking the driver (every glGet may stall).
+struct GLStateCache {
+    GLuint program = 0;
+    GLuint vertexArray = 0;
+    GLuint arrayBuffer = 0;
+    GLenum activeTexture = GL_TEXTURE0;
+    GLuint texture2D = 0;       // GL_TEXTURE_2D binding on unit 0
+    GLuint sampler = 0;         // sampler bound to unit 0
+    GLint viewport[4] = {0, 0, 0, 0};
+    GLint scissorBox[4] = {0, 0, 0, 0};
+    GLenum blendSrcRgb = GL_ONE, blendDstRgb = GL_ZERO, blendSrcAlpha = GL_ONE, blendDstAlpha = GL_ZERO;
+    GLenum blendEquationRgb = GL_FUNC_ADD, blendEquationAlpha = GL_FUNC_ADD;
+    GLenum polygonMode[2] = {GL_FILL, GL_FILL}; // front, back
+    bool blend = false;
+    bool cullFace = false;
+    bool depthTest = false;
+    bool stencilTest = false;
+    bool scissorTest = false;
+    bool primitiveRestart = false;
+};
+
+// Reads the whole state once from the current context. Until then the
+// setters always forward to GL and the cache can't be trusted.
+void syncGLStateCache();
+bool isGLStateCacheSynced();
+const GLStateCache& getGLStateCache();
+
+void cachedUseProgram(GLuint program);
+void cachedBindVertexArray(GLuint vertexArray);
+void cachedBindArrayBuffer(GLuint buffer);
+void cachedActiveTexture(GLenum unit);
+// cap: GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_STENCIL_TEST, GL_SCISSOR_TEST or GL_PRIMITIVE_RESTART
+void cachedSetEnabled(GLenum cap, bool enabled);
+void cachedBlendFunc(GLenum src, GLenum dst);
+void cachedViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+#endif // GL_STATE_CACHE_H
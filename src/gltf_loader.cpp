@@ -0,0 +1,686 @@
+#include "gltf_loader.h"
+#include "cpu_profiler.h"
+#include "json.h"
+#include "mapped_file.h"
+#ifdef SCENE_PNG
+#include "png_io.h"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+// --- Buffers ---
+
+struct GltfBuffer {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+// Keeps mapped files and decoded data: URIs alive for the duration of the load
+struct GltfStorage {
+    std::vector<std::unique_ptr<MappedFile>> files;
+    std::vector<std::vector<uint8_t>> owned;
+};
+
+static bool decodeBase64(const char* text, size_t length, std::vector<uint8_t>& out)
+{
+    // Initialized once even when image workers decode data: URIs concurrently
+    static const std::array<int8_t, 256> table = [] {
+        std::array<int8_t, 256> t;
+        t.fill(-1);
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; ++i)
+            t[(unsigned char)alphabet[i]] = (int8_t)i;
+        return t;
+    }();
+    out.clear();
+    out.reserve(length / 4 * 3);
+    uint32_t accumulator = 0;
+    int bits = 0;
+    for (size_t i = 0; i < length; ++i) {
+        char c = text[i];
+        if (c == '=')
+            break;
+        int value = table[(unsigned char)c];
+        if (value < 0)
+            return false;
+        accumulator = (accumulator << 6) | (uint32_t)value;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back((uint8_t)(accumulator >> bits));
+        }
+    }
+    return true;
+}
+
+// URIs in glTF are percent-encoded relative paths
+static std::string decodeUri(const std::string& uri)
+{
+    std::string out;
+    for (size_t i = 0; i < uri.size(); ++i) {
+        if (uri[i] == '%' && i + 2 < uri.size()) {
+            out += (char)strtol(uri.substr(i + 1, 2).c_str(), nullptr, 16);
+            i += 2;
+        } else {
+            out += uri[i];
+        }
+    }
+    return out;
+}
+
+// Resolves a buffer or image URI: data: URIs are decoded, files are mapped next to the asset
+static bool loadUri(const std::string& uri, const std::string& baseDir, GltfStorage& storage, GltfBuffer& buffer)
+{
+    if (uri.compare(0, 5, "data:") == 0) {
+        size_t comma = uri.find(',');
+        if (comma == std::string::npos || uri.find(";base64", 0) > comma)
+            return false;
+        storage.owned.emplace_back();
+        if (!decodeBase64(uri.data() + comma + 1, uri.size() - comma - 1, storage.owned.back()))
+            return false;
+        buffer.data = storage.owned.back().data();
+        buffer.size = storage.owned.back().size();
+        return true;
+    }
+    auto file = std::make_unique<MappedFile>();
+    std::string path = baseDir + decodeUri(uri);
+    if (!file->open(path.c_str())) {
+        std::cerr << "Unable to open glTF resource: " << path << std::endl;
+        return false;
+    }
+    buffer.data = (const uint8_t*)file->data;
+    buffer.size = file->size;
+    storage.files.push_back(std::move(file));
+    return true;
+}
+
+// --- Accessors ---
+
+enum GltfComponentType {
+    Gltf_Byte = 5120,
+    Gltf_UnsignedByte = 5121,
+    Gltf_Short = 5122,
+    Gltf_UnsignedShort = 5123,
+    Gltf_UnsignedInt = 5125,
+    Gltf_Float = 5126,
+};
+
+struct AccessorView {
+    const uint8_t* data = nullptr;
+    size_t count = 0;
+    size_t stride = 0;
+    int componentType = 0;
+    int components = 0;
+    bool normalized = false;
+};
+
+static size_t componentSize(int componentType)
+{
+    switch (componentType) {
+    case Gltf_Byte: case Gltf_UnsignedByte: return 1;
+    case Gltf_Short: case Gltf_UnsignedShort: return 2;
+    case Gltf_UnsignedInt: case Gltf_Float: return 4;
+    default: return 0;
+    }
+}
+
+static int componentCount(const std::string& type)
+{
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    if (type == "MAT4") return 16;
+    return 0;
+}
+
+// Reads a byte offset, length or count: absent gives the fallback, anything but
+// a non-negative integer exactly representable as a double fails
+static bool readSize(const JsonValue& value, size_t fallback, size_t& out)
+{
+    if (value.isNull()) {
+        out = fallback;
+        return true;
+    }
+    double number = value.asNumber(-1.0);
+    if (!(number >= 0.0 && number <= 9007199254740992.0) || number != std::floor(number))
+        return false;
+    out = (size_t)number;
+    return true;
+}
+
+// Resolves an accessor to a strided view into its buffer, checking every byte it covers
+static bool getAccessor(const JsonValue& doc, const std::vector<GltfBuffer>& buffers, int index, AccessorView& view)
+{
+    const JsonValue& accessor = doc["accessors"][(size_t)index];
+    const JsonValue& bufferView = doc["bufferViews"][(size_t)accessor["bufferView"].asInt()];
+    if (accessor.isNull() || bufferView.isNull() || !accessor["sparse"].isNull())
+        return false; // sparse and buffer-less accessors are not supported
+
+    int bufferIndex = bufferView["buffer"].asInt();
+    if (bufferIndex < 0 || bufferIndex >= (int)buffers.size())
+        return false;
+    const GltfBuffer& buffer = buffers[bufferIndex];
+
+    view.componentType = accessor["componentType"].asInt();
+    view.components = componentCount(accessor["type"].asString());
+    view.normalized = accessor["normalized"].asBool();
+    size_t elementSize = componentSize(view.componentType) * view.components;
+    if (elementSize == 0)
+        return false;
+    size_t viewOffset, viewLength, accessorOffset;
+    if (!readSize(accessor["count"], 0, view.count) || !readSize(bufferView["byteStride"], elementSize, view.stride) ||
+        !readSize(bufferView["byteOffset"], 0, viewOffset) || !readSize(bufferView["byteLength"], 0, viewLength) ||
+        !readSize(accessor["byteOffset"], 0, accessorOffset))
+        return false;
+
+    // Written so that nothing can wrap around
+    if (viewOffset > buffer.size || viewLength > buffer.size - viewOffset)
+        return false;
+    if (accessorOffset > viewLength)
+        return false;
+    if (view.count > 0) {
+        size_t available = viewLength - accessorOffset;
+        if (elementSize > available || (view.count > 1 && (view.stride == 0 ||
+                                                           view.count - 1 > (available - elementSize) / view.stride)))
+            return false;
+    }
+    view.data = buffer.data + viewOffset + accessorOffset;
+    return true;
+}
+
+static float readComponent(const AccessorView& view, size_t element, int component)
+{
+    const uint8_t* p = view.data + element * view.stride + component * componentSize(view.componentType);
+    switch (view.componentType) {
+    case Gltf_Float: { float v; memcpy(&v, p, 4); return v; }
+    case Gltf_UnsignedByte: return view.normalized ? *p / 255.0f : *p;
+    case Gltf_Byte: { int8_t v = (int8_t)*p; return view.normalized ? std::max(v / 127.0f, -1.0f) : v; }
+    case Gltf_UnsignedShort: { uint16_t v; memcpy(&v, p, 2); return view.normalized ? v / 65535.0f : v; }
+    case Gltf_Short: { int16_t v; memcpy(&v, p, 2); return view.normalized ? std::max(v / 32767.0f, -1.0f) : v; }
+    case Gltf_UnsignedInt: { uint32_t v; memcpy(&v, p, 4); return (float)v; }
+    default: return 0.0f;
+    }
+}
+
+static uint32_t readIndex(const AccessorView& view, size_t element)
+{
+    const uint8_t* p = view.data + element * view.stride;
+    switch (view.componentType) {
+    case Gltf_UnsignedByte: return *p;
+    case Gltf_UnsignedShort: { uint16_t v; memcpy(&v, p, 2); return v; }
+    case Gltf_UnsignedInt: { uint32_t v; memcpy(&v, p, 4); return v; }
+    default: return 0xFFFFFFFFu;
+    }
+}
+
+// Converts one primitive to the 8-float vertex layout
+static bool decodePrimitive(const JsonValue& doc, const std::vector<GltfBuffer>& buffers,
+                            const JsonValue& primitive, MeshData& mesh)
+{
+    const JsonValue& attributes = primitive["attributes"];
+    AccessorView positions, normals, texcoords, indices;
+    if (!getAccessor(doc, buffers, attributes["POSITION"].asInt(), positions) || positions.components != 3)
+        return false;
+    bool hasNormals = getAccessor(doc, buffers, attributes["NORMAL"].asInt(), normals) &&
+                      normals.components == 3 && normals.count == positions.count;
+    bool hasTexcoords = getAccessor(doc, buffers, attributes["TEXCOORD_0"].asInt(), texcoords) &&
+                        texcoords.components == 2 && texcoords.count == positions.count;
+
+    mesh.vertices.resize(positions.count * 8);
+    for (size_t i = 0; i < positions.count; ++i) {
+        float* out = &mesh.vertices[i * 8];
+        for (int c = 0; c < 3; ++c)
+            out[c] = readComponent(positions, i, c);
+        for (int c = 0; c < 3; ++c)
+            out[3 + c] = hasNormals ? readComponent(normals, i, c) : 0.0f;
+        out[6] = hasTexcoords ? readComponent(texcoords, i, 0) : 0.0f;
+        out[7] = hasTexcoords ? readComponent(texcoords, i, 1) : 0.0f;
+    }
+
+    if (!primitive["indices"].isNull()) {
+        if (!getAccessor(doc, buffers, primitive["indices"].asInt(), indices) || indices.components != 1)
+            return false;
+        mesh.indices.resize(indices.count);
+        for (size_t i = 0; i < indices.count; ++i) {
+            mesh.indices[i] = readIndex(indices, i);
+            if (mesh.indices[i] >= positions.count)
+                return false;
+        }
+    } else {
+        mesh.indices.resize(positions.count);
+        for (size_t i = 0; i < positions.count; ++i)
+            mesh.indices[i] = (uint32_t)i;
+    }
+    mesh.indices.resize(mesh.indices.size() / 3 * 3);
+
+    if (!hasNormals)
+        computeMeshNormals(mesh);
+    computeMeshBounds(mesh);
+    return true;
+}
+
+// --- Images ---
+
+#ifdef SCENE_PNG
+// Box-filters (or point-samples when enlarging) RGBA down to size x size RGB
+static void resampleToRGB(const std::vector<uint8_t>& rgba, int width, int height, int size, GltfImage& image)
+{
+    image.width = size;
+    image.height = size;
+    image.rgb.resize((size_t)size * size * 3);
+    for (int y = 0; y < size; ++y) {
+        int y0 = y * height / size, y1 = std::max(y0 + 1, (y + 1) * height / size);
+        for (int x = 0; x < size; ++x) {
+            int x0 = x * width / size, x1 = std::max(x0 + 1, (x + 1) * width / size);
+            unsigned sum[3] = {0, 0, 0};
+            for (int sy = y0; sy < y1; ++sy) {
+                const uint8_t* row = &rgba[((size_t)sy * width + x0) * 4];
+                for (int sx = x0; sx < x1; ++sx, row += 4) {
+                    sum[0] += row[0];
+                    sum[1] += row[1];
+                    sum[2] += row[2];
+                }
+            }
+            unsigned count = (unsigned)((y1 - y0) * (x1 - x0));
+            uint8_t* out = &image.rgb[((size_t)y * size + x) * 3];
+            for (int c = 0; c < 3; ++c)
+                out[c] = (uint8_t)((sum[c] + count / 2) / count);
+        }
+    }
+}
+
+#endif
+
+static bool decodeImage(const JsonValue& doc, const std::vector<GltfBuffer>& buffers, const JsonValue& imageJson,
+                        const std::string& baseDir, int size, GltfImage& image)
+{
+    GltfBuffer encoded;
+    GltfStorage storage; // external image files / data URIs, only needed while decoding
+    if (!imageJson["bufferView"].isNull()) {
+        const JsonValue& bufferView = doc["bufferViews"][(size_t)imageJson["bufferView"].asInt()];
+        int bufferIndex = bufferView["buffer"].asInt();
+        if (bufferIndex < 0 || bufferIndex >= (int)buffers.size())
+            return false;
+        size_t offset = 0, length = 0;
+        if (!readSize(bufferView["byteOffset"], 0, offset) || !readSize(bufferView["byteLength"], 0, length) ||
+            offset > buffers[bufferIndex].size || length > buffers[bufferIndex].size - offset)
+            return false;
+        encoded.data = buffers[bufferIndex].data + offset;
+        encoded.size = length;
+    } else if (!loadUri(imageJson["uri"].asString(), baseDir, storage, encoded)) {
+        return false;
+    }
+
+    static const uint8_t pngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (encoded.size < 8 || memcmp(encoded.data, pngSignature, 8) != 0)
+        return false;
+#ifdef SCENE_PNG
+    std::vector<uint8_t> rgba;
+    int width = 0, height = 0;
+    if (!decodePNG(encoded.data, encoded.size, rgba, width, height) || width <= 0 || height <= 0)
+        return false;
+    resampleToRGB(rgba, width, height, size, image);
+    return true;
+#else
+    (void)size;
+    (void)image;
+    return false;
+#endif
+}
+
+// --- Materials and nodes ---
+
+static GltfMaterial convertMaterial(const JsonValue& doc, const JsonValue& materialJson)
+{
+    GltfMaterial material;
+    const JsonValue& pbr = materialJson["pbrMetallicRoughness"];
+    const JsonValue& baseColor = pbr["baseColorFactor"];
+    for (int c = 0; c < 3; ++c)
+        material.diffuse[c] = (float)baseColor[(size_t)c].asNumber(1.0);
+    if (materialJson["alphaMode"].asString() == "BLEND")
+        material.alpha = (float)baseColor[3].asNumber(1.0);
+
+    // Metals reflect their base color, dielectrics ~4% white; rough surfaces get
+    // a dimmer, wider highlight (Blinn-Phong exponent from roughness)
+    float metallic = (float)pbr["metallicFactor"].asNumber(1.0);
+    float roughness = std::min(std::max((float)pbr["roughnessFactor"].asNumber(1.0), 0.05f), 1.0f);
+    for (int c = 0; c < 3; ++c)
+        material.specular[c] = (0.04f + (material.diffuse[c] - 0.04f) * metallic) * (1.0f - 0.5f * roughness);
+    float r4 = roughness * roughness * roughness * roughness;
+    material.shininess = std::min(std::max(2.0f / r4 - 2.0f, 1.0f), 256.0f);
+
+    const JsonValue& texture = doc["textures"][(size_t)pbr["baseColorTexture"]["index"].asInt()];
+    material.image = texture["source"].asInt();
+    return material;
+}
+
+static void multiply(const float* a, const float* b, float* out)
+{
+    float result[16];
+    for (int column = 0; column < 4; ++column)
+        for (int row = 0; row < 4; ++row)
+            result[column * 4 + row] = a[row] * b[column * 4] + a[4 + row] * b[column * 4 + 1] +
+                                       a[8 + row] * b[column * 4 + 2] + a[12 + row] * b[column * 4 + 3];
+    memcpy(out, result, sizeof(result));
+}
+
+// Node transform: either "matrix" or T * R * S
+// Of the upper 3x3 of a column-major 4x4; negative for transforms that mirror
+static float determinant3x3(const float* m)
+{
+    return m[0] * (m[5] * m[10] - m[9] * m[6]) - m[4] * (m[1] * m[10] - m[9] * m[2]) +
+           m[8] * (m[1] * m[6] - m[5] * m[2]);
+}
+
+static void localTransform(const JsonValue& node, float* out)
+{
+    const JsonValue& matrix = node["matrix"];
+    if (matrix.size() == 16) {
+        for (int i = 0; i < 16; ++i)
+            out[i] = (float)matrix[(size_t)i].asNumber();
+        return;
+    }
+    const JsonValue& t = node["translation"];
+    const JsonValue& r = node["rotation"];
+    const JsonValue& s = node["scale"];
+    float x = (float)r[0].asNumber(0.0), y = (float)r[1].asNumber(0.0);
+    float z = (float)r[2].asNumber(0.0), w = (float)r[3].asNumber(1.0);
+    float sx = (float)s[0].asNumber(1.0), sy = (float)s[1].asNumber(1.0), sz = (float)s[2].asNumber(1.0);
+    float rotation[9] = {
+        1 - 2 * (y * y + z * z), 2 * (x * y + z * w),     2 * (x * z - y * w),
+        2 * (x * y - z * w),     1 - 2 * (x * x + z * z), 2 * (y * z + x * w),
+        2 * (x * z + y * w),     2 * (y * z - x * w),     1 - 2 * (x * x + y * y),
+    };
+    float scale[3] = {sx, sy, sz};
+    for (int column = 0; column < 3; ++column) {
+        for (int row = 0; row < 3; ++row)
+            out[column * 4 + row] = rotation[column * 3 + row] * scale[column];
+        out[column * 4 + 3] = 0.0f;
+    }
+    out[12] = (float)t[0].asNumber(0.0);
+    out[13] = (float)t[1].asNumber(0.0);
+    out[14] = (float)t[2].asNumber(0.0);
+    out[15] = 1.0f;
+}
+
+static void expandBounds(const float* transform, const MeshData& mesh, GltfScene& scene, bool& first)
+{
+    for (int corner = 0; corner < 8; ++corner) {
+        float p[3] = {(corner & 1) ? mesh.boundsMax[0] : mesh.boundsMin[0],
+                      (corner & 2) ? mesh.boundsMax[1] : mesh.boundsMin[1],
+                      (corner & 4) ? mesh.boundsMax[2] : mesh.boundsMin[2]};
+        for (int k = 0; k < 3; ++k) {
+            float world = transform[k] * p[0] + transform[4 + k] * p[1] + transform[8 + k] * p[2] + transform[12 + k];
+            scene.boundsMin[k] = first ? world : std::min(scene.boundsMin[k], world);
+            scene.boundsMax[k] = first ? world : std::max(scene.boundsMax[k], world);
+        }
+        first = false;
+    }
+}
+
+bool loadGltf(const char* path, GltfScene& scene, int textureSize, GltfLoadStats* stats)
+{
+    CPU_PROFILE_FUNCTION();
+    GltfLoadStats localStats;
+    GltfLoadStats& s = stats ? *stats : localStats;
+    scene = GltfScene();
+
+    std::string pathString = path;
+    size_t slash = pathString.find_last_of('/');
+    std::string baseDir = slash == std::string::npos ? std::string() : pathString.substr(0, slash + 1);
+
+    // --- Read: map the asset, split GLB chunks ---
+    auto phaseBegin = Clock::now();
+    MappedFile file;
+    if (!file.open(path) || file.size == 0) {
+        std::cerr << "Unable to open glTF: " << path << std::endl;
+        return false;
+    }
+    const uint8_t* bytes = (const uint8_t*)file.data;
+    const char* jsonText = file.data;
+    size_t jsonLength = file.size;
+    GltfBuffer glbBinary;
+    if (file.size >= 12 && memcmp(bytes, "glTF", 4) == 0) {
+        uint32_t header[3], chunk[2];
+        memcpy(header, bytes, 12);
+        if (header[1] != 2 || header[2] > file.size || file.size < 20) {
+            std::cerr << "Unsupported GLB container: " << path << std::endl;
+            return false;
+        }
+        memcpy(chunk, bytes + 12, 8);
+        if (chunk[1] != 0x4E4F534Au || 20 + (size_t)chunk[0] > header[2]) { // "JSON"
+            std::cerr << "GLB without a JSON chunk: " << path << std::endl;
+            return false;
+        }
+        jsonText = file.data + 20;
+        jsonLength = chunk[0];
+        size_t binOffset = 20 + ((size_t)chunk[0] + 3) / 4 * 4;
+        if (binOffset + 8 <= header[2]) {
+            memcpy(chunk, bytes + binOffset, 8);
+            if (chunk[1] == 0x004E4942u && binOffset + 8 + chunk[0] <= header[2]) { // "BIN"
+                glbBinary.data = bytes + binOffset + 8;
+                glbBinary.size = chunk[0];
+            }
+        }
+    }
+
+    // --- JSON ---
+    auto jsonBegin = Clock::now();
+    JsonValue doc;
+    std::string error;
+    if (!parseJson(jsonText, jsonLength, doc, error)) {
+        std::cerr << "Invalid glTF JSON in " << path << ": " << error << std::endl;
+        return false;
+    }
+    s.jsonMs = elapsedMs(jsonBegin);
+    if (doc["asset"]["version"].asString().compare(0, 1, "2") != 0) {
+        std::cerr << "Only glTF 2.0 is supported: " << path << std::endl;
+        return false;
+    }
+
+    GltfStorage storage;
+    std::vector<GltfBuffer> buffers;
+    s.bytes = jsonLength;
+    for (size_t i = 0; i < doc["buffers"].size(); ++i) {
+        const JsonValue& bufferJson = doc["buffers"][i];
+        GltfBuffer buffer;
+        if (bufferJson["uri"].isNull()) {
+            buffer = glbBinary;
+        } else if (!loadUri(bufferJson["uri"].asString(), baseDir, storage, buffer)) {
+            std::cerr << "Unable to load glTF buffer " << i << " of " << path << std::endl;
+            return false;
+        }
+        size_t declaredLength = 0;
+        if (!readSize(bufferJson["byteLength"], 0, declaredLength)) {
+            std::cerr << "Invalid byteLength for glTF buffer " << i << " in " << path << std::endl;
+            return false;
+        }
+        if (buffer.size < declaredLength) {
+            std::cerr << "glTF buffer " << i << " is shorter than declared in " << path << std::endl;
+            return false;
+        }
+        s.bytes += buffer.size;
+        buffers.push_back(buffer);
+    }
+    s.readMs = elapsedMs(phaseBegin) - s.jsonMs;
+
+    // --- Decode: every image and every triangle primitive is an independent task ---
+    auto decodeBegin = Clock::now();
+    struct PrimitiveTask {
+        const JsonValue* json;
+        int meshIndex;
+    };
+    std::vector<PrimitiveTask> primitiveTasks;
+    std::vector<std::vector<int>> meshPrimitives(doc["meshes"].size()); // mesh -> GltfScene::primitives
+    for (size_t m = 0; m < doc["meshes"].size(); ++m) {
+        const JsonValue& primitives = doc["meshes"][m]["primitives"];
+        for (size_t p = 0; p < primitives.size(); ++p) {
+            if (primitives[p]["mode"].asInt(4) != 4)
+                continue; // points, lines and strips are not imported
+            meshPrimitives[m].push_back((int)primitiveTasks.size());
+            primitiveTasks.push_back({&primitives[p], (int)m});
+        }
+    }
+
+    size_t imageCount = doc["images"].size();
+    scene.images.resize(imageCount);
+    scene.primitives.resize(primitiveTasks.size());
+    std::vector<char> imageOk(imageCount, 0), primitiveOk(primitiveTasks.size(), 0);
+
+    int taskCount = (int)(imageCount + primitiveTasks.size());
+    int threads = std::max(1, std::min(taskCount, (int)std::thread::hardware_concurrency()));
+    std::vector<double> accessorMs(threads, 0.0), imageMs(threads, 0.0);
+    std::atomic<int> nextTask(0);
+    auto worker = [&](int thread) {
+        // Images first: they are usually the largest tasks
+        for (int task = nextTask++; task < taskCount; task = nextTask++) {
+            auto taskBegin = Clock::now();
+            if (task < (int)imageCount) {
+                CPU_PROFILE_SCOPE("DecodeGltfImage");
+                imageOk[task] = decodeImage(doc, buffers, doc["images"][(size_t)task], baseDir, textureSize,
+                                            scene.images[task]);
+                imageMs[thread] += elapsedMs(taskBegin);
+            } else {
+                CPU_PROFILE_SCOPE("DecodeGltfPrimitive");
+                int p = task - (int)imageCount;
+                GltfPrimitive& primitive = scene.primitives[p];
+                primitiveOk[p] = decodePrimitive(doc, buffers, *primitiveTasks[p].json, primitive.mesh);
+                primitive.material = (*primitiveTasks[p].json)["material"].asInt();
+                accessorMs[thread] += elapsedMs(taskBegin);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i)
+        workers.emplace_back(worker, i);
+    worker(0);
+    for (std::thread& w : workers)
+        w.join();
+    s.threads = threads;
+    s.decodeMs = elapsedMs(decodeBegin);
+    for (int i = 0; i < threads; ++i) {
+        s.accessorMs += accessorMs[i];
+        s.imageMs += imageMs[i];
+    }
+
+    for (size_t p = 0; p < primitiveOk.size(); ++p) {
+        if (!primitiveOk[p]) {
+            std::cerr << "Invalid accessor data in mesh " << primitiveTasks[p].meshIndex << " of " << path << std::endl;
+            return false;
+        }
+    }
+    for (size_t i = 0; i < imageCount; ++i) {
+        if (!imageOk[i]) {
+            std::cerr << "Skipping glTF image " << i << " of " << path << " (not a PNG, or not decodable)" << std::endl;
+            scene.images[i] = GltfImage();
+        }
+    }
+
+    // --- Materials, node hierarchy, instances ---
+    auto nodesBegin = Clock::now();
+    for (size_t i = 0; i < doc["materials"].size(); ++i) {
+        GltfMaterial material = convertMaterial(doc, doc["materials"][i]);
+        if (material.image >= (int)imageCount || (material.image >= 0 && scene.images[material.image].rgb.empty()))
+            material.image = -1;
+        scene.materials.push_back(material);
+    }
+    for (GltfPrimitive& primitive : scene.primitives)
+        if (primitive.material >= (int)scene.materials.size())
+            primitive.material = -1;
+
+    const JsonValue& nodes = doc["nodes"];
+    std::vector<int> roots;
+    const JsonValue& sceneJson = doc["scenes"][(size_t)std::max(doc["scene"].asInt(0), 0)];
+    if (!sceneJson.isNull()) {
+        for (size_t i = 0; i < sceneJson["nodes"].size(); ++i)
+            roots.push_back(sceneJson["nodes"][i].asInt());
+    } else {
+        // No scene: every node that is nobody's child is a root
+        std::vector<char> isChild(nodes.size(), 0);
+        for (size_t i = 0; i < nodes.size(); ++i)
+            for (size_t c = 0; c < nodes[i]["children"].size(); ++c)
+                if (nodes[i]["children"][c].asInt() >= 0 && nodes[i]["children"][c].asInt() < (int)nodes.size())
+                    isChild[nodes[i]["children"][c].asInt()] = 1;
+        for (size_t i = 0; i < nodes.size(); ++i)
+            if (!isChild[i])
+                roots.push_back((int)i);
+    }
+
+    struct PendingNode {
+        int node;
+        float parent[16];
+    };
+    std::vector<PendingNode> stack;
+    for (int root : roots) {
+        PendingNode pending = {root, {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}};
+        stack.push_back(pending);
+    }
+    // Nodes form a tree: a node reached twice is a cycle or a shared child, visited once only
+    std::vector<char> visited(nodes.size(), 0);
+    // Primitive with the opposite winding, made on first use by a mirroring node
+    std::vector<int> mirroredPrimitives(scene.primitives.size(), -1);
+    bool firstBounds = true;
+    while (!stack.empty()) {
+        PendingNode pending = stack.back();
+        stack.pop_back();
+        const JsonValue& node = nodes[pending.node];
+        if (node.isNull() || visited[pending.node])
+            continue;
+        visited[pending.node] = 1;
+        float local[16], world[16];
+        localTransform(node, local);
+        multiply(pending.parent, local, world);
+
+        int meshIndex = node["mesh"].asInt();
+        if (meshIndex >= 0 && meshIndex < (int)meshPrimitives.size()) {
+            for (int primitive : meshPrimitives[meshIndex]) {
+                if (determinant3x3(world) < 0.0f) {
+                    // Mirroring transform: the spec flips the winding so front faces stay front faces
+                    if (mirroredPrimitives[primitive] < 0) {
+                        GltfPrimitive mirrored = scene.primitives[primitive];
+                        for (size_t i = 0; i + 2 < mirrored.mesh.indices.size(); i += 3)
+                            std::swap(mirrored.mesh.indices[i + 1], mirrored.mesh.indices[i + 2]);
+                        mirroredPrimitives[primitive] = (int)scene.primitives.size();
+                        scene.primitives.push_back(std::move(mirrored));
+                    }
+                    primitive = mirroredPrimitives[primitive];
+                }
+                GltfInstance instance;
+                instance.primitive = primitive;
+                memcpy(instance.transform, world, sizeof(world));
+                scene.instances.push_back(instance);
+                expandBounds(world, scene.primitives[primitive].mesh, scene, firstBounds);
+            }
+        }
+        for (size_t c = 0; c < node["children"].size(); ++c) {
+            PendingNode child;
+            child.node = node["children"][c].asInt();
+            memcpy(child.parent, world, sizeof(world));
+            stack.push_back(child);
+        }
+    }
+    s.nodesMs = elapsedMs(nodesBegin);
+
+    if (scene.instances.empty()) {
+        std::cerr << "No triangle meshes in " << path << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#ifndef GLTF_LOADER_H
+#define GLTF_LOADER_H
+
+#include "mesh_loader.h"
+
+#include <cstdint>
+#include <vector>
+
+// glTF 2.0 import (.gltf with external/data-URI buffers, or .glb). The result
+// is GL-free so that accessors and images can be decoded on worker threads;
+// scene.cpp uploads it.
+
+// Metallic-roughness material folded onto the Phong uniforms of fragment_shader.glsl
+struct GltfMaterial {
+    float diffuse[3] = {1.0f, 1.0f, 1.0f}; // baseColorFactor
+    float alpha = 1.0f;                    // baseColorFactor.a, < 1 only for alphaMode BLEND
+    float specular[3] = {0.04f, 0.04f, 0.04f};
+    float shininess = 32.0f;
+    int image = -1; // baseColorTexture, index into GltfScene::images
+};
+
+// Decoded RGB texture, resampled to the size requested from loadGltf()
+// (the shader multiplies it by materialDiffuse, i.e. baseColorFactor)
+struct GltfImage {
+    std::vector<uint8_t> rgb;
+    int width = 0;
+    int height = 0;
+};
+
+struct GltfPrimitive {
+    MeshData mesh;
+    int material = -1; // -1: default material
+};
+
+// One drawable: a primitive placed by its node's world transform (column major)
+struct GltfInstance {
+    int primitive = 0;
+    float transform[16];
+};
+
+struct GltfScene {
+    std::vector<GltfMaterial> materials;
+    std::vector<GltfImage> images;
+    std::vector<GltfPrimitive> primitives;
+    std::vector<GltfInstance> instances;
+    float boundsMin[3] = {0.0f, 0.0f, 0.0f}; // world space, over all instances
+    float boundsMax[3] = {0.0f, 0.0f, 0.0f};
+};
+
+struct GltfLoadStats {
+    int threads = 0;
+    double readMs = 0.0;     // mapping the file and buffers
+    double jsonMs = 0.0;     // parsing the JSON document
+    double decodeMs = 0.0;   // accessors + images, in parallel
+    double accessorMs = 0.0; // summed over workers
+    double imageMs = 0.0;    // summed over workers
+    double nodesMs = 0.0;    // node hierarchy, instances, bounds
+    size_t bytes = 0;        // JSON + buffers
+};
+
+// Loads path into scene. Images are PNG only (JPEG/WebP textures are skipped,
+// their material keeps the base color); they are resampled to textureSize x
+// textureSize. Only triangle primitives are imported. Returns false and prints
+// the reason on failure.
+bool loadGltf(const char* path, GltfScene& scene, int textureSize, GltfLoadStats* stats = nullptr);
+
+#endif // GLTF_LOADER_H
@@ -0,0 +1,112 @@
+#include "golden.h"
+#include "gl_state_cache.h"
+#include "image_diff.h"
+#include "png_io.h"
+#include "scene.h"
+#include "camera_control.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct GoldenPose {
+    const char* name;
+    float angleX;
+    float angleY;
+    float distance;
+};
+
+// Cover every object from several sides, plus a grazing view of the plane and a close-up of the sphere
+static const GoldenPose goldenPoses[] = {
+    {"default",   45.0f, 45.0f,  5.0f},
+    {"front",      0.0f, 15.0f,  7.0f},
+    {"back",     180.0f, 30.0f,  7.0f},
+    {"top",       10.0f, 85.0f,  9.0f},
+    {"grazing",  -60.0f,  5.0f, 10.0f},
+    {"close_up",  90.0f, 25.0f,  2.5f},
+};
+
+int runGolden(const HeadlessOptions& options)
+{
+    if (!initHeadlessContext())
+        return -1;
+
+    cachedSetEnabled(GL_DEPTH_TEST, true);
+    cachedSetEnabled(GL_CULL_FACE, true);
+
+    if (!initScene(options.vertexShaderPath.c_str(), options.fragmentShaderPath.c_str())) {
+        std::cerr << "Shader loading error." << std::endl;
+        shutdownHeadlessContext();
+        return -1;
+    }
+
+    OffscreenTarget target;
+    if (!createOffscreenTarget(target, options.width, options.height)) {
+        shutdownScene();
+        shutdownHeadlessContext();
+        return -1;
+    }
+
+    int failures = 0;
+    std::vector<unsigned char> actual, reference;
+    long long pixelCount = (long long)target.width * target.height;
+
+    for (const GoldenPose& pose : goldenPoses) {
+        cameraAngleX = pose.angleX;
+        cameraAngleY = pose.angleY;
+        cameraDistance = pose.distance;
+
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        drawScene();
+        readOffscreenTarget(target, actual);
+
+        std::string base = options.goldenDir + "/" + pose.name;
+        std::string referencePath = base + ".png";
+
+        if (options.goldenUpdate) {
+            if (!writePNG(referencePath.c_str(), actual.data(), target.width, target.height))
+                failures++;
+            else
+                std::cout << "[golden] updated " << referencePath << std::endl;
+            continue;
+        }
+
+        int refWidth = 0, refHeight = 0;
+        if (!readPNG(referencePath.c_str(), reference, refWidth, refHeight)) {
+            std::cerr << "[golden] " << pose.name << ": missing reference " << referencePath
+                      << " (run with --golden-update)" << std::endl;
+            failures++;
+            continue;
+        }
+        if (refWidth != target.width || refHeight != target.height) {
+            std::cerr << "[golden] " << pose.name << ": reference is " << refWidth << "x" << refHeight
+                      << ", rendered " << target.width << "x" << target.height << std::endl;
+            failures++;
+            continue;
+        }
+
+        ImageDiffResult diff = compareImages(actual.data(), reference.data(), target.width, target.height,
+                                             options.goldenPixelThreshold);
+        double differingRatio = (double)diff.differingPixels / pixelCount;
+        bool pass = diff.ssim >= options.goldenMinSSIM && differingRatio <= options.goldenMaxDifferingRatio;
+
+        std::cout << "[golden] " << pose.name << ": " << (pass ? "ok" : "FAILED")
+                  << " ssim=" << diff.ssim
+                  << " differing=" << diff.differingPixels << " (" << differingRatio * 100.0 << "%)"
+                  << " max=" << diff.maxChannelDiff
+                  << " mean=" << diff.meanAbsDiff << std::endl;
+
+        if (!pass) {
+            failures++;
+            std::vector<unsigned char> diffImage;
+            buildDiffImage(actual.data(), reference.data(), target.width, target.height, diffImage);
+            writePNG((base + "_actual.png").c_str(), actual.data(), target.width, target.height);
+            writePNG((base + "_diff.png").c_str(), diffImage.data(), target.width, target.height);
+        }
+    }
+
+    destroyOffscreenTarget(target);
+    shutdownScene();
+    shutdownHeadlessContext();
+    return failures == 0 ? 0 : 1;
+}
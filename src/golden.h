@@ -0,0 +1,15 @@
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+#include "headless.h"
+
+// Golden-image regression check: renders drawScene() offscreen for a fixed
+// set of camera poses and compares each frame with <goldenDir>/<pose>.png
+// (SSIM plus a per-pixel tolerance). Mismatches leave <pose>_actual.png and
+// <pose>_diff.png next to the reference. With goldenUpdate the references
+// are rewritten instead.
+//
+// Returns the process exit code: 0 when every pose matches.
+int runGolden(const HeadlessOptions& options);
+
+#endif // GOLDEN_H
@@ -0,0 +1,144 @@
+#include "gpu_profiler.h"
+
+#include <GL/glew.h>
+
+struct GpuScopeRecord {
+    const char* name;
+    int depth;
+    int beginQuery; // indices into GpuFrame::queries
+    int endQuery;
+};
+
+struct GpuFrame {
+    std::vector<GLuint> queries; // pool, grows to the largest frame seen
+    int usedQueries = 0;
+    std::vector<GpuScopeRecord> scopes;
+    bool pending = false;        // recorded, results not read back yet
+};
+
+// Enough frames in flight that results are normally ready by the time a slot is reused
+static const int gpuFrameRingSize = 4;
+static GpuFrame frames[gpuFrameRingSize];
+static int currentFrame = 0;
+static bool frameOpen = false;
+static std::vector<int> scopeStack;
+
+static std::vector<GpuTimingNode> results;
+static int droppedFrames = 0;
+
+static int issueTimestamp(GpuFrame& frame)
+{
+    if (frame.usedQueries == (int)frame.queries.size()) {
+        GLuint query = 0;
+        glGenQueries(1, &query);
+        frame.queries.push_back(query);
+    }
+    int index = frame.usedQueries++;
+    glQueryCounter(frame.queries[index], GL_TIMESTAMP);
+    return index;
+}
+
+// Reads the frame back if its last query is done; returns false if still in flight
+static bool resolveFrame(GpuFrame& frame)
+{
+    if (frame.usedQueries == 0) {
+        frame.pending = false;
+        return true;
+    }
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[frame.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return false;
+
+    results.clear();
+    for (const GpuScopeRecord& scope : frame.scopes) {
+        if (scope.endQuery < 0)
+            continue;
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(frame.queries[scope.beginQuery], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(frame.queries[scope.endQuery], GL_QUERY_RESULT, &end);
+        results.push_back({scope.name, scope.depth, (end - begin) / 1.0e6});
+    }
+    frame.pending = false;
+    return true;
+}
+
+void initGpuProfiler()
+{
+    currentFrame = 0;
+    frameOpen = false;
+    droppedFrames = 0;
+    results.clear();
+}
+
+void shutdownGpuProfiler()
+{
+    for (GpuFrame& frame : frames) {
+        if (!frame.queries.empty())
+            glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data());
+        frame = GpuFrame();
+    }
+    results.clear();
+}
+
+void gpuProfilerBeginFrame()
+{
+    // Oldest first, stop at the first frame the GPU hasn't finished
+    for (int i = 1; i <= gpuFrameRingSize; ++i) {
+        GpuFrame& frame = frames[(currentFrame + i) % gpuFrameRingSize];
+        if (frame.pending && !resolveFrame(frame))
+            break;
+    }
+
+    GpuFrame& frame = frames[currentFrame];
+    if (frame.pending) {
+        // Still in flight after a full ring: reuse it rather than stall
+        droppedFrames++;
+        frame.pending = false;
+    }
+    frame.usedQueries = 0;
+    frame.scopes.clear();
+    scopeStack.clear();
+    frameOpen = true;
+}
+
+void gpuProfilerEndFrame()
+{
+    if (!frameOpen)
+        return;
+    while (!scopeStack.empty())
+        gpuProfilerEndScope();
+
+    frames[currentFrame].pending = true;
+    currentFrame = (currentFrame + 1) % gpuFrameRingSize;
+    frameOpen = false;
+}
+
+void gpuProfilerBeginScope(const char* name)
+{
+    if (!frameOpen)
+        return;
+    GpuFrame& frame = frames[currentFrame];
+    GpuScopeRecord scope = {name, (int)scopeStack.size(), issueTimestamp(frame), -1};
+    scopeStack.push_back((int)frame.scopes.size());
+    frame.scopes.push_back(scope);
+}
+
+void gpuProfilerEndScope()
+{
+    if (!frameOpen || scopeStack.empty())
+        return;
+    GpuFrame& frame = frames[currentFrame];
+    frame.scopes[scopeStack.back()].endQuery = issueTimestamp(frame);
+    scopeStack.pop_back();
+}
+
+const std::vector<GpuTimingNode>& getGpuProfilerResults()
+{
+    return results;
+}
+
+int getGpuProfilerDroppedFrames()
+{
+    return droppedFrames;
+}
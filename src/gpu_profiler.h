@@ -0,0 +1,41 @@
+#ifndef GPU_PROFILER_H
+#define GPU_PROFILER_H
+
+#include <vector>
+
+// One timed scope of a resolved frame, in the order the scopes were opened
+struct GpuTimingNode {
+    const char* name; // must outlive the profiler (string literals)
+    int depth;        // nesting level, 0 = top-level pass
+    double ms;
+};
+
+void initGpuProfiler();
+void shutdownGpuProfiler();
+
+// Bracket a whole frame. Results come back a few frames later through a
+// ring of per-frame GL_TIMESTAMP query sets, so nothing waits on the GPU.
+void gpuProfilerBeginFrame();
+void gpuProfilerEndFrame();
+
+// Scopes nest; every begin needs a matching end within the same frame
+void gpuProfilerBeginScope(const char* name);
+void gpuProfilerEndScope();
+
+// Most recent frame whose queries have all completed
+const std::vector<GpuTimingNode>& getGpuProfilerResults();
+// Frames whose results were overwritten before the GPU finished them
+int getGpuProfilerDroppedFrames();
+
+struct GpuProfileScope {
+    explicit GpuProfileScope(const char* name) { gpuProfilerBeginScope(name); }
+    ~GpuProfileScope() { gpuProfilerEndScope(); }
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+};
+
+#define GPU_PROFILE_CONCAT_(a, b) a##b
+#define GPU_PROFILE_CONCAT(a, b) GPU_PROFILE_CONCAT_(a, b)
+#define GPU_PROFILE_SCOPE(name) GpuProfileScope GPU_PROFILE_CONCAT(gpuProfileScope, __LINE__)(name)
+
+#endif // GPU_PROFILER_H
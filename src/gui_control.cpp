@@ -1,21 +1,115 @@
 #include "gui_control.h"
 #include "camera_control.h"
+#include "cpu_profiler.h"
+#include "frame_capture.h"
+#include "frame_scheduler.h"
+#include "frame_timing.h"
+#include "gl_state_cache.h"
+#include "gpu_profiler.h"
+#include "scene.h"
+#include "stream_buffer.h"
 #include "imgui/imgui.h"
 #include "imgui/backends/imgui_impl_glut.h"
 #include "imgui/backends/imgui_impl_opengl3.h"
-#include <chrono>
+#include <cstdio>
 
 
-static int fps = 0;
-static int frameCount = 0;
-static std::chrono::time_point<std::chrono::steady_clock> lastTime;
+// Hand the renderer our cached GL state instead of letting it query everything each frame
+static bool declareGuiState = true;
+
+static ImGui_ImplOpenGL3_KnownState knownGuiState()
+{
+    const GLStateCache& cache = getGLStateCache();
+    ImGui_ImplOpenGL3_KnownState state;
+    state.Program = cache.program;
+    state.VertexArray = cache.vertexArray;
+    state.ArrayBuffer = cache.arrayBuffer;
+    state.ActiveTexture = cache.activeTexture;
+    state.Texture2D = cache.texture2D;
+    state.Sampler = cache.sampler;
+    for (int i = 0; i < 4; ++i) {
+        state.Viewport[i] = cache.viewport[i];
+        state.ScissorBox[i] = cache.scissorBox[i];
+    }
+    state.BlendSrcRgb = cache.blendSrcRgb;
+    state.BlendDstRgb = cache.blendDstRgb;
+    state.BlendSrcAlpha = cache.blendSrcAlpha;
+    state.BlendDstAlpha = cache.blendDstAlpha;
+    state.BlendEquationRgb = cache.blendEquationRgb;
+    state.BlendEquationAlpha = cache.blendEquationAlpha;
+    state.PolygonMode[0] = cache.polygonMode[0];
+    state.PolygonMode[1] = cache.polygonMode[1];
+    state.Blend = cache.blend;
+    state.CullFace = cache.cullFace;
+    state.DepthTest = cache.depthTest;
+    state.StencilTest = cache.stencilTest;
+    state.ScissorTest = cache.scissorTest;
+    state.PrimitiveRestart = cache.primitiveRestart;
+    state.ClipOriginUpperLeft = false;
+    return state;
+}
+
+static void frameTimingRow(const char* name, FrameTimingSeries series)
+{
+    FrameTimingStats stats = computeFrameTimingStats(series);
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn(); ImGui::TextUnformatted(name);
+    ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.mean);
+    ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.p50);
+    ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.p95);
+    ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.p99);
+    ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.max);
+}
+
+static void frameTimingPlot(const char* label, FrameTimingSeries series)
+{
+    int offset = 0, count = 0;
+    const float* values = getFrameTimingHistory(series, &offset, &count);
+    FrameTimingStats stats = computeFrameTimingStats(series);
+    char overlay[32];
+    snprintf(overlay, sizeof(overlay), "%s %.2f ms", label, stats.mean);
+    // Scale to the worst recent frame so spikes stay visible
+    ImGui::PlotLines(label, values, count, offset, overlay,
+                     0.0f, stats.max > 0.0f ? stats.max * 1.1f : 1.0f, ImVec2(0, 50));
+}
+
+// Hierarchical view of the last resolved GPU frame, children indented under their pass
+static void gpuProfilerView()
+{
+    const std::vector<GpuTimingNode>& nodes = getGpuProfilerResults();
+    if (!ImGui::BeginTable("GpuPasses", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+        return;
+    ImGui::TableSetupColumn("GPU pass");
+    ImGui::TableSetupColumn("ms", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableHeadersRow();
+    for (const GpuTimingNode& node : nodes) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        // Indent(0) would fall back to the default spacing, so only indent nested scopes
+        float indent = node.depth * ImGui::GetStyle().IndentSpacing;
+        if (indent > 0.0f)
+            ImGui::Indent(indent);
+        ImGui::TextUnformatted(node.name);
+        if (indent > 0.0f)
+            ImGui::Unindent(indent);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", node.ms);
+    }
+    ImGui::EndTable();
+    int dropped = getGpuProfilerDroppedFrames();
+    if (dropped > 0)
+        ImGui::TextDisabled("%d frames dropped (GPU too far behind)", dropped);
+}
 
 void initGUI()
 {
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
+    // Next to imgui.ini: later launches map the built atlas instead of rasterizing it again
+    ImGui::GetIO().Fonts->BuildCacheFilename = "imgui_fonts.cache";
     ImGui_ImplGLUT_Init();
     ImGui_ImplOpenGL3_Init("#version 330");  // Укажите версию GLSL
+    ImGui_ImplOpenGL3_SetStreamingMode(true);
 }
 
 void shutdownGUI()
@@ -28,21 +122,19 @@ void shutdownGUI()
 
 void renderGUI()
 {
+    CPU_PROFILE_FUNCTION();
     
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGLUT_NewFrame();
     ImGui::NewFrame();  
 
     
-    ImGui::SetNextWindowSize(ImVec2(300, 200)); 
+    ImGui::SetNextWindowSize(ImVec2(340, 800)); 
     ImGui::SetNextWindowPos(ImVec2(10, 10));    
 
     
     ImGui::Begin("Light Parameters");
 
-    extern float lightPosition[4];
-    extern float lightIntensity;
-    extern float lightBaseColor[3];
     glm::vec3 CameraPosition = getCameraPosition();
 
     ImGui::Text("Light Position");
@@ -54,32 +146,124 @@ void renderGUI()
     ImGui::Text("Light Color");
     ImGui::ColorEdit3("Base Color", lightBaseColor);
     
+    ImGui::SliderFloat("LOD error (px)", &lodErrorPixels, 0.0f, 8.0f, "%.1f");
+    ImGui::Checkbox("Meshlet culling", &meshletCulling);
+    ImGui::Text("Draws: %d, triangles: %lld", renderStats.drawCalls, renderStats.triangles);
+    if (renderStats.meshlets > 0)
+        ImGui::Text("Meshlets: %d, culled %d frustum + %d backface", renderStats.meshlets,
+                    renderStats.meshletsFrustumCulled, renderStats.meshletsBackfaceCulled);
+    StreamBufferStats stream = getStreamBufferStats();
+    ImGui::Text("Stream buffer (%s): %zu / %zu KB, stalls %lld (%.1f ms), overflows %lld",
+                stream.persistent ? "persistent" : "unsynchronized", stream.frameBytes / 1024,
+                stream.frameCapacity / 1024, stream.stalls, stream.stallMs, stream.overflows);
+
     ImGui::Separator();
     ImGui::Text("Camera Position:\n %.2fx %.2fy %.2fz",CameraPosition.x,CameraPosition.y,CameraPosition.z);
 
 
     ImGui::Separator();
-    ImGui::Text("FPS: %d", fps);
+    FrameTimingStats frameStats = computeFrameTimingStats(FrameTiming_Frame);
+    ImGui::Text("FPS: %.1f", frameStats.mean > 0.0f ? 1000.0f / frameStats.mean : 0.0f);
+    if (ImGui::BeginTable("FrameTimes", 6, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchSame)) {
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableSetupColumn("mean");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p95");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("max");
+        ImGui::TableHeadersRow();
+        frameTimingRow("Frame", FrameTiming_Frame);
+        frameTimingRow("CPU", FrameTiming_CPU);
+        frameTimingRow("GPU", FrameTiming_GPU);
+        ImGui::EndTable();
+    }
+    frameTimingPlot("CPU", FrameTiming_CPU);
+    frameTimingPlot("GPU", FrameTiming_GPU);
+    if (ImGui::CollapsingHeader("Session")) {
+        // The whole run (up to the log cap): one min..max span per pixel, so single hitches stay visible
+        static ImGuiPlotPyramid sessionPyramid;
+        static int sessionGeneration = -1;
+        int count = 0, generation = 0;
+        const float* log = getFrameTimingLog(&count, &generation);
+        if (generation != sessionGeneration) {
+            sessionPyramid.Clear();
+            sessionGeneration = generation;
+        }
+        char overlay[32];
+        snprintf(overlay, sizeof(overlay), "%d frames", count);
+        ImGui::PlotLinesMinMax("Frame", log, count, &sessionPyramid, 0, -1, overlay, 0.0f, FLT_MAX, ImVec2(0, 80));
+    }
+
+    if (ImGui::CollapsingHeader("GPU Profiler", ImGuiTreeNodeFlags_DefaultOpen))
+        gpuProfilerView();
+
+    bool recordCpuTrace = cpuProfilerIsEnabled();
+    if (ImGui::Checkbox("Record CPU trace", &recordCpuTrace))
+        cpuProfilerSetEnabled(recordCpuTrace);
+    ImGui::SameLine();
+    if (ImGui::Button("Save"))
+        cpuProfilerExportChromeTrace("cpu_trace.json");
+    ImGui::SameLine();
+    if (ImGui::Button("Clear"))
+        cpuProfilerClear();
+
+    ImGui::Separator();
+    ImGui::Text("Frame Pacing");
+    FrameSchedulerSettings& pacing = getFrameSchedulerSettings();
+    bool vsync = pacing.vsync;
+    if (ImGui::Checkbox("VSync", &vsync))
+        setVSync(vsync);
+    bool onDemand = pacing.renderMode == RenderMode::OnDemand;
+    if (ImGui::Checkbox("Render on demand", &onDemand))
+        pacing.renderMode = onDemand ? RenderMode::OnDemand : RenderMode::Continuous;
+    float targetFps = (float)pacing.targetFps;
+    if (ImGui::SliderFloat("FPS cap", &targetFps, 0.0f, 240.0f, targetFps > 0.0f ? "%.0f" : "off"))
+        pacing.targetFps = targetFps;
+    bool streamingGui = ImGui_ImplOpenGL3_GetStreamingMode();
+    if (ImGui::Checkbox("Streaming GUI renderer", &streamingGui))
+        ImGui_ImplOpenGL3_SetStreamingMode(streamingGui);
+    ImGui::Checkbox("GUI skips GL state queries", &declareGuiState);
+
+    const FrameHistogram& histogram = getFrameHistogram();
+    ImGui::PlotHistogram("##FrameTimes", histogram.buckets, frameHistogramBuckets, 0, nullptr,
+                         0.0f, FLT_MAX, ImVec2(0, 60));
+    ImGui::Text("Frame time: %.2f..%.2f ms (%.1f ms/bar)", histogram.minMs, histogram.maxMs, frameHistogramBucketMs);
+    if (ImGui::Button("Reset histogram"))
+        resetFrameHistogram();
+
+    ImGui::Separator();
+    ImGui::Text("Capture");
+    if (!isFrameCaptureActive()) {
+        int fps = pacing.targetFps > 0.0 ? (int)pacing.targetFps : 60;
+        int width = (int)ImGui::GetIO().DisplaySize.x;
+        int height = (int)ImGui::GetIO().DisplaySize.y;
+        if (ImGui::Button("Record Y4M"))
+            startFrameCapture("capture.y4m", CaptureFormat::Y4M, width, height, fps);
+#ifdef SCENE_PNG
+        ImGui::SameLine();
+        if (ImGui::Button("Record PNG"))
+            startFrameCapture("capture_%05d.png", CaptureFormat::PNGSequence, width, height, fps);
+#endif
+    } else {
+        if (ImGui::Button("Stop recording"))
+            stopFrameCapture();
+        FrameCaptureStats capture = getFrameCaptureStats();
+        ImGui::Text("Frames: %lld captured, %lld written, %d queued", capture.captured, capture.encoded,
+                    capture.queuedFrames);
+        ImGui::Text("Dropped: %lld GPU, %lld encoder", capture.droppedGpu, capture.droppedEncoder);
+    }
 
     ImGui::End();
 
     
     ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-
-    updateFPS();
-}
-
-void updateFPS()
-{
-    frameCount++;
-    auto currentTime = std::chrono::steady_clock::now();
-    float deltaTime = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - lastTime).count();
-
-    if (deltaTime >= 16.0f)
-    {
-        fps = frameCount;
-        frameCount = 0;
-        lastTime = currentTime;
+    GPU_PROFILE_SCOPE("ImGui");
+    CPU_PROFILE_SCOPE("ImGui_ImplOpenGL3_RenderDrawData");
+    if (declareGuiState && isGLStateCacheSynced()) {
+        ImGui_ImplOpenGL3_KnownState state = knownGuiState();
+        ImGui_ImplOpenGL3_SetKnownState(&state);
+    } else {
+        ImGui_ImplOpenGL3_SetKnownState(nullptr);
     }
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
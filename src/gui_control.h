@@ -7,6 +7,5 @@
 void initGUI();
 void renderGUI();
 void shutdownGUI();
-void updateFPS();
 
 #endif // GUI_CONTROL_H
@@ -0,0 +1,355 @@
+#include "headless.h"
+#include "camera_control.h"
+#include "frame_capture.h"
+#include "gl_state_cache.h"
+#ifdef HEADLESS_GOLDEN
+#include "golden.h"
+#endif
+#include "frame_timing.h"
+#include "json.h"
+#include "scene.h"
+#include "stream_buffer.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+static EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+static EGLContext eglContext = EGL_NO_CONTEXT;
+
+bool parseHeadlessArgs(int argc, char** argv, HeadlessOptions& options)
+{
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (strcmp(argv[i], "--frames") == 0 && hasValue) {
+            options.frames = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--size") == 0 && hasValue) {
+            int w = 0, h = 0;
+            if (sscanf(argv[++i], "%dx%d", &w, &h) == 2 && w > 0 && h > 0) {
+                options.width = w;
+                options.height = h;
+            }
+        } else if (strcmp(argv[i], "--report") == 0 && hasValue) {
+            options.reportPath = argv[++i];
+        } else if (strcmp(argv[i], "--model") == 0 && hasValue) {
+            options.modelPath = argv[++i];
+        } else if (strcmp(argv[i], "--capture") == 0 && hasValue) {
+            options.capturePath = argv[++i];
+        } else if (strcmp(argv[i], "--golden") == 0 && hasValue) {
+            headless = true;
+            options.goldenDir = argv[++i];
+        } else if (strcmp(argv[i], "--golden-update") == 0) {
+            options.goldenUpdate = true;
+        } else if (strcmp(argv[i], "--shaders") == 0 && hasValue) {
+            std::string dir = argv[++i];
+            options.vertexShaderPath = dir + "/vertex_shader.glsl";
+            options.fragmentShaderPath = dir + "/fragment_shader.glsl";
+        }
+    }
+    return headless;
+}
+
+bool initHeadlessContext()
+{
+    // Prefer the surfaceless platform: no X server or GPU device needed
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay != nullptr)
+        eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (eglDisplay == EGL_NO_DISPLAY)
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major = 0, minor = 0;
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor)) {
+        std::cerr << "Failed to initialize EGL" << std::endl;
+        return false;
+    }
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "EGL implementation has no desktop OpenGL support" << std::endl;
+        return false;
+    }
+
+    const EGLint configAttribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config = EGL_NO_CONFIG_KHR;
+    EGLint configCount = 0;
+    eglChooseConfig(eglDisplay, configAttribs, &config, 1, &configCount);
+
+    // Same kind of context the GLUT window gets: 3.3 compatibility profile
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+        EGL_NONE
+    };
+    eglContext = eglCreateContext(eglDisplay, configCount > 0 ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttribs);
+    if (eglContext == EGL_NO_CONTEXT) {
+        std::cerr << "Failed to create an OpenGL 3.3 EGL context" << std::endl;
+        return false;
+    }
+    // Surfaceless: everything is rendered into FBOs
+    if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+        std::cerr << "Failed to make the EGL context current (EGL_KHR_surfaceless_context missing?)" << std::endl;
+        return false;
+    }
+
+    GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // GLEW built for GLX loads the GL entry points fine, it only fails on the missing GLX display
+    if (err == GLEW_ERROR_NO_GLX_DISPLAY)
+        err = GLEW_OK;
+#endif
+    if (GLEW_OK != err) {
+        std::cerr << "Failed to initialize GLEW: " << glewGetErrorString(err) << std::endl;
+        return false;
+    }
+
+    std::cout << "EGL Version: " << major << "." << minor << std::endl;
+    std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
+    return true;
+}
+
+void shutdownHeadlessContext()
+{
+    if (eglDisplay != EGL_NO_DISPLAY) {
+        eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (eglContext != EGL_NO_CONTEXT)
+            eglDestroyContext(eglDisplay, eglContext);
+        eglTerminate(eglDisplay);
+    }
+    eglContext = EGL_NO_CONTEXT;
+    eglDisplay = EGL_NO_DISPLAY;
+}
+
+bool createOffscreenTarget(OffscreenTarget& target, int width, int height)
+{
+    target.width = width;
+    target.height = height;
+
+    glGenFramebuffers(1, &target.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+
+    glGenRenderbuffers(1, &target.colorRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, target.colorRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, target.colorRenderbuffer);
+
+    glGenRenderbuffers(1, &target.depthRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, target.depthRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, target.depthRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Offscreen framebuffer is incomplete" << std::endl;
+        destroyOffscreenTarget(target);
+        return false;
+    }
+
+    cachedViewport(0, 0, width, height);
+    viewportWidth = width;
+    viewportHeight = height;
+    return true;
+}
+
+void destroyOffscreenTarget(OffscreenTarget& target)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (target.fbo != 0)
+        glDeleteFramebuffers(1, &target.fbo);
+    if (target.colorRenderbuffer != 0)
+        glDeleteRenderbuffers(1, &target.colorRenderbuffer);
+    if (target.depthRenderbuffer != 0)
+        glDeleteRenderbuffers(1, &target.depthRenderbuffer);
+    target = OffscreenTarget();
+}
+
+void readOffscreenTarget(const OffscreenTarget& target, std::vector<unsigned char>& rgba)
+{
+    size_t rowBytes = (size_t)target.width * 4;
+    rgba.resize(rowBytes * target.height);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, target.width, target.height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+
+    // GL rows start at the bottom
+    std::vector<unsigned char> row(rowBytes);
+    for (int y = 0; y < target.height / 2; ++y) {
+        unsigned char* top = &rgba[y * rowBytes];
+        unsigned char* bottom = &rgba[(target.height - 1 - y) * rowBytes];
+        std::copy(top, top + rowBytes, row.data());
+        std::copy(bottom, bottom + rowBytes, top);
+        std::copy(row.data(), row.data() + rowBytes, bottom);
+    }
+}
+
+void setScriptedCamera(float t)
+{
+    // One full orbit, bobbing up and down and zooming in and out twice
+    const float twoPi = 6.28318530718f;
+    cameraAngleX = 360.0f * t;
+    cameraAngleY = 25.0f + 15.0f * sinf(twoPi * t);
+    cameraDistance = 6.0f + 2.0f * sinf(2.0f * twoPi * t);
+}
+
+static void writeStats(std::ofstream& out, const char* name, const FrameTimingStats& stats)
+{
+    out << "  \"" << name << "\": {\"mean\": " << stats.mean << ", \"p50\": " << stats.p50
+        << ", \"p95\": " << stats.p95 << ", \"p99\": " << stats.p99 << ", \"max\": " << stats.max << "},\n";
+}
+
+template <typename T>
+static double meanOf(const std::vector<T>& values)
+{
+    double sum = 0.0;
+    for (T value : values)
+        sum += (double)value;
+    return values.empty() ? 0.0 : sum / values.size();
+}
+
+int runHeadless(const HeadlessOptions& options)
+{
+#ifdef HEADLESS_GOLDEN
+    if (!options.goldenDir.empty())
+        return runGolden(options);
+#endif
+
+    if (!initHeadlessContext())
+        return -1;
+
+    cachedSetEnabled(GL_DEPTH_TEST, true);
+    cachedSetEnabled(GL_CULL_FACE, true);
+
+    if (!initScene(options.vertexShaderPath.c_str(), options.fragmentShaderPath.c_str())) {
+        std::cerr << "Shader loading error." << std::endl;
+        shutdownHeadlessContext();
+        return -1;
+    }
+
+    if (!options.modelPath.empty() && !loadSceneModel(options.modelPath.c_str())) {
+        shutdownScene();
+        shutdownHeadlessContext();
+        return -1;
+    }
+
+    OffscreenTarget target;
+    if (!createOffscreenTarget(target, options.width, options.height)) {
+        shutdownScene();
+        shutdownHeadlessContext();
+        return -1;
+    }
+
+    GLuint gpuQuery = 0;
+    glGenQueries(1, &gpuQuery);
+
+    if (!options.capturePath.empty()) {
+        std::string path = options.capturePath;
+        bool png = path.size() > 4 && path.compare(path.size() - 4, 4, ".png") == 0;
+        // A sequence needs a frame number in the name
+        if (png && path.find('%') == std::string::npos)
+            path.insert(path.size() - 4, "_%05d");
+        startFrameCapture(path.c_str(), png ? CaptureFormat::PNGSequence : CaptureFormat::Y4M,
+                          options.width, options.height, 60);
+    }
+
+    std::vector<float> frameMs, cpuMs, gpuMs;
+    // Scene counters vary with LOD and culling, so the report gives their means
+    std::vector<int> drawCalls, meshlets, meshletsFrustumCulled, meshletsBackfaceCulled;
+    std::vector<long long> triangles;
+
+    int totalFrames = options.warmupFrames + options.frames;
+    for (int frame = 0; frame < totalFrames; ++frame) {
+        setScriptedCamera((float)frame / totalFrames);
+
+        auto begin = std::chrono::steady_clock::now();
+        glBeginQuery(GL_TIME_ELAPSED, gpuQuery);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        drawScene();
+        glEndQuery(GL_TIME_ELAPSED);
+        auto submitted = std::chrono::steady_clock::now();
+        // No swap to pace us: wait for the GPU so each sample is a complete frame
+        glFinish();
+        auto finished = std::chrono::steady_clock::now();
+
+        if (frame < options.warmupFrames)
+            continue;
+
+        // Outside the timed span: the readback would otherwise show up in frame_ms
+        captureFrame();
+
+        GLuint64 gpuNs = 0;
+        glGetQueryObjectui64v(gpuQuery, GL_QUERY_RESULT, &gpuNs);
+        frameMs.push_back(std::chrono::duration<float, std::milli>(finished - begin).count());
+        cpuMs.push_back(std::chrono::duration<float, std::milli>(submitted - begin).count());
+        gpuMs.push_back((float)(gpuNs / 1.0e6));
+        drawCalls.push_back(renderStats.drawCalls);
+        triangles.push_back(renderStats.triangles);
+        meshlets.push_back(renderStats.meshlets);
+        meshletsFrustumCulled.push_back(renderStats.meshletsFrustumCulled);
+        meshletsBackfaceCulled.push_back(renderStats.meshletsBackfaceCulled);
+    }
+
+    glDeleteQueries(1, &gpuQuery);
+    stopFrameCapture();
+
+    std::ofstream out(options.reportPath, std::ios::out | std::ios::trunc);
+    bool written = out.is_open();
+    if (written) {
+        out << "{\n";
+        out << "  \"renderer\": ";
+        writeJsonString(out, (const char*)glGetString(GL_RENDERER));
+        out << ",\n  \"vendor\": ";
+        writeJsonString(out, (const char*)glGetString(GL_VENDOR));
+        out << ",\n  \"gl_version\": ";
+        writeJsonString(out, (const char*)glGetString(GL_VERSION));
+        out << ",\n";
+        out << "  \"width\": " << options.width << ",\n";
+        out << "  \"height\": " << options.height << ",\n";
+        out << "  \"frames\": " << options.frames << ",\n";
+        out << "  \"draw_calls_per_frame\": " << meanOf(drawCalls) << ",\n";
+        out << "  \"triangles_per_frame\": " << meanOf(triangles) << ",\n";
+        out << "  \"meshlets_per_frame\": " << meanOf(meshlets) << ",\n";
+        out << "  \"meshlets_frustum_culled_per_frame\": " << meanOf(meshletsFrustumCulled) << ",\n";
+        out << "  \"meshlets_backface_culled_per_frame\": " << meanOf(meshletsBackfaceCulled) << ",\n";
+        StreamBufferStats stream = getStreamBufferStats();
+        out << "  \"stream_buffer\": {\"persistent\": " << (stream.persistent ? "true" : "false")
+            << ", \"frame_capacity\": " << stream.frameCapacity << ", \"allocations\": " << stream.allocations
+            << ", \"overflows\": " << stream.overflows << ", \"stalls\": " << stream.stalls
+            << ", \"stall_ms\": " << stream.stallMs << "},\n";
+        writeStats(out, "frame_ms", computeTimingStats(frameMs.data(), (int)frameMs.size()));
+        writeStats(out, "cpu_ms", computeTimingStats(cpuMs.data(), (int)cpuMs.size()));
+        writeStats(out, "gpu_ms", computeTimingStats(gpuMs.data(), (int)gpuMs.size()));
+        out << "  \"per_frame\": [\n";
+        for (size_t i = 0; i < frameMs.size(); ++i) {
+            out << "    {\"frame_ms\": " << frameMs[i] << ", \"cpu_ms\": " << cpuMs[i] << ", \"gpu_ms\": " << gpuMs[i]
+                << ", \"draw_calls\": " << drawCalls[i] << ", \"triangles\": " << triangles[i]
+                << ", \"meshlets\": " << meshlets[i] << "}"
+                << (i + 1 < frameMs.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+        written = out.good();
+    }
+    if (!written)
+        std::cerr << "Unable to write headless report: " << options.reportPath << std::endl;
+    else
+        std::cout << "Headless report written to " << options.reportPath << std::endl;
+
+    destroyOffscreenTarget(target);
+    shutdownScene();
+    shutdownHeadlessContext();
+    return written ? 0 : -1;
+}
@@ -0,0 +1,60 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+
+// Offscreen rendering without a window: an EGL context (surfaceless Mesa
+// platform, e.g. llvmpipe) rendering drawScene() into an FBO.
+
+struct HeadlessOptions {
+    int frames = 300;
+    int warmupFrames = 10; // rendered but left out of the report
+    int width = 1280;
+    int height = 720;
+    std::string reportPath = "headless_report.json";
+    std::string vertexShaderPath = "../shaders/vertex_shader.glsl";
+    std::string fragmentShaderPath = "../shaders/fragment_shader.glsl";
+    std::string modelPath;   // optional OBJ/PLY model added to the scene
+    std::string capturePath; // record the measured frames: *.y4m, or *.png for a numbered sequence
+
+    // Golden-image mode: compare fixed camera poses against reference PNGs in goldenDir
+    std::string goldenDir;
+    bool goldenUpdate = false;         // (re)write the references instead of comparing
+    float goldenMinSSIM = 0.995f;
+    int goldenPixelThreshold = 8;      // per-channel difference still counted as equal
+    float goldenMaxDifferingRatio = 0.001f; // tolerated fraction of pixels over the threshold
+};
+
+// Returns true if argv asks for headless mode (--headless, or --golden dir
+// [--golden-update]); fills options from --frames N, --size WxH,
+// --report path, --model path, --capture path, --shaders dir.
+bool parseHeadlessArgs(int argc, char** argv, HeadlessOptions& options);
+
+// Creates and makes current an offscreen GL context and loads GL functions
+bool initHeadlessContext();
+void shutdownHeadlessContext();
+
+struct OffscreenTarget {
+    GLuint fbo = 0;
+    GLuint colorRenderbuffer = 0;
+    GLuint depthRenderbuffer = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// Creates an RGBA8 + depth FBO, binds it and sets the viewport
+bool createOffscreenTarget(OffscreenTarget& target, int width, int height);
+void destroyOffscreenTarget(OffscreenTarget& target);
+
+// Synchronous glReadPixels of the target into top-to-bottom RGBA rows
+void readOffscreenTarget(const OffscreenTarget& target, std::vector<unsigned char>& rgba);
+
+// Puts the orbit camera on the scripted benchmark path, t in [0, 1)
+void setScriptedCamera(float t);
+
+// Renders options.frames frames and writes the JSON report; returns the process exit code
+int runHeadless(const HeadlessOptions& options);
+
+#endif // HEADLESS_H
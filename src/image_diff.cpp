@@ -0,0 +1,178 @@
+#include "image_diff.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMAGE_DIFF_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define IMAGE_DIFF_NEON 1
+#endif
+
+struct PixelDiffAccum {
+    unsigned long long sumAbs = 0;
+    int maxDiff = 0;
+    long long differing = 0;
+};
+
+static void diffPixelsScalar(const uint8_t* a, const uint8_t* b, size_t pixels, int threshold, PixelDiffAccum& acc)
+{
+    for (size_t p = 0; p < pixels; ++p) {
+        bool differs = false;
+        for (int c = 0; c < 4; ++c) {
+            int d = std::abs((int)a[p * 4 + c] - (int)b[p * 4 + c]);
+            acc.sumAbs += d;
+            acc.maxDiff = std::max(acc.maxDiff, d);
+            differs = differs || d > threshold;
+        }
+        acc.differing += differs ? 1 : 0;
+    }
+}
+
+#if defined(IMAGE_DIFF_SSE2)
+static const int bitCount4[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+#endif
+
+// 4 RGBA pixels (16 bytes) per iteration; returns how many pixels were handled
+static size_t diffPixelsSIMD(const uint8_t* a, const uint8_t* b, size_t pixels, int threshold, PixelDiffAccum& acc)
+{
+    size_t blocks = pixels / 4;
+#if defined(IMAGE_DIFF_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i thr = _mm_set1_epi8((char)threshold);
+    const __m128i allOnes = _mm_set1_epi32(-1);
+    __m128i sum = zero;
+    __m128i maxv = zero;
+    long long differing = 0;
+    for (size_t i = 0; i < blocks; ++i) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i * 16));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i * 16));
+        __m128i d = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(d, zero));
+        maxv = _mm_max_epu8(maxv, d);
+        // A pixel is within tolerance when all 4 channels are <= threshold
+        __m128i within = _mm_cmpeq_epi8(_mm_subs_epu8(d, thr), zero);
+        int okMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(within, allOnes)));
+        differing += 4 - bitCount4[okMask];
+    }
+    alignas(16) unsigned long long sums[2];
+    alignas(16) uint8_t maxes[16];
+    _mm_store_si128((__m128i*)sums, sum);
+    _mm_store_si128((__m128i*)maxes, maxv);
+    acc.sumAbs += sums[0] + sums[1];
+    for (uint8_t m : maxes)
+        acc.maxDiff = std::max(acc.maxDiff, (int)m);
+    acc.differing += differing;
+    return blocks * 4;
+#elif defined(IMAGE_DIFF_NEON)
+    const uint8x16_t thr = vdupq_n_u8((uint8_t)threshold);
+    uint64x2_t sum = vdupq_n_u64(0);
+    uint8x16_t maxv = vdupq_n_u8(0);
+    uint32x4_t differing = vdupq_n_u32(0);
+    for (size_t i = 0; i < blocks; ++i) {
+        uint8x16_t d = vabdq_u8(vld1q_u8(a + i * 16), vld1q_u8(b + i * 16));
+        sum = vpadalq_u32(sum, vpaddlq_u16(vpaddlq_u8(d)));
+        maxv = vmaxq_u8(maxv, d);
+        uint32x4_t over = vreinterpretq_u32_u8(vcgtq_u8(d, thr));
+        differing = vaddq_u32(differing, vshrq_n_u32(vtstq_u32(over, over), 31));
+    }
+    // Lane by lane: vmaxvq/vaddvq are AArch64 only and this also builds for armv7 NEON
+    uint8_t maxes[16];
+    uint32_t counts[4];
+    vst1q_u8(maxes, maxv);
+    vst1q_u32(counts, differing);
+    acc.sumAbs += vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1);
+    for (uint8_t m : maxes)
+        acc.maxDiff = std::max(acc.maxDiff, (int)m);
+    acc.differing += (long long)counts[0] + counts[1] + counts[2] + counts[3];
+    return blocks * 4;
+#else
+    (void)a; (void)b; (void)threshold; (void)acc; (void)blocks;
+    return 0;
+#endif
+}
+
+static void luminance(const uint8_t* rgba, size_t pixels, std::vector<float>& luma)
+{
+    luma.resize(pixels);
+    for (size_t p = 0; p < pixels; ++p)
+        luma[p] = 0.299f * rgba[p * 4] + 0.587f * rgba[p * 4 + 1] + 0.114f * rgba[p * 4 + 2];
+}
+
+// Mean SSIM over 8x8 windows with a stride of 4
+static double meanSSIM(const std::vector<float>& x, const std::vector<float>& y, int width, int height)
+{
+    const int window = 8;
+    const int stride = 4;
+    const double c1 = (0.01 * 255) * (0.01 * 255);
+    const double c2 = (0.03 * 255) * (0.03 * 255);
+    const double n = window * window;
+
+    double total = 0.0;
+    long long windows = 0;
+    for (int wy = 0; wy + window <= height; wy += stride) {
+        for (int wx = 0; wx + window <= width; wx += stride) {
+            double sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0;
+            for (int j = 0; j < window; ++j) {
+                const float* rowX = &x[(size_t)(wy + j) * width + wx];
+                const float* rowY = &y[(size_t)(wy + j) * width + wx];
+                for (int i = 0; i < window; ++i) {
+                    sx += rowX[i];
+                    sy += rowY[i];
+                    sxx += rowX[i] * rowX[i];
+                    syy += rowY[i] * rowY[i];
+                    sxy += rowX[i] * rowY[i];
+                }
+            }
+            double mx = sx / n, my = sy / n;
+            double vx = sxx / n - mx * mx;
+            double vy = syy / n - my * my;
+            double cov = sxy / n - mx * my;
+            total += ((2 * mx * my + c1) * (2 * cov + c2)) / ((mx * mx + my * my + c1) * (vx + vy + c2));
+            windows++;
+        }
+    }
+    return windows > 0 ? total / windows : 1.0;
+}
+
+ImageDiffResult compareImages(const uint8_t* a, const uint8_t* b, int width, int height, int pixelThreshold)
+{
+    ImageDiffResult result;
+    size_t pixels = (size_t)width * height;
+    if (pixels == 0)
+        return result;
+
+    int threshold = std::min(std::max(pixelThreshold, 0), 255);
+    PixelDiffAccum acc;
+    size_t done = diffPixelsSIMD(a, b, pixels, threshold, acc);
+    diffPixelsScalar(a + done * 4, b + done * 4, pixels - done, threshold, acc);
+
+    result.maxChannelDiff = acc.maxDiff;
+    result.meanAbsDiff = (double)acc.sumAbs / (pixels * 4);
+    result.differingPixels = acc.differing;
+
+    if (acc.maxDiff == 0) {
+        result.ssim = 1.0;
+    } else {
+        std::vector<float> lumaA, lumaB;
+        luminance(a, pixels, lumaA);
+        luminance(b, pixels, lumaB);
+        result.ssim = meanSSIM(lumaA, lumaB, width, height);
+    }
+    return result;
+}
+
+void buildDiffImage(const uint8_t* a, const uint8_t* b, int width, int height, std::vector<uint8_t>& diff)
+{
+    size_t pixels = (size_t)width * height;
+    diff.resize(pixels * 4);
+    for (size_t p = 0; p < pixels; ++p) {
+        for (int c = 0; c < 3; ++c) {
+            int d = std::abs((int)a[p * 4 + c] - (int)b[p * 4 + c]);
+            diff[p * 4 + c] = (uint8_t)std::min(d * 8, 255);
+        }
+        diff[p * 4 + 3] = 255;
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef IMAGE_DIFF_H
+#define IMAGE_DIFF_H
+
+#include <cstdint>
+#include <vector>
+
+struct ImageDiffResult {
+    int maxChannelDiff = 0;     // largest absolute difference of any channel
+    double meanAbsDiff = 0.0;   // mean absolute difference per channel
+    long long differingPixels = 0; // pixels with any channel off by more than the threshold
+    double ssim = 1.0;          // mean SSIM of the luminance, 8x8 windows
+};
+
+// Compares two RGBA8 images of the same size. The per-pixel pass uses SSE2
+// or NEON when available; SSIM runs on the luminance plane.
+ImageDiffResult compareImages(const uint8_t* a, const uint8_t* b, int width, int height, int pixelThreshold);
+
+// Visualisation of |a - b| per channel, amplified, opaque
+void buildDiffImage(const uint8_t* a, const uint8_t* b, int width, int height, std::vector<uint8_t>& diff);
+
+#endif // IMAGE_DIFF_H
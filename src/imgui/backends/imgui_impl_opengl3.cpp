@@ -22,6 +22,9 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  (local)     OpenGL: Added ImGui_ImplOpenGL3_SetKnownState(): skip the per-frame glGet*() state backup and restore only what was changed.
+//  (local)     OpenGL: Added ImGui_ImplOpenGL3_SetStreamingMode(): persistent VAO, all draw lists in one vertex/index ring (persistently mapped with fences, or orphaned), base-vertex draws.
+//  (local)     OpenGL: Upload the font atlas region changed by dynamic glyphs (ImFontAtlas::TexUpdateX0..Y1) before rendering, reallocate the texture when the atlas grew.
 //  2024-10-07: OpenGL: Changed default texture sampler to Clamp instead of Repeat/Wrap.
 //  2024-06-28: OpenGL: ImGui_ImplOpenGL3_NewFrame() recreates font texture if it has been destroyed by ImGui_ImplOpenGL3_DestroyFontsTexture(). (#7748)
 //  2024-05-07: OpenGL: Update loader for Linux to support EGL/GLVND. (#7562)
@@ -209,6 +212,11 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 3.2+ has glMapBufferRange() and fence syncs, plus glDrawElementsBaseVertex() to draw every list out of one buffer: streaming mode
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET) && defined(IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+#endif
+
 // [Debugging]
 //#define IMGUI_IMPL_OPENGL_DEBUG
 #ifdef IMGUI_IMPL_OPENGL_DEBUG
@@ -228,6 +236,7 @@ struct ImGui_ImplOpenGL3_Data
     bool            GlProfileIsCompat;
     GLint           GlProfileMask;
     GLuint          FontTexture;
+    int             FontTextureHeight;       // Height last uploaded: the atlas grows when dynamic glyphs run out of room
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
@@ -241,6 +250,22 @@ struct ImGui_ImplOpenGL3_Data
     bool            HasClipOrigin;
     bool            UseBufferSubData;
 
+    // Streaming mode, see ImGui_ImplOpenGL3_SetStreamingMode()
+    bool            UseStreaming;
+    bool            HasBufferStorage;        // GL 4.4 or GL_ARB_buffer_storage: persistently mapped ring, otherwise one orphaned buffer
+    GLuint          StreamVao;               // Kept across frames (VAOs are not shared between GL contexts: one GL context per Dear ImGui context)
+    GLuint          StreamVboHandle, StreamElementsHandle;
+    int             StreamVtxCapacity;       // Vertices/indices per ring region
+    int             StreamIdxCapacity;
+    ImDrawVert*     StreamVtxMapped;         // Whole ring, mapped for its lifetime (nullptr when orphaning)
+    ImDrawIdx*      StreamIdxMapped;
+    GLsync          StreamFences[3];         // One per region: the GPU may still read the two previous submissions
+    int             StreamRegion;
+
+    // State declared by the application, see ImGui_ImplOpenGL3_SetKnownState()
+    bool                            HasKnownState;
+    ImGui_ImplOpenGL3_KnownState    KnownState;
+
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
 
@@ -382,8 +407,14 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != nullptr && strcmp(extension, "GL_ARB_clip_control") == 0)
             bd->HasClipOrigin = true;
+        if (extension != nullptr && strcmp(extension, "GL_ARB_buffer_storage") == 0)
+            bd->HasBufferStorage = true;
     }
 #endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    if (bd->GlVersion >= 440)
+        bd->HasBufferStorage = true;
+#endif
 
     return true;
 }
@@ -436,7 +467,11 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     // Support for GL 4.5 rarely used glClipControl(GL_UPPER_LEFT)
 #if defined(GL_CLIP_ORIGIN)
     bool clip_origin_lower_left = true;
-    if (bd->HasClipOrigin)
+    if (bd->HasKnownState)
+    {
+        clip_origin_lower_left = !bd->KnownState.ClipOriginUpperLeft;
+    }
+    else if (bd->HasClipOrigin)
     {
         GLenum current_clip_origin = 0; glGetIntegerv(GL_CLIP_ORIGIN, (GLint*)&current_clip_origin);
         if (current_clip_origin == GL_UPPER_LEFT)
@@ -476,8 +511,10 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 #endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
-    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
-    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle));
+    // (the persistent streaming VAO draws from the streaming ring)
+    const bool streaming = (vertex_array_object != 0 && vertex_array_object == bd->StreamVao);
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, streaming ? bd->StreamVboHandle : bd->VboHandle));
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, streaming ? bd->StreamElementsHandle : bd->ElementsHandle));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxPos));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxUV));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxColor));
@@ -486,6 +523,194 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, col)));
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+// Waits for the GPU to release every region, then frees the ring
+static void ImGui_ImplOpenGL3_DestroyStreamBuffers()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    for (GLsync& fence : bd->StreamFences)
+        if (fence)
+        {
+            glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    GLint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
+    if (bd->StreamVtxMapped) { glBindBuffer(GL_ARRAY_BUFFER, bd->StreamVboHandle); glUnmapBuffer(GL_ARRAY_BUFFER); bd->StreamVtxMapped = nullptr; }
+    if (bd->StreamIdxMapped) { glBindBuffer(GL_ARRAY_BUFFER, bd->StreamElementsHandle); glUnmapBuffer(GL_ARRAY_BUFFER); bd->StreamIdxMapped = nullptr; }
+    glBindBuffer(GL_ARRAY_BUFFER, (GLuint)last_array_buffer);
+    if (bd->StreamVboHandle)      { glDeleteBuffers(1, &bd->StreamVboHandle); bd->StreamVboHandle = 0; }
+    if (bd->StreamElementsHandle) { glDeleteBuffers(1, &bd->StreamElementsHandle); bd->StreamElementsHandle = 0; }
+    bd->StreamVtxCapacity = bd->StreamIdxCapacity = 0;
+    bd->StreamRegion = 0;
+}
+
+// Creates a buffer of region_size bytes per region through the GL_ARRAY_BUFFER target (so no VAO binding is touched)
+static void* ImGui_ImplOpenGL3_CreateStreamBuffer(GLuint* handle, GLsizeiptr region_size)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    void* mapped = nullptr;
+    GL_CALL(glGenBuffers(1, handle));
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, *handle));
+    if (bd->HasBufferStorage)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GL_CALL(glBufferStorage(GL_ARRAY_BUFFER, region_size * IM_ARRAYSIZE(bd->StreamFences), nullptr, flags));
+        mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, region_size * IM_ARRAYSIZE(bd->StreamFences), flags);
+    }
+    else
+    {
+        GL_CALL(glBufferData(GL_ARRAY_BUFFER, region_size, nullptr, GL_STREAM_DRAW));
+    }
+    return mapped;
+}
+
+// Copies every draw list into the ring, growing it first if needed.
+// Returns the region written to, its first vertex and its first index.
+static int ImGui_ImplOpenGL3_UploadStreamed(ImDrawData* draw_data, int* vtx_base, int* idx_base)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (bd->StreamVtxCapacity < draw_data->TotalVtxCount || bd->StreamIdxCapacity < draw_data->TotalIdxCount)
+    {
+        // Grow geometrically (this waits for the GPU once), starting large enough for a typical UI
+        int vtx_capacity = bd->StreamVtxCapacity > 0 ? bd->StreamVtxCapacity * 2 : 1 << 16;
+        int idx_capacity = bd->StreamIdxCapacity > 0 ? bd->StreamIdxCapacity * 2 : 1 << 17;
+        while (vtx_capacity < draw_data->TotalVtxCount) vtx_capacity *= 2;
+        while (idx_capacity < draw_data->TotalIdxCount) idx_capacity *= 2;
+        GLint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
+        ImGui_ImplOpenGL3_DestroyStreamBuffers();
+        bd->StreamVtxMapped = (ImDrawVert*)ImGui_ImplOpenGL3_CreateStreamBuffer(&bd->StreamVboHandle, (GLsizeiptr)vtx_capacity * (int)sizeof(ImDrawVert));
+        bd->StreamIdxMapped = (ImDrawIdx*)ImGui_ImplOpenGL3_CreateStreamBuffer(&bd->StreamElementsHandle, (GLsizeiptr)idx_capacity * (int)sizeof(ImDrawIdx));
+        if (bd->HasBufferStorage && (!bd->StreamVtxMapped || !bd->StreamIdxMapped))
+        {
+            // Persistent mapping failed: fall back to orphaning for good
+            ImGui_ImplOpenGL3_DestroyStreamBuffers();
+            bd->HasBufferStorage = false;
+            ImGui_ImplOpenGL3_CreateStreamBuffer(&bd->StreamVboHandle, (GLsizeiptr)vtx_capacity * (int)sizeof(ImDrawVert));
+            ImGui_ImplOpenGL3_CreateStreamBuffer(&bd->StreamElementsHandle, (GLsizeiptr)idx_capacity * (int)sizeof(ImDrawIdx));
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, (GLuint)last_array_buffer);
+        bd->StreamVtxCapacity = vtx_capacity;
+        bd->StreamIdxCapacity = idx_capacity;
+    }
+
+    ImDrawVert* vtx_dst;
+    ImDrawIdx* idx_dst;
+    int region = 0;
+    if (bd->StreamVtxMapped)
+    {
+        // Persistent ring: wait until the GPU has finished the submission that last used this region
+        region = bd->StreamRegion;
+        bd->StreamRegion = (region + 1) % IM_ARRAYSIZE(bd->StreamFences);
+        if (GLsync fence = bd->StreamFences[region])
+        {
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_TIMEOUT_EXPIRED) {}
+            glDeleteSync(fence);
+            bd->StreamFences[region] = nullptr;
+        }
+        vtx_dst = bd->StreamVtxMapped + region * bd->StreamVtxCapacity;
+        idx_dst = bd->StreamIdxMapped + region * bd->StreamIdxCapacity;
+    }
+    else
+    {
+        // Orphaning: the driver hands out fresh storage while the GPU still reads the old one.
+        // Nothing to upload for an empty frame, and mapping 0 bytes is GL_INVALID_VALUE.
+        vtx_dst = nullptr;
+        idx_dst = nullptr;
+        if (draw_data->TotalVtxCount > 0 && draw_data->TotalIdxCount > 0)
+        {
+            const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+            GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->StreamVboHandle));
+            vtx_dst = (ImDrawVert*)glMapBufferRange(GL_ARRAY_BUFFER, 0, (GLsizeiptr)draw_data->TotalVtxCount * (int)sizeof(ImDrawVert), access);
+            GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->StreamElementsHandle));
+            idx_dst = (ImDrawIdx*)glMapBufferRange(GL_ARRAY_BUFFER, 0, (GLsizeiptr)draw_data->TotalIdxCount * (int)sizeof(ImDrawIdx), access);
+        }
+    }
+    *vtx_base = region * bd->StreamVtxCapacity;
+    *idx_base = region * bd->StreamIdxCapacity;
+
+    if (vtx_dst && idx_dst)
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+        {
+            const ImDrawList* draw_list = draw_data->CmdLists[n];
+            memcpy(vtx_dst, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+            memcpy(idx_dst, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+            vtx_dst += draw_list->VtxBuffer.Size;
+            idx_dst += draw_list->IdxBuffer.Size;
+        }
+
+    if (!bd->StreamVtxMapped)
+    {
+        if (vtx_dst) { GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->StreamVboHandle)); glUnmapBuffer(GL_ARRAY_BUFFER); }
+        if (idx_dst) { GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->StreamElementsHandle)); glUnmapBuffer(GL_ARRAY_BUFFER); }
+    }
+    return region;
+}
+#endif
+
+void    ImGui_ImplOpenGL3_SetStreamingMode(bool enabled)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    bd->UseStreaming = enabled && bd->GlVersion >= 320;
+#else
+    IM_UNUSED(enabled);
+#endif
+}
+
+void    ImGui_ImplOpenGL3_SetKnownState(const ImGui_ImplOpenGL3_KnownState* state)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->HasKnownState = (state != nullptr);
+    if (state)
+        bd->KnownState = *state;
+}
+
+bool    ImGui_ImplOpenGL3_GetStreamingMode()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    return bd != nullptr && bd->UseStreaming;
+}
+
+// Upload what dynamic glyphs changed in the atlas since the last frame (the texture unit 0 binding is restored by the caller)
+static void ImGui_ImplOpenGL3_UpdateFontsTexture()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    if (bd->FontTexture == 0 || atlas->TexUpdateX0 >= atlas->TexUpdateX1)
+        return;
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, bd->FontTexture));
+    if (height != bd->FontTextureHeight)
+    {
+        // Grown: same texture name, so the ImTextureID already in draw commands stays valid
+#ifdef GL_UNPACK_ROW_LENGTH
+        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+        GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        bd->FontTextureHeight = height;
+    }
+    else
+    {
+#ifdef GL_UNPACK_ROW_LENGTH
+        const int x0 = atlas->TexUpdateX0, x1 = atlas->TexUpdateX1;
+        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, width));
+#else
+        const int x0 = 0, x1 = width; // Whole rows without GL_UNPACK_ROW_LENGTH (WebGL/ES2)
+#endif
+        const int y0 = atlas->TexUpdateY0, y1 = atlas->TexUpdateY1;
+        GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, x0, y0, x1 - x0, y1 - y0, GL_RGBA, GL_UNSIGNED_BYTE, pixels + ((size_t)y0 * width + x0) * 4));
+#ifdef GL_UNPACK_ROW_LENGTH
+        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+    }
+    atlas->TexUpdateX0 = atlas->TexUpdateY0 = atlas->TexUpdateX1 = atlas->TexUpdateY1 = 0;
+}
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -500,14 +725,97 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
     // Backup GL state
-    GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
-    glActiveTexture(GL_TEXTURE0);
-    GLuint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
-    GLuint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
+    // (unless the application declared it with ImGui_ImplOpenGL3_SetKnownState(), sparing ~25 queries that may each stall the pipeline)
+    const bool known_state = bd->HasKnownState;
+    const ImGui_ImplOpenGL3_KnownState& known = bd->KnownState;
+    GLenum last_active_texture;
+    GLuint last_program;
+    GLuint last_texture;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+    GLuint last_sampler;
+#endif
+    GLuint last_array_buffer;
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    GLuint last_vertex_array_object;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
+    GLint last_polygon_mode[2];
+#endif
+    GLint last_viewport[4];
+    GLint last_scissor_box[4];
+    GLenum last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha;
+    GLenum last_blend_equation_rgb, last_blend_equation_alpha;
+    GLboolean last_enable_blend, last_enable_cull_face, last_enable_depth_test, last_enable_stencil_test, last_enable_scissor_test;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+    GLboolean last_enable_primitive_restart;
+#endif
+    if (known_state)
+    {
+        last_active_texture = (GLenum)known.ActiveTexture;
+        if (last_active_texture != GL_TEXTURE0)
+            glActiveTexture(GL_TEXTURE0);
+        last_program = known.Program;
+        last_texture = known.Texture2D;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        last_sampler = known.Sampler;
+#endif
+        last_array_buffer = known.ArrayBuffer;
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        last_vertex_array_object = known.VertexArray;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
+        last_polygon_mode[0] = (GLint)known.PolygonMode[0]; last_polygon_mode[1] = (GLint)known.PolygonMode[1];
+#endif
+        memcpy(last_viewport, known.Viewport, sizeof(last_viewport));
+        memcpy(last_scissor_box, known.ScissorBox, sizeof(last_scissor_box));
+        last_blend_src_rgb = (GLenum)known.BlendSrcRgb;
+        last_blend_dst_rgb = (GLenum)known.BlendDstRgb;
+        last_blend_src_alpha = (GLenum)known.BlendSrcAlpha;
+        last_blend_dst_alpha = (GLenum)known.BlendDstAlpha;
+        last_blend_equation_rgb = (GLenum)known.BlendEquationRgb;
+        last_blend_equation_alpha = (GLenum)known.BlendEquationAlpha;
+        last_enable_blend = known.Blend;
+        last_enable_cull_face = known.CullFace;
+        last_enable_depth_test = known.DepthTest;
+        last_enable_stencil_test = known.StencilTest;
+        last_enable_scissor_test = known.ScissorTest;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        last_enable_primitive_restart = known.PrimitiveRestart;
+#endif
+    }
+    else
+    {
+        glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
+        glActiveTexture(GL_TEXTURE0);
+        glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    GLuint last_sampler; if (bd->GlVersion >= 330 || bd->GlProfileIsES3) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
+        if (bd->GlVersion >= 330 || bd->GlProfileIsES3) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
 #endif
-    GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
+        if (bd->HasPolygonMode) { glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode); }
+#endif
+        glGetIntegerv(GL_VIEWPORT, last_viewport);
+        glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
+        glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
+        glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
+        glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
+        glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
+        glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
+        last_enable_blend = glIsEnabled(GL_BLEND);
+        last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
+        last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
+        last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
+        last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        last_enable_primitive_restart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
+#endif
+    }
 #ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
     GLint last_element_array_buffer; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
@@ -515,35 +823,27 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_uv; last_vtx_attrib_state_uv.GetState(bd->AttribLocationVtxUV);
     ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_color; last_vtx_attrib_state_color.GetState(bd->AttribLocationVtxColor);
 #endif
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GLuint last_vertex_array_object; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
-#endif
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
-    GLint last_polygon_mode[2]; if (bd->HasPolygonMode) { glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode); }
-#endif
-    GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
-    GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-    GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-    GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-    GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-    GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-    GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-    GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-    GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-    GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-    GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
-    GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    GLboolean last_enable_primitive_restart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
-#endif
+
+    ImGui_ImplOpenGL3_UpdateFontsTexture();
 
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
+    // In streaming mode the VAO is kept instead, and every draw list is uploaded at once before any state is set up.
     GLuint vertex_array_object = 0;
+    int stream_region = -1, stream_vtx_base = 0, stream_idx_base = 0;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    if (bd->UseStreaming)
+    {
+        if (bd->StreamVao == 0)
+            GL_CALL(glGenVertexArrays(1, &bd->StreamVao));
+        vertex_array_object = bd->StreamVao;
+        stream_region = ImGui_ImplOpenGL3_UploadStreamed(draw_data, &stream_vtx_base, &stream_idx_base);
+    }
+#endif
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GL_CALL(glGenVertexArrays(1, &vertex_array_object));
+    if (vertex_array_object == 0)
+        GL_CALL(glGenVertexArrays(1, &vertex_array_object));
 #endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
@@ -556,6 +856,33 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     {
         const ImDrawList* draw_list = draw_data->CmdLists[n];
 
+        // Already uploaded: offset this list's commands into the ring instead
+        if (stream_region >= 0)
+        {
+            for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
+            {
+                const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
+                if (pcmd->UserCallback != nullptr)
+                {
+                    if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                        ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                    else
+                        pcmd->UserCallback(draw_list, pcmd);
+                    continue;
+                }
+                ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+                ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+                if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+                    continue;
+                GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
+                GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+                GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)((stream_idx_base + pcmd->IdxOffset) * sizeof(ImDrawIdx)), (GLint)(stream_vtx_base + pcmd->VtxOffset)));
+            }
+            stream_vtx_base += draw_list->VtxBuffer.Size;
+            stream_idx_base += draw_list->IdxBuffer.Size;
+            continue;
+        }
+
         // Upload vertex/index buffers
         // - OpenGL drivers are in a very sorry state nowadays....
         //   During 2021 we attempted to switch from glBufferData() to orphaning+glBufferSubData() following reports
@@ -624,10 +951,61 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 
     // Destroy the temporary VAO
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
+    if (stream_region < 0)
+        GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    // Mark the end of the GPU's reads from this region
+    if (stream_region >= 0 && bd->StreamVtxMapped)
+        bd->StreamFences[stream_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 #endif
 
     // Restore modified GL state
+    if (known_state)
+    {
+        // Only what differs from the state set up above (draw callbacks must leave that state as they found it)
+        glUseProgram(last_program);
+        glBindTexture(GL_TEXTURE_2D, last_texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if ((bd->GlVersion >= 330 || bd->GlProfileIsES3) && last_sampler != 0)
+            glBindSampler(0, last_sampler);
+#endif
+        if (last_active_texture != GL_TEXTURE0)
+            glActiveTexture(last_active_texture);
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glBindVertexArray(last_vertex_array_object);
+#else
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer);
+        last_vtx_attrib_state_pos.SetState(bd->AttribLocationVtxPos);
+        last_vtx_attrib_state_uv.SetState(bd->AttribLocationVtxUV);
+        last_vtx_attrib_state_color.SetState(bd->AttribLocationVtxColor);
+#endif
+        if (last_array_buffer != (stream_region >= 0 ? bd->StreamVboHandle : bd->VboHandle))
+            glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+        if (last_blend_equation_rgb != GL_FUNC_ADD || last_blend_equation_alpha != GL_FUNC_ADD)
+            glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
+        if (last_blend_src_rgb != GL_SRC_ALPHA || last_blend_dst_rgb != GL_ONE_MINUS_SRC_ALPHA || last_blend_src_alpha != GL_ONE || last_blend_dst_alpha != GL_ONE_MINUS_SRC_ALPHA)
+            glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
+        if (!last_enable_blend) glDisable(GL_BLEND);
+        if (last_enable_cull_face) glEnable(GL_CULL_FACE);
+        if (last_enable_depth_test) glEnable(GL_DEPTH_TEST);
+        if (last_enable_stencil_test) glEnable(GL_STENCIL_TEST);
+        if (!last_enable_scissor_test) glDisable(GL_SCISSOR_TEST);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        if (bd->GlVersion >= 310 && last_enable_primitive_restart) glEnable(GL_PRIMITIVE_RESTART);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
+        if (bd->HasPolygonMode && (last_polygon_mode[0] != GL_FILL || last_polygon_mode[1] != GL_FILL))
+        {
+            if (bd->GlVersion <= 310 || bd->GlProfileIsCompat) { glPolygonMode(GL_FRONT, (GLenum)last_polygon_mode[0]); glPolygonMode(GL_BACK, (GLenum)last_polygon_mode[1]); } else { glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]); }
+        }
+#endif
+        if (last_viewport[0] != 0 || last_viewport[1] != 0 || last_viewport[2] != fb_width || last_viewport[3] != fb_height)
+            glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
+        glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+        return;
+    }
+
     // This "glIsProgram()" check is required because if the program is "pending deletion" at the time of binding backup, it will have been deleted by now and will cause an OpenGL error. See #6220.
     if (last_program == 0 || glIsProgram(last_program)) glUseProgram(last_program);
     glBindTexture(GL_TEXTURE_2D, last_texture);
@@ -691,6 +1069,8 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
 #endif
     GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    bd->FontTextureHeight = height;
+    io.Fonts->TexUpdateX0 = io.Fonts->TexUpdateY0 = io.Fonts->TexUpdateX1 = io.Fonts->TexUpdateY1 = 0;
 
     // Store identifier
     io.Fonts->SetTexID((ImTextureID)(intptr_t)bd->FontTexture);
@@ -954,6 +1334,10 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
     if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    ImGui_ImplOpenGL3_DestroyStreamBuffers();
+    if (bd->StreamVao)      { glDeleteVertexArrays(1, &bd->StreamVao); bd->StreamVao = 0; }
+#endif
     ImGui_ImplOpenGL3_DestroyFontsTexture();
 }
 
@@ -41,6 +41,33 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyFontsTexture();
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateDeviceObjects();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 
+// (Optional) Streaming mode (Desktop GL 3.2+, ignored otherwise): keeps one VAO across frames and uploads all draw lists at once into
+// a vertex/index ring (persistently mapped and fenced with GL 4.4 / GL_ARB_buffer_storage, otherwise orphaned), drawn with base-vertex offsets.
+// Its VAO is not shared between GL contexts: use it with a single GL context per Dear ImGui context.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetStreamingMode(bool enabled);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_GetStreamingMode();
+
+// (Optional) GL state the application guarantees to be current whenever ImGui_ImplOpenGL3_RenderDrawData() is called, e.g. taken from its
+// own state cache. While set, RenderDrawData() skips its glGet*()/glIsEnabled() backup and restores only the state it changed, to these values.
+// Draw callbacks must then leave the backend's render state as they found it. Pass nullptr to go back to querying (default).
+struct ImGui_ImplOpenGL3_KnownState
+{
+    unsigned int    Program;
+    unsigned int    VertexArray;
+    unsigned int    ArrayBuffer;
+    unsigned int    ActiveTexture;              // GL_TEXTURE0 + unit
+    unsigned int    Texture2D;                  // GL_TEXTURE_2D binding on unit 0
+    unsigned int    Sampler;                    // Sampler bound to unit 0
+    int             Viewport[4];
+    int             ScissorBox[4];
+    unsigned int    BlendSrcRgb, BlendDstRgb, BlendSrcAlpha, BlendDstAlpha;
+    unsigned int    BlendEquationRgb, BlendEquationAlpha;
+    unsigned int    PolygonMode[2];             // Front, back
+    bool            Blend, CullFace, DepthTest, StencilTest, ScissorTest, PrimitiveRestart;
+    bool            ClipOriginUpperLeft;        // glClipControl(GL_UPPER_LEFT, ...)
+};
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetKnownState(const ImGui_ImplOpenGL3_KnownState* state);
+
 // Configuration flags to add in your imconfig file:
 //#define IMGUI_IMPL_OPENGL_ES2     // Enable ES 2 (Auto-detected on Emscripten)
 //#define IMGUI_IMPL_OPENGL_ES3     // Enable ES 3 (Auto-detected on iOS/Android)
@@ -130,6 +130,9 @@
 //---- Debug Tools: Enable slower asserts
 //#define IMGUI_DEBUG_PARANOID
 
+//---- Profiling: Scope macro placed in hot paths (NewFrame, EndFrame, Render, Begin, ImFontAtlas::Build). Expands to nothing by default.
+//#define IMGUI_PROFILE_SCOPE(_NAME)  MyProfilerScope MyScope(_NAME)
+
 //---- Tip: You can add extra functions within the ImGui:: namespace from anywhere (e.g. your own sources/header files)
 /*
 namespace ImGui
@@ -1278,6 +1278,11 @@ static void             UpdateViewportsNewFrame();
 #ifndef GImGui
 ImGuiContext*   GImGui = NULL;
 #endif
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+// (local) Detached draw lists allocate from worker threads while the context is current: only the thread that drives
+// the context (SetCurrentContext(), NewFrame()) records into its allocation stats.
+static thread_local ImGuiContext* GImDebugAllocContext = NULL;
+#endif
 
 // Memory Allocator functions. Use SetAllocatorFunctions() to change them.
 // - You probably don't want to modify that mid-program, and if you use global/static e.g. ImVector<> instances you may need to keep them accessible during program destruction.
@@ -2150,11 +2155,33 @@ void ImFormatStringToTempBufferV(const char** out_buf, const char** out_buf_end,
     }
 }
 
-#ifndef IMGUI_ENABLE_SSE4_2
+// (local) Hardware CRC32C, picked at runtime when the build doesn't already target it (see ImHashSetBackend()).
+// Every backend computes the same CRC32C, so IDs and .ini hashes don't depend on the CPU.
+#if defined(IMGUI_ENABLE_SSE4_2)
+#define IMGUI_HASH_CRC32C_SSE42
+#define IMGUI_HASH_CRC32C_ALWAYS
+#define IMGUI_HASH_TARGET_CRC32C
+#elif defined(IMGUI_ENABLE_SSE) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define IMGUI_HASH_CRC32C_SSE42
+#if defined(__GNUC__) || defined(__clang__)
+#define IMGUI_HASH_TARGET_CRC32C __attribute__((target("sse4.2")))
+#else
+#define IMGUI_HASH_TARGET_CRC32C
+#include <intrin.h>             // __cpuid
+#endif
+#elif defined(__ARM_FEATURE_CRC32) && !defined(__ARM_BIG_ENDIAN)
+#define IMGUI_HASH_CRC32C_ARM
+#define IMGUI_HASH_CRC32C_ALWAYS
+#define IMGUI_HASH_TARGET_CRC32C
+#include <arm_acle.h>
+#endif
+#include <atomic>               // (local) GImHashBackend
+
 // CRC32 needs a 1KB lookup table (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
 // On 2024/11/27 this was changed from crc32-adler to crc32c (polynomial 0x1EDC6F41), which invalidated some hashes stored in .ini files.
+// (local) Always compiled: it is the fallback of the runtime dispatch and ImGuiHashBackend_Table.
 static const ImU32 GCrc32LookupTable[256] =
 {
     0x00000000,0xF26B8303,0xE13B70F7,0x1350F3F4,0xC79A971F,0x35F1141C,0x26A1E7E8,0xD4CA64EB,0x8AD958CF,0x78B2DBCC,0x6BE22838,0x9989AB3B,0x4D43CFD0,0xBF284CD3,0xAC78BF27,0x5E133C24,
@@ -2174,31 +2201,146 @@ static const ImU32 GCrc32LookupTable[256] =
     0xE330A81A,0x115B2B19,0x020BD8ED,0xF0605BEE,0x24AA3F05,0xD6C1BC06,0xC5914FF2,0x37FACCF1,0x69E9F0D5,0x9B8273D6,0x88D28022,0x7AB90321,0xAE7367CA,0x5C18E4C9,0x4F48173D,0xBD23943E,
     0xF36E6F75,0x0105EC76,0x12551F82,0xE03E9C81,0x34F4F86A,0xC69F7B69,0xD5CF889D,0x27A40B9E,0x79B737BA,0x8BDCB4B9,0x988C474D,0x6AE7C44E,0xBE2DA0A5,0x4C4623A6,0x5F16D052,0xAD7D5351
 };
+
+#if defined(IMGUI_HASH_CRC32C_SSE42) || defined(IMGUI_HASH_CRC32C_ARM)
+#define IMGUI_HASH_CRC32C_HW
+
+static inline IMGUI_HASH_TARGET_CRC32C ImU32 ImCrc32cHw8(ImU32 crc, ImU64 v)
+{
+#if defined(IMGUI_HASH_CRC32C_ARM)
+    return __crc32cd(crc, v);
+#elif defined(__x86_64__) || defined(_M_X64)
+    return (ImU32)_mm_crc32_u64(crc, v);
+#else
+    return _mm_crc32_u32(_mm_crc32_u32(crc, (ImU32)v), (ImU32)(v >> 32));
+#endif
+}
+
+static inline IMGUI_HASH_TARGET_CRC32C ImU32 ImCrc32cHw1(ImU32 crc, unsigned char c)
+{
+#if defined(IMGUI_HASH_CRC32C_ARM)
+    return __crc32cb(crc, c);
+#else
+    return _mm_crc32_u8(crc, c);
+#endif
+}
+
+static IMGUI_HASH_TARGET_CRC32C ImU32 ImHashDataHw(const unsigned char* data, size_t data_size, ImU32 crc)
+{
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        crc = ImCrc32cHw8(crc, v);
+    }
+    while (data_size-- != 0)
+        crc = ImCrc32cHw1(crc, *data++);
+    return crc;
+}
+
+// Word at a time: 8 bytes without any '#' (the common case) go through a single instruction, others take the byte loop
+static IMGUI_HASH_TARGET_CRC32C ImU32 ImHashStrHw(const unsigned char* data, size_t data_size, ImU32 seed)
+{
+    ImU32 crc = seed;
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        const ImU64 x = v ^ 0x2323232323232323ULL; // Zero bytes where v has '#'
+        if (((x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL) == 0)
+        {
+            crc = ImCrc32cHw8(crc, v);
+            continue;
+        }
+        for (size_t n = 0; n < 8; n++)
+        {
+            const unsigned char c = data[n];
+            if (c == '#' && data_size - n > 2 && data[n + 1] == '#' && data[n + 2] == '#')
+                crc = seed;
+            crc = ImCrc32cHw1(crc, c);
+        }
+    }
+    for (; data_size != 0; data++, data_size--)
+    {
+        const unsigned char c = *data;
+        if (c == '#' && data_size > 2 && data[1] == '#' && data[2] == '#')
+            crc = seed;
+        crc = ImCrc32cHw1(crc, c);
+    }
+    return crc;
+}
+
+static bool ImHashHwSupported()
+{
+#if defined(IMGUI_HASH_CRC32C_ALWAYS)
+    return true;
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("sse4.2") != 0;
+#else
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#endif
+}
+#endif // #if defined(IMGUI_HASH_CRC32C_SSE42) || defined(IMGUI_HASH_CRC32C_ARM)
+
+// Resolved on first use rather than by a static constructor, so ImHashXXX stay usable from other static constructors.
+// Atomic because worker threads hash too (detached draw lists, font building); racing threads all store the same value.
+static std::atomic<int> GImHashBackend(ImGuiHashBackend_Auto);
+
+static ImGuiHashBackend ImHashResolveBackend()
+{
+    ImGuiHashBackend backend = ImGuiHashBackend_Table;
+#ifdef IMGUI_HASH_CRC32C_HW
+    if (ImHashHwSupported())
+        backend = ImGuiHashBackend_Crc32cHw;
 #endif
+    GImHashBackend.store(backend, std::memory_order_relaxed);
+    return backend;
+}
+
+bool ImHashSetBackend(ImGuiHashBackend backend)
+{
+    if (backend == ImGuiHashBackend_Auto)
+    {
+        ImHashResolveBackend();
+        return true;
+    }
+    if (backend == ImGuiHashBackend_Crc32cHw)
+    {
+#ifdef IMGUI_HASH_CRC32C_HW
+        if (!ImHashHwSupported())
+            return false;
+#else
+        return false;
+#endif
+    }
+    GImHashBackend.store(backend, std::memory_order_relaxed);
+    return true;
+}
+
+ImGuiHashBackend ImHashGetBackend()
+{
+    const ImGuiHashBackend backend = (ImGuiHashBackend)GImHashBackend.load(std::memory_order_relaxed);
+    return backend != ImGuiHashBackend_Auto ? backend : ImHashResolveBackend();
+}
 
 // Known size hash
 // It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// (local) FIXME-OPT answered by ImGuiHashBackend_Crc32cHw: 8 bytes per instruction, no table.
 ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 {
     ImU32 crc = ~seed;
     const unsigned char* data = (const unsigned char*)data_p;
+#ifdef IMGUI_HASH_CRC32C_HW
+    if (ImHashGetBackend() == ImGuiHashBackend_Crc32cHw)
+        return ~ImHashDataHw(data, data_size, crc);
+#endif
     const unsigned char *data_end = (const unsigned char*)data_p + data_size;
-#ifndef IMGUI_ENABLE_SSE4_2
     const ImU32* crc32_lut = GCrc32LookupTable;
     while (data < data_end)
         crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
     return ~crc;
-#else
-    while (data + 4 <= data_end)
-    {
-        crc = _mm_crc32_u32(crc, *(ImU32*)data);
-        data += 4;
-    }
-    while (data < data_end)
-        crc = _mm_crc32_u8(crc, *data++);
-    return ~crc;
-#endif
 }
 
 // Zero-terminated string hash, with support for ### to reset back to seed value
@@ -2206,15 +2348,17 @@ ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 // Because this syntax is rarely used we are optimizing for the common case.
 // - If we reach ### in the string we discard the hash so far and reset to the seed.
 // - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// (local) With ImGuiHashBackend_Crc32cHw zero-terminated strings are measured with strlen() first, then hashed a word at a time.
 ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
 {
     seed = ~seed;
     ImU32 crc = seed;
     const unsigned char* data = (const unsigned char*)data_p;
-#ifndef IMGUI_ENABLE_SSE4_2
-    const ImU32* crc32_lut = GCrc32LookupTable;
+#ifdef IMGUI_HASH_CRC32C_HW
+    if (ImHashGetBackend() == ImGuiHashBackend_Crc32cHw)
+        return ~ImHashStrHw(data, data_size != 0 ? data_size : strlen(data_p), seed);
 #endif
+    const ImU32* crc32_lut = GCrc32LookupTable;
     if (data_size != 0)
     {
         while (data_size-- != 0)
@@ -2222,11 +2366,7 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
             unsigned char c = *data++;
             if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
                 crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2
             crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-#else
-            crc = _mm_crc32_u8(crc, c);
-#endif
         }
     }
     else
@@ -2235,11 +2375,7 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
         {
             if (c == '#' && data[0] == '#' && data[1] == '#')
                 crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2
             crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-#else
-            crc = _mm_crc32_u8(crc, c);
-#endif
         }
     }
     return ~crc;
@@ -2654,8 +2790,168 @@ static int IMGUI_CDECL PairComparerByID(const void* lhs, const void* rhs)
 void ImGuiStorage::BuildSortByKey()
 {
     ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), PairComparerByID);
+#ifdef IMGUI_STORAGE_USE_HASH_MAP
+    _RebuildIndex(0);
+#endif
+}
+
+#ifdef IMGUI_STORAGE_USE_HASH_MAP
+// (local) Open-addressing variant, see IMGUI_STORAGE_USE_HASH_MAP.
+// Keys are mostly CRC32 hashes already, but e.g. ImGuiSelectionBasicStorage stores plain indices: scramble before masking.
+static inline ImU32 ImGuiStorageSlot(ImGuiID key, ImU32 mask)
+{
+    key *= 0x9E3779B1u;
+    return (key ^ (key >> 16)) & mask;
+}
+
+// Sized for a load factor of at most 3/4. Duplicate keys (only possible by pushing into Data directly) resolve to the first one.
+void ImGuiStorage::_RebuildIndex(int min_capacity)
+{
+    int capacity = 16;
+    while (capacity * 3 < ImMax(min_capacity, Data.Size) * 4)
+        capacity *= 2;
+    _Index.resize(capacity);
+    memset(_Index.Data, 0, (size_t)_Index.size_in_bytes());
+    const ImU32 mask = (ImU32)capacity - 1;
+    for (int n = 0; n < Data.Size; n++)
+    {
+        const ImGuiID key = Data.Data[n].key;
+        ImU32 slot = ImGuiStorageSlot(key, mask);
+        while (_Index.Data[slot].val_i != 0 && _Index.Data[slot].key != key)
+            slot = (slot + 1) & mask;
+        if (_Index.Data[slot].val_i == 0)
+        {
+            _Index.Data[slot].key = key;
+            _Index.Data[slot].val_i = n + 1;
+        }
+    }
+    _IndexedSize = Data.Size;
+}
+
+ImGuiStoragePair* ImGuiStorage::_Find(ImGuiID key) const
+{
+    ImGuiStorage* self = const_cast<ImGuiStorage*>(this);
+    if (Data.Size == 0)
+        return NULL;
+    if (_IndexedSize != Data.Size)
+        self->_RebuildIndex(0);
+    const ImU32 mask = (ImU32)_Index.Size - 1;
+    for (ImU32 slot = ImGuiStorageSlot(key, mask); ; slot = (slot + 1) & mask)
+    {
+        const ImGuiStoragePair& entry = _Index.Data[slot];
+        if (entry.val_i == 0)
+            return NULL;
+        if (entry.key != key)
+            continue;
+        ImGuiStoragePair* it = &self->Data.Data[entry.val_i - 1];
+        if (it->key == key)
+            return it;
+        // Data was reordered in place (e.g. sorted by value): reindex and look again
+        self->_RebuildIndex(0);
+        return _Find(key);
+    }
+}
+
+ImGuiStoragePair* ImGuiStorage::_FindOrInsert(ImGuiID key, bool* inserted)
+{
+    *inserted = false;
+    if (ImGuiStoragePair* it = _Find(key))
+        return it;
+    if (_IndexedSize != Data.Size || (Data.Size + 1) * 4 > _Index.Size * 3)
+        _RebuildIndex(Data.Size + 1);
+    Data.push_back(ImGuiStoragePair(key, (void*)NULL));
+    const ImU32 mask = (ImU32)_Index.Size - 1;
+    ImU32 slot = ImGuiStorageSlot(key, mask);
+    while (_Index.Data[slot].val_i != 0)
+        slot = (slot + 1) & mask;
+    _Index.Data[slot].key = key;
+    _Index.Data[slot].val_i = Data.Size;
+    _IndexedSize = Data.Size;
+    *inserted = true;
+    return &Data.back();
+}
+
+int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
+{
+    const ImGuiStoragePair* it = _Find(key);
+    return it ? it->val_i : default_val;
+}
+
+bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
+{
+    return GetInt(key, default_val ? 1 : 0) != 0;
+}
+
+float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
+{
+    const ImGuiStoragePair* it = _Find(key);
+    return it ? it->val_f : default_val;
+}
+
+void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
+{
+    const ImGuiStoragePair* it = _Find(key);
+    return it ? it->val_p : NULL;
+}
+
+// References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
+int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
+{
+    bool inserted;
+    ImGuiStoragePair* it = _FindOrInsert(key, &inserted);
+    if (inserted)
+        it->val_i = default_val;
+    return &it->val_i;
+}
+
+bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
+{
+    return (bool*)GetIntRef(key, default_val ? 1 : 0);
+}
+
+float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
+{
+    bool inserted;
+    ImGuiStoragePair* it = _FindOrInsert(key, &inserted);
+    if (inserted)
+        it->val_f = default_val;
+    return &it->val_f;
+}
+
+void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
+{
+    bool inserted;
+    ImGuiStoragePair* it = _FindOrInsert(key, &inserted);
+    if (inserted)
+        it->val_p = default_val;
+    return &it->val_p;
+}
+
+void ImGuiStorage::SetInt(ImGuiID key, int val)
+{
+    bool inserted;
+    _FindOrInsert(key, &inserted)->val_i = val;
+}
+
+void ImGuiStorage::SetBool(ImGuiID key, bool val)
+{
+    SetInt(key, val ? 1 : 0);
+}
+
+void ImGuiStorage::SetFloat(ImGuiID key, float val)
+{
+    bool inserted;
+    _FindOrInsert(key, &inserted)->val_f = val;
+}
+
+void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
+{
+    bool inserted;
+    _FindOrInsert(key, &inserted)->val_p = val;
 }
 
+#else
+
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
     ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
@@ -2748,6 +3044,8 @@ void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
         it->val_p = val;
 }
 
+#endif // #ifdef IMGUI_STORAGE_USE_HASH_MAP
+
 void ImGuiStorage::SetAllInt(int v)
 {
     for (int i = 0; i < Data.Size; i++)
@@ -3793,6 +4091,9 @@ void ImGui::SetCurrentContext(ImGuiContext* ctx)
 #else
     GImGui = ctx;
 #endif
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+    GImDebugAllocContext = ctx;
+#endif
 }
 
 void ImGui::SetAllocatorFunctions(ImGuiMemAllocFunc alloc_func, ImGuiMemFreeFunc free_func, void* user_data)
@@ -4696,7 +4997,8 @@ void* ImGui::MemAlloc(size_t size)
     void* ptr = (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ImGuiContext* ctx = GImGui)
-        DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
+        if (ctx == GImDebugAllocContext)
+            DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
 #endif
     return ptr;
 }
@@ -4707,7 +5009,8 @@ void ImGui::MemFree(void* ptr)
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ptr != NULL)
         if (ImGuiContext* ctx = GImGui)
-            DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
+            if (ctx == GImDebugAllocContext)
+                DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
 #endif
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
@@ -4844,6 +5147,52 @@ ImDrawListSharedData* ImGui::GetDrawListSharedData()
     return &GImGui->DrawListSharedData;
 }
 
+// (local) The list owns its shared data, freed with it in DestroyDetachedDrawList()
+ImDrawList* ImGui::CreateDetachedDrawList()
+{
+    ImDrawListSharedData* shared_data = IM_NEW(ImDrawListSharedData)();
+    return IM_NEW(ImDrawList)(shared_data);
+}
+
+void ImGui::DestroyDetachedDrawList(ImDrawList* draw_list)
+{
+    if (draw_list == NULL)
+        return;
+    IM_ASSERT(draw_list->_Data != &GImGui->DrawListSharedData && "Not a detached draw list");
+    ImDrawListSharedData* shared_data = draw_list->_Data;
+    IM_DELETE(draw_list);
+    IM_DELETE(shared_data);
+}
+
+void ImGui::ResetDetachedDrawList(ImDrawList* draw_list, const ImDrawList* parent)
+{
+    ImGuiContext& g = *GImGui;
+    if (parent == NULL)
+        parent = GetWindowDrawList();
+    IM_ASSERT(draw_list->_Data != &g.DrawListSharedData && "Not a detached draw list");
+
+    // Everything but TempBuffer, which stays private to the list
+    ImDrawListSharedData* shared_data = draw_list->_Data;
+    const ImDrawListSharedData& src = g.DrawListSharedData;
+    shared_data->TexUvWhitePixel = src.TexUvWhitePixel;
+    shared_data->TexUvLines = src.TexUvLines;
+    shared_data->Font = src.Font;
+    shared_data->FontSize = src.FontSize;
+    shared_data->FontScale = src.FontScale;
+    shared_data->CurveTessellationTol = src.CurveTessellationTol;
+    shared_data->ClipRectFullscreen = src.ClipRectFullscreen;
+    shared_data->InitialFlags = src.InitialFlags;
+    shared_data->SetCircleTessellationMaxError(src.CircleSegmentMaxError);
+
+    draw_list->_ResetForNewFrame();
+    draw_list->Flags = parent->Flags;
+    draw_list->_FringeScale = parent->_FringeScale;
+    draw_list->_OwnerName = parent->_OwnerName;
+    const ImVec4& clip_rect = parent->_CmdHeader.ClipRect;
+    draw_list->PushClipRect(ImVec2(clip_rect.x, clip_rect.y), ImVec2(clip_rect.z, clip_rect.w));
+    draw_list->PushTextureID(parent->_CmdHeader.TextureId);
+}
+
 void ImGui::StartMouseMovingWindow(ImGuiWindow* window)
 {
     // Set ActiveId even if the _NoMove flag is set. Without it, dragging away from a window with _NoMove would activate hover on other windows.
@@ -5074,8 +5423,12 @@ static void SetupDrawListSharedData()
 
 void ImGui::NewFrame()
 {
+    IMGUI_PROFILE_SCOPE("ImGui::NewFrame");
     IM_ASSERT(GImGui != NULL && "No current context. Did you call ImGui::CreateContext() and ImGui::SetCurrentContext() ?");
     ImGuiContext& g = *GImGui;
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+    GImDebugAllocContext = &g;
+#endif
 
     // Remove pending delete hooks before frame start.
     // This deferred removal avoid issues of removal while iterating the hook vector
@@ -5113,6 +5466,7 @@ void ImGui::NewFrame()
     UpdateViewportsNewFrame();
 
     // Setup current font and draw list shared data
+    ImFontAtlasDynamicNewFrame(g.IO.Fonts); // (local) Before the UVs below are copied: the atlas may grow
     g.IO.Fonts->Locked = true;
     SetupDrawListSharedData();
     SetCurrentFont(GetDefaultFont());
@@ -5533,6 +5887,7 @@ static void ImGui::RenderDimmedBackgrounds()
 // This is normally called by Render(). You may want to call it directly if you want to avoid calling Render() but the gain will be very minimal.
 void ImGui::EndFrame()
 {
+    IMGUI_PROFILE_SCOPE("ImGui::EndFrame");
     ImGuiContext& g = *GImGui;
     IM_ASSERT(g.Initialized);
 
@@ -5628,6 +5983,7 @@ void ImGui::EndFrame()
 // it is the role of the ImGui_ImplXXXX_RenderDrawData() function provided by the renderer backend)
 void ImGui::Render()
 {
+    IMGUI_PROFILE_SCOPE("ImGui::Render");
     ImGuiContext& g = *GImGui;
     IM_ASSERT(g.Initialized);
 
@@ -6974,6 +7330,7 @@ ImGuiWindow* ImGui::FindBlockingModal(ImGuiWindow* window)
 // - Passing 'bool* p_open' displays a Close button on the upper-right corner of the window, the pointed value will be set to false when the button is pressed.
 bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 {
+    IMGUI_PROFILE_SCOPE("ImGui::Begin");
     ImGuiContext& g = *GImGui;
     const ImGuiStyle& style = g.Style;
     IM_ASSERT(name != NULL && name[0] != '\0');     // Window name required
@@ -16062,6 +16419,7 @@ void ImGui::DebugNodeFont(ImFont* font)
     Text("Ellipsis character: '%s' (U+%04X)", ImTextCharToUtf8(c_str, font->EllipsisChar), font->EllipsisChar);
     const int surface_sqrt = (int)ImSqrt((float)font->MetricsTotalSurface);
     Text("Texture Area: about %d px ~%dx%d px", font->MetricsTotalSurface, surface_sqrt, surface_sqrt);
+    Text("Build: %.2f ms rasterizing", font->MetricsBuildTime * 1000.0f); // (local)
     for (int config_i = 0; config_i < font->ConfigDataCount; config_i++)
         if (font->ConfigData)
             if (const ImFontConfig* cfg = &font->ConfigData[config_i])
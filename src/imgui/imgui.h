@@ -167,6 +167,7 @@ struct ImDrawListSplitter;          // Helper to split a draw list into differen
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
+struct ImFontAtlasDynamicCache;     // (local) Opaque storage of the glyphs rasterized on first use (see ImFontConfig::DynamicGlyphs)
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
@@ -182,6 +183,7 @@ struct ImGuiOnceUponAFrame;         // Helper for running a block of code not mo
 struct ImGuiPayload;                // User data payload for drag and drop operations
 struct ImGuiPlatformIO;             // Interface between platform/renderer backends and ImGui (e.g. Clipboard, IME hooks). Extends ImGuiIO. In docking branch, this gets extended to support multi-viewports.
 struct ImGuiPlatformImeData;        // Platform IME data for io.PlatformSetImeDataFn() function.
+struct ImGuiPlotPyramid;            // (local) Min/max pyramid over a large float series, for PlotLinesMinMax()
 struct ImGuiSelectionBasicStorage;  // Optional helper to store multi-selection state + apply multi-selection requests.
 struct ImGuiSelectionExternalStorage;//Optional helper to apply multi-selection requests to existing randomly accessible storage.
 struct ImGuiSelectionRequest;       // A selection request (stored in ImGuiMultiSelectIO)
@@ -707,6 +709,9 @@ namespace ImGui
     IMGUI_API void          PlotLines(const char* label, float(*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0));
     IMGUI_API void          PlotHistogram(const char* label, const float* values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), int stride = sizeof(float));
     IMGUI_API void          PlotHistogram(const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0));
+    // (local) Lines over millions of samples: each pixel column shows the min..max envelope of its samples, read from 'pyramid' (updated with the appended samples on each call) in O(width).
+    // Plots values[view_offset, view_offset + view_count), all remaining samples when view_count < 0. Plain lines when zoomed in to less than one sample per pixel.
+    IMGUI_API void          PlotLinesMinMax(const char* label, const float* values, int values_count, ImGuiPlotPyramid* pyramid, int view_offset = 0, int view_count = -1, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0));
 
     // Widgets: Value() Helpers.
     // - Those are merely shortcut to calling Text() with a format string. Output single value in "name: value" format (tip: freely declare more in your code to handle your types. you can add functions to the ImGui namespace)
@@ -942,6 +947,15 @@ namespace ImGui
     IMGUI_API ImDrawList*   GetBackgroundDrawList();                                            // this draw list will be the first rendered one. Useful to quickly draw shapes/text behind dear imgui contents.
     IMGUI_API ImDrawList*   GetForegroundDrawList();                                            // this draw list will be the last rendered one. Useful to quickly draw shapes/text over dear imgui contents.
 
+    // (local) Detached Draw Lists
+    // - Build heavy custom rendering on worker threads, then splice it into a window's draw list with ImDrawList::AppendDrawList(), in any order you like.
+    // - A detached list owns its ImDrawListSharedData (temp buffers, font and tessellation settings), so workers share no state with the context or each other.
+    // - Create/Reset/Append/Destroy happen on the UI thread. Between Reset and Append, one worker may call any ImDrawList function on the list (AddPolyline(), AddRectFilled(), AddText()...), but nothing from the ImGui:: namespace.
+    // - AddText() only with fonts fully rasterized by Build(): fonts with ImFontConfig::DynamicGlyphs update the shared atlas as they draw (asserts).
+    IMGUI_API ImDrawList*   CreateDetachedDrawList();
+    IMGUI_API void          DestroyDetachedDrawList(ImDrawList* draw_list);
+    IMGUI_API void          ResetDetachedDrawList(ImDrawList* draw_list, const ImDrawList* parent = NULL); // clear for a new frame, taking the current font and parent's clip rect, texture and flags (default: current window draw list).
+
     // Miscellaneous Utilities
     IMGUI_API bool          IsRectVisible(const ImVec2& size);                                  // test if rectangle (of given size, starting from cursor position) is visible / not clipped.
     IMGUI_API bool          IsRectVisible(const ImVec2& rect_min, const ImVec2& rect_max);      // test if rectangle (in screen space) is visible / not clipped. to perform coarse clipping on user's side.
@@ -2591,15 +2605,31 @@ struct ImGuiStoragePair
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
 // Types are NOT stored, so it is up to you to make sure your Key don't collide with different types.
+// (local) With IMGUI_STORAGE_USE_HASH_MAP defined, pairs stay in insertion order and an open-addressing index over them makes
+// queries and insertions O(1): meant for windows with thousands of tree nodes, where sorted insertion memmoves the whole array.
 struct ImGuiStorage
 {
     // [Internal]
     ImVector<ImGuiStoragePair>      Data;
+#ifdef IMGUI_STORAGE_USE_HASH_MAP
+    ImVector<ImGuiStoragePair>      _Index;         // Linear probing, power of two size. val_i = index in Data + 1, 0 when the slot is empty.
+    int                             _IndexedSize;   // Data.Size the index describes. Code pushing into Data directly only costs a rebuild.
+#endif
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
+#ifdef IMGUI_STORAGE_USE_HASH_MAP
+    ImGuiStorage()      { _IndexedSize = 0; }
+    void                Clear() { Data.clear(); _Index.clear(); _IndexedSize = 0; }
+    void                Swap(ImGuiStorage& rhs) { Data.swap(rhs.Data); _Index.swap(rhs._Index); int n = _IndexedSize; _IndexedSize = rhs._IndexedSize; rhs._IndexedSize = n; }
+    IMGUI_API ImGuiStoragePair* _Find(ImGuiID key) const;                   // NULL when missing
+    IMGUI_API ImGuiStoragePair* _FindOrInsert(ImGuiID key, bool* inserted); // New pairs are zeroed
+    IMGUI_API void      _RebuildIndex(int min_capacity);
+#else
     void                Clear() { Data.clear(); }
+    void                Swap(ImGuiStorage& rhs) { Data.swap(rhs.Data); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2628,6 +2658,23 @@ struct ImGuiStorage
 #endif
 };
 
+// (local) Helper: min/max pyramid over an append-only float series, as used by ImGui::PlotLinesMinMax().
+// - Level 0 holds the min/max of each block of 8 samples, every level above reduces 4 blocks of the one below.
+// - Update() only reduces samples appended since the previous call (plus the partial last blocks): values[0, Count) must not have changed, call Clear() otherwise.
+// - NaN samples are ignored. A block without any number holds (FLT_MAX, -FLT_MAX).
+#define IM_PLOT_PYRAMID_LEVELS      12      // Coarsest blocks: 8 * 4^11 samples
+struct ImGuiPlotPyramid
+{
+    ImVector<ImVec2>    Levels[IM_PLOT_PYRAMID_LEVELS]; // x = min, y = max of each block
+    int                 Count;                          // Samples reduced so far
+    ImVector<ImVec2>    _Columns;                       // [Internal] per-column envelope of the last plot
+
+    ImGuiPlotPyramid()  { Count = 0; }
+    IMGUI_API void      Clear();
+    IMGUI_API void      Update(const float* values, int count);
+    static int          GetBlockSize(int level)         { return 8 << (level * 2); }
+};
+
 // Helper: Manually clip large list of items.
 // If you have lots evenly spaced items and you have random access to the list, you can perform coarse
 // clipping based on visibility to only submit items that are in view.
@@ -3151,6 +3198,7 @@ struct ImDrawList
     // Advanced: Miscellaneous
     IMGUI_API void  AddDrawCmd();                                               // This is useful if you need to forcefully create a new draw call (to allow for dependent rendering / blending). Otherwise primitives are merged into the same draw-call as much as possible
     IMGUI_API ImDrawList* CloneOutput() const;                                  // Create a clone of the CmdBuffer/IdxBuffer/VtxBuffer.
+    IMGUI_API void  AppendDrawList(const ImDrawList* src);                      // (local) Append the output of 'src' at the current position, as if it had been drawn here. See ImGui::CreateDetachedDrawList().
 
     // Advanced: Channels
     // - Use to split render into layers. By switching channels to can render out-of-order (e.g. submit FG primitives before BG primitives)
@@ -3242,6 +3290,7 @@ struct ImFontConfig
     float           RasterizerMultiply;     // 1.0f     // Linearly brighten (>1.0f) or darken (<1.0f) font output. Brightening small fonts may be a good workaround to make them more readable. This is a silly thing we may remove in the future.
     float           RasterizerDensity;      // 1.0f     // DPI scale for rasterization, not altering other font metrics: make it easy to swap between e.g. a 100% and a 400% fonts for a zooming display. IMPORTANT: If you increase this it is expected that you increase font scale accordingly, otherwise quality may look lowered.
     ImWchar         EllipsisChar;           // -1       // Explicitly specify unicode codepoint of ellipsis character. When fonts are being merged first specified ellipsis will be used.
+    bool            DynamicGlyphs;          // false    // (local) Only measure glyphs in Build(), and rasterize each one the first time it is drawn (into a part of the atlas that grows and evicts least recently drawn glyphs). For large ranges (e.g. CJK). Requires stb_truetype, FontData and the CPU texture kept alive (don't call ClearInputData()/ClearTexData()). Text with such a font may only be drawn from the thread that owns the context, into its own draw lists (not detached ones, see CreateDetachedDrawList()).
 
     // [Internal]
     char            Name[40];               // Name (strictly to ease debugging)
@@ -3256,7 +3305,9 @@ struct ImFontGlyph
 {
     unsigned int    Colored : 1;        // Flag to indicate glyph is colored and should generally ignore tinting (make it usable with no shift on little-endian as this is used in loops)
     unsigned int    Visible : 1;        // Flag to indicate glyph has no visible pixels (e.g. space). Allow early out when rendering.
-    unsigned int    Codepoint : 30;     // 0x0000..0x10FFFF
+    unsigned int    Dynamic : 1;        // (local) Pixels are rasterized on first use (ImFontConfig::DynamicGlyphs): U0/V0/U1/V1 are only valid while Resident.
+    unsigned int    Resident : 1;       // (local) Dynamic glyph currently has pixels in the atlas.
+    unsigned int    Codepoint : 28;     // 0x0000..0x10FFFF
     float           AdvanceX;           // Distance to next character (= data from font + ImFontConfig::GlyphExtraSpacing.x baked in)
     float           X0, Y0, X1, Y1;     // Glyph corners
     float           U0, V0, U1, V1;     // Texture coordinates
@@ -3391,6 +3442,9 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // FIXME: Should be called "TexPackPadding". Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
+    const char*                 BuildCacheFilename; // (local) When set, Build() loads the atlas from this file if it holds the output of the same fonts, ranges and settings (mapped, no rasterizing), and otherwise rewrites it after the full build. stb_truetype builder only. Custom rectangles are cached as packed: fill their pixels after every Build().
+    bool                        BuildCacheLoaded;   // (local) Out: the last Build() came from BuildCacheFilename.
+    int                         BuildThreadCount;   // (local) Threads rasterizing glyphs in Build() with stb_truetype, the calling one included. 0 = one per hardware thread, 1 = only the calling thread. Ignored with IMGUI_DISABLE_FONT_BUILD_THREADS.
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
 
@@ -3408,6 +3462,8 @@ struct ImFontAtlas
     ImVector<ImFontAtlasCustomRect> CustomRects;    // Rectangles for packing custom texture data into the atlas.
     ImVector<ImFontConfig>      ConfigData;         // Configuration data
     ImVec4                      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];  // UVs for baked anti-aliased lines
+    int                         TexUpdateX0, TexUpdateY0, TexUpdateX1, TexUpdateY1; // (local) Pixels changed since the backend last uploaded the texture (glyphs rasterized on demand), empty when X0 >= X1. The texture may also have grown taller: backends re-upload it whole when TexHeight changed, then reset this to empty.
+    ImFontAtlasDynamicCache*    DynamicCache;       // (local) Glyphs rasterized on demand, NULL when no font uses ImFontConfig::DynamicGlyphs
 
     // [Internal] Font builder
     const ImFontBuilderIO*      FontBuilderIO;      // Opaque interface to a font builder (default to stb_truetype, can be changed to use FreeType by defining IMGUI_ENABLE_FREETYPE).
@@ -3450,6 +3506,7 @@ struct ImFont
     float                       Scale;              // 4     // in  // = 1.f      // Base font scale, multiplied by the per-window font scale which you can adjust with SetWindowFontScale()
     float                       Ascent, Descent;    // 4+4   // out //            // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize] (unscaled)
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
+    float                       MetricsBuildTime;   // 4     // out //            // (local) Seconds spent rasterizing this font's glyphs in the last Build(), summed over the worker threads (see ImFontAtlas::BuildThreadCount)
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
 
     // Methods
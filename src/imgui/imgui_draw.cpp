@@ -39,6 +39,17 @@ Index of this file:
 #endif
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
+#include <chrono>       // (local) Font build timings (ImFont::MetricsBuildTime)
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+#include <atomic>       // (local) Glyphs rasterized in parallel in ImFontAtlas::Build()
+#include <thread>
+#endif
+#if !defined(IMGUI_DISABLE_FILE_FUNCTIONS) && !defined(_WIN32)
+#include <fcntl.h>      // (local) open(), mmap() of the font atlas cache (ImFontAtlas::BuildCacheFilename)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -599,6 +610,77 @@ void ImDrawList::_OnChangedVtxOffset()
     curr_cmd->VtxOffset = _CmdHeader.VtxOffset;
 }
 
+// (local) Splice the output of another list, typically a detached one filled on a worker thread (see ImGui::CreateDetachedDrawList()).
+// Indices are rebased when the result still fits ImDrawIdx, so commands with the same clip rect and texture merge with the current one.
+// Otherwise the new commands get their own VtxOffset, which needs ImGuiBackendFlags_RendererHasVtxOffset with 16-bit indices.
+void ImDrawList::AppendDrawList(const ImDrawList* src)
+{
+    IM_ASSERT(src != this && src->_Splitter._Count <= 1);
+    if (src->VtxBuffer.Size == 0 && src->CmdBuffer.Size <= 1 && (src->CmdBuffer.Size == 0 || src->CmdBuffer[0].UserCallback == NULL))
+        return;
+
+    const int vtx_base = VtxBuffer.Size;
+    const int idx_base = IdxBuffer.Size;
+    const bool rebase = src->_CmdHeader.VtxOffset == 0 && (sizeof(ImDrawIdx) == 4 || _VtxCurrentIdx + (unsigned int)src->VtxBuffer.Size < (1u << 16));
+    IM_ASSERT((rebase || (Flags & ImDrawListFlags_AllowVtxOffset)) && "Too many vertices in ImDrawList using 16-bit indices. Read comment above");
+
+    VtxBuffer.resize(vtx_base + src->VtxBuffer.Size);
+    memcpy(VtxBuffer.Data + vtx_base, src->VtxBuffer.Data, (size_t)src->VtxBuffer.size_in_bytes());
+    IdxBuffer.resize(idx_base + src->IdxBuffer.Size);
+    ImDrawIdx* idx_write = IdxBuffer.Data + idx_base;
+    if (rebase && _VtxCurrentIdx != 0)
+    {
+        const ImDrawIdx* idx_read = src->IdxBuffer.Data;
+        for (int n = 0; n < src->IdxBuffer.Size; n++)
+            idx_write[n] = (ImDrawIdx)(idx_read[n] + _VtxCurrentIdx);
+    }
+    else if (src->IdxBuffer.Size > 0)
+    {
+        memcpy(idx_write, src->IdxBuffer.Data, (size_t)src->IdxBuffer.size_in_bytes());
+    }
+
+    // The current command takes the first new one if nothing was drawn into it yet
+    if (CmdBuffer.Size > 0 && CmdBuffer.back().ElemCount == 0 && CmdBuffer.back().UserCallback == NULL)
+        CmdBuffer.pop_back();
+    for (int cmd_n = 0; cmd_n < src->CmdBuffer.Size; cmd_n++)
+    {
+        ImDrawCmd cmd = src->CmdBuffer.Data[cmd_n];
+        if (cmd.ElemCount == 0 && cmd.UserCallback == NULL)
+            continue;
+        cmd.IdxOffset += idx_base;
+        cmd.VtxOffset = rebase ? _CmdHeader.VtxOffset : cmd.VtxOffset + vtx_base;
+        if (cmd.UserCallback != NULL && cmd.UserCallbackDataSize > 0)
+        {
+            cmd.UserCallbackDataOffset = _CallbacksDataBuf.Size;
+            _CallbacksDataBuf.resize(_CallbacksDataBuf.Size + cmd.UserCallbackDataSize);
+            memcpy(_CallbacksDataBuf.Data + cmd.UserCallbackDataOffset, src->_CallbacksDataBuf.Data + src->CmdBuffer.Data[cmd_n].UserCallbackDataOffset, (size_t)cmd.UserCallbackDataSize);
+        }
+        ImDrawCmd* prev_cmd = CmdBuffer.Size > 0 ? &CmdBuffer.back() : NULL;
+        if (prev_cmd != NULL && cmd.UserCallback == NULL && prev_cmd->UserCallback == NULL && ImDrawCmd_HeaderCompare(prev_cmd, &cmd) == 0 && prev_cmd->IdxOffset + prev_cmd->ElemCount == cmd.IdxOffset)
+            prev_cmd->ElemCount += cmd.ElemCount;
+        else
+            CmdBuffer.push_back(cmd);
+    }
+
+    // Our own primitives continue after the new vertices, from a fresh VtxOffset if the indices weren't rebased
+    if (rebase)
+    {
+        _VtxCurrentIdx += (unsigned int)src->VtxBuffer.Size;
+    }
+    else
+    {
+        _CmdHeader.VtxOffset = VtxBuffer.Size;
+        _VtxCurrentIdx = 0;
+    }
+    _VtxWritePtr = VtxBuffer.Data + VtxBuffer.Size;
+    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
+
+    // Resume drawing in a command matching our own state
+    ImDrawCmd* curr_cmd = CmdBuffer.Size > 0 ? &CmdBuffer.back() : NULL;
+    if (curr_cmd == NULL || curr_cmd->UserCallback != NULL || ImDrawCmd_HeaderCompare(curr_cmd, &_CmdHeader) != 0)
+        AddDrawCmd();
+}
+
 int ImDrawList::_CalcCircleAutoSegmentCount(float radius) const
 {
     // Automatic segment count
@@ -755,6 +837,188 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// (local) SSE2 versions of the normal/offset loops in AddPolyline() and the AA fills, 4 points per iteration.
+// They do the same float operations in the same order as the macros above (rsqrtps is the packed rsqrtss used by ImRsqrt(),
+// and divisions are exact), so the output is bit-identical and the scalar loops just pick up where they stop.
+// Vertex and index emission stays scalar: it is plain stores, and the first/last points need the wrap-around handling anyway.
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define IM_DRAWLIST_SIMD_SSE2
+#endif
+
+static bool GImDrawListSimd = true;
+
+bool ImDrawListSetSimdEnabled(bool enabled)
+{
+#ifdef IM_DRAWLIST_SIMD_SSE2
+    GImDrawListSimd = enabled;
+    return true;
+#else
+    GImDrawListSimd = false;
+    return !enabled;
+#endif
+}
+
+#ifdef IM_DRAWLIST_SIMD_SSE2
+// Loads v[0..3] as four x and four y
+static inline void ImSimdLoadVec2x4(const ImVec2* v, __m128& x, __m128& y)
+{
+    const __m128 lo = _mm_loadu_ps(&v[0].x);
+    const __m128 hi = _mm_loadu_ps(&v[2].x);
+    x = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+    y = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+static inline void ImSimdStoreVec2x4(ImVec2* v, __m128 x, __m128 y)
+{
+    _mm_storeu_ps(&v[0].x, _mm_unpacklo_ps(x, y));
+    _mm_storeu_ps(&v[2].x, _mm_unpackhi_ps(x, y));
+}
+
+static inline __m128 ImSimdSelect(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// normals[i] = normal of segment points[i] -> points[i + 1] (IM_NORMALIZE2F_OVER_ZERO, then (dy, -dx)), for i < n. Returns how many were done.
+static int ImSimdSegmentNormals(const ImVec2* points, int n, ImVec2* normals)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 x0, y0, x1, y1;
+        ImSimdLoadVec2x4(points + i, x0, y0);
+        ImSimdLoadVec2x4(points + i + 1, x1, y1);
+        __m128 dx = _mm_sub_ps(x1, x0);
+        __m128 dy = _mm_sub_ps(y1, y0);
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        const __m128 over_zero = _mm_cmpgt_ps(d2, zero);
+        const __m128 inv_len = _mm_rsqrt_ps(d2);
+        dx = ImSimdSelect(over_zero, _mm_mul_ps(dx, inv_len), dx);
+        dy = ImSimdSelect(over_zero, _mm_mul_ps(dy, inv_len), dy);
+        ImSimdStoreVec2x4(normals + i, dy, _mm_xor_ps(dx, sign));
+    }
+    return i;
+}
+
+// Average of normals[i] and normals[i + 1] through IM_FIXNORMAL2F, for 4 consecutive i
+static inline void ImSimdAverageNormals4(const ImVec2* normals, __m128& dm_x, __m128& dm_y)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128 x0, y0, x1, y1;
+    ImSimdLoadVec2x4(normals, x0, y0);
+    ImSimdLoadVec2x4(normals + 1, x1, y1);
+    dm_x = _mm_mul_ps(_mm_add_ps(x0, x1), half);
+    dm_y = _mm_mul_ps(_mm_add_ps(y0, y1), half);
+    const __m128 d2 = _mm_add_ps(_mm_mul_ps(dm_x, dm_x), _mm_mul_ps(dm_y, dm_y));
+    const __m128 fix = _mm_cmpgt_ps(d2, _mm_set1_ps(0.000001f));
+    const __m128 inv_len2 = _mm_min_ps(_mm_div_ps(_mm_set1_ps(1.0f), d2), _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2));
+    dm_x = ImSimdSelect(fix, _mm_mul_ps(dm_x, inv_len2), dm_x);
+    dm_y = ImSimdSelect(fix, _mm_mul_ps(dm_y, inv_len2), dm_y);
+}
+
+// AddPolyline() [PATH 1]/[PATH 2] edges: temp_points[i2 * 2 + 0/1] = points[i2] +/- averaged normal * half_draw_size, i2 = i1 + 1 for i1 < n
+static int ImSimdPolylineEdges2(const ImVec2* points, const ImVec2* normals, int n, float half_draw_size, ImVec2* temp_points)
+{
+    const __m128 scale = _mm_set1_ps(half_draw_size);
+    int i1 = 0;
+    for (; i1 + 4 <= n; i1 += 4)
+    {
+        __m128 dm_x, dm_y, p_x, p_y;
+        ImSimdAverageNormals4(normals + i1, dm_x, dm_y);
+        dm_x = _mm_mul_ps(dm_x, scale);
+        dm_y = _mm_mul_ps(dm_y, scale);
+        ImSimdLoadVec2x4(points + i1 + 1, p_x, p_y);
+        const __m128 out_x = _mm_add_ps(p_x, dm_x), out_y = _mm_add_ps(p_y, dm_y);
+        const __m128 in_x = _mm_sub_ps(p_x, dm_x), in_y = _mm_sub_ps(p_y, dm_y);
+        const __m128 out_l = _mm_unpacklo_ps(out_x, out_y), out_h = _mm_unpackhi_ps(out_x, out_y);
+        const __m128 in_l = _mm_unpacklo_ps(in_x, in_y), in_h = _mm_unpackhi_ps(in_x, in_y);
+        float* out = &temp_points[(i1 + 1) * 2].x;
+        _mm_storeu_ps(out + 0, _mm_movelh_ps(out_l, in_l));
+        _mm_storeu_ps(out + 4, _mm_movehl_ps(in_l, out_l));
+        _mm_storeu_ps(out + 8, _mm_movelh_ps(out_h, in_h));
+        _mm_storeu_ps(out + 12, _mm_movehl_ps(in_h, out_h));
+    }
+    return i1;
+}
+
+// AddPolyline() [PATH 3] edges: outer, inner, -inner, -outer offsets for each i2 = i1 + 1, i1 < n
+static int ImSimdPolylineEdges4(const ImVec2* points, const ImVec2* normals, int n, float half_inner_thickness, float aa_size, ImVec2* temp_points)
+{
+    const __m128 scale_out = _mm_set1_ps(half_inner_thickness + aa_size);
+    const __m128 scale_in = _mm_set1_ps(half_inner_thickness);
+    int i1 = 0;
+    for (; i1 + 4 <= n; i1 += 4)
+    {
+        __m128 dm_x, dm_y, p_x, p_y;
+        ImSimdAverageNormals4(normals + i1, dm_x, dm_y);
+        const __m128 out_x = _mm_mul_ps(dm_x, scale_out), out_y = _mm_mul_ps(dm_y, scale_out);
+        const __m128 in_x = _mm_mul_ps(dm_x, scale_in), in_y = _mm_mul_ps(dm_y, scale_in);
+        ImSimdLoadVec2x4(points + i1 + 1, p_x, p_y);
+        const __m128 v0x = _mm_add_ps(p_x, out_x), v0y = _mm_add_ps(p_y, out_y);
+        const __m128 v1x = _mm_add_ps(p_x, in_x), v1y = _mm_add_ps(p_y, in_y);
+        const __m128 v2x = _mm_sub_ps(p_x, in_x), v2y = _mm_sub_ps(p_y, in_y);
+        const __m128 v3x = _mm_sub_ps(p_x, out_x), v3y = _mm_sub_ps(p_y, out_y);
+        float* out = &temp_points[(i1 + 1) * 4].x;
+        __m128 a = _mm_unpacklo_ps(v0x, v0y), b = _mm_unpacklo_ps(v1x, v1y), c = _mm_unpacklo_ps(v2x, v2y), d = _mm_unpacklo_ps(v3x, v3y);
+        _mm_storeu_ps(out + 0, _mm_movelh_ps(a, b));
+        _mm_storeu_ps(out + 4, _mm_movelh_ps(c, d));
+        _mm_storeu_ps(out + 8, _mm_movehl_ps(b, a));
+        _mm_storeu_ps(out + 12, _mm_movehl_ps(d, c));
+        a = _mm_unpackhi_ps(v0x, v0y); b = _mm_unpackhi_ps(v1x, v1y); c = _mm_unpackhi_ps(v2x, v2y); d = _mm_unpackhi_ps(v3x, v3y);
+        _mm_storeu_ps(out + 16, _mm_movelh_ps(a, b));
+        _mm_storeu_ps(out + 20, _mm_movelh_ps(c, d));
+        _mm_storeu_ps(out + 24, _mm_movehl_ps(b, a));
+        _mm_storeu_ps(out + 28, _mm_movehl_ps(d, c));
+    }
+    return i1;
+}
+
+// AA fill fringe offsets: offsets[i1] = average of normals[i1 - 1] and normals[i1] * aa_size * 0.5f, for 1 <= i1 <= n
+static int ImSimdFillFringeOffsets(const ImVec2* normals, int n, float aa_size, ImVec2* offsets)
+{
+    const __m128 scale = _mm_set1_ps(aa_size * 0.5f);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 dm_x, dm_y;
+        ImSimdAverageNormals4(normals + i, dm_x, dm_y);
+        ImSimdStoreVec2x4(offsets + i + 1, _mm_mul_ps(dm_x, scale), _mm_mul_ps(dm_y, scale));
+    }
+    return i;
+}
+
+// AA fill vertices and fringe indices for points [first, last], from offsets[] above. Works on local pointers so that the
+// stores don't force _VtxWritePtr/_IdxWritePtr to be reloaded, and computes 2 points' inner/outer positions per instruction.
+static void ImSimdFillEmit(const ImVec2* points, const ImVec2* offsets, int first, int last, ImVec2 uv, ImU32 col, ImU32 col_trans, unsigned int vtx_inner_idx, ImDrawVert*& vtx_write, ImDrawIdx*& idx_write)
+{
+    ImDrawVert* vtx = vtx_write;
+    ImDrawIdx* idx = idx_write;
+    for (int i1 = first; i1 <= last; i1 += 2)
+    {
+        const bool pair = i1 + 1 <= last;
+        const __m128 p = pair ? _mm_loadu_ps(&points[i1].x) : _mm_castpd_ps(_mm_load_sd((const double*)&points[i1]));
+        const __m128 dm = pair ? _mm_loadu_ps(&offsets[i1].x) : _mm_castpd_ps(_mm_load_sd((const double*)&offsets[i1]));
+        const __m128 inner = _mm_sub_ps(p, dm);
+        const __m128 outer = _mm_add_ps(p, dm);
+        for (int k = 0; k < (pair ? 2 : 1); k++)
+        {
+            const int i = i1 + k;
+            _mm_storel_pi((__m64*)&vtx[0].pos, k ? _mm_movehl_ps(inner, inner) : inner); vtx[0].uv = uv; vtx[0].col = col;        // Inner
+            _mm_storel_pi((__m64*)&vtx[1].pos, k ? _mm_movehl_ps(outer, outer) : outer); vtx[1].uv = uv; vtx[1].col = col_trans;  // Outer
+            vtx += 2;
+            const ImDrawIdx inner1 = (ImDrawIdx)(vtx_inner_idx + (i << 1)), inner0 = (ImDrawIdx)(inner1 - 2);
+            idx[0] = inner1; idx[1] = inner0; idx[2] = (ImDrawIdx)(inner0 + 1);
+            idx[3] = (ImDrawIdx)(inner0 + 1); idx[4] = (ImDrawIdx)(inner1 + 1); idx[5] = inner1;
+            idx += 6;
+        }
+    }
+    vtx_write = vtx;
+    idx_write = idx;
+}
+#endif // #ifdef IM_DRAWLIST_SIMD_SSE2
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -797,7 +1061,12 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
+        int simd_done = 0;
+#ifdef IM_DRAWLIST_SIMD_SSE2
+        if (GImDrawListSimd)
+            simd_done = ImSimdSegmentNormals(points, points_count - 1, temp_normals); // All but the closing segment
+#endif
+        for (int i1 = simd_done; i1 < count; i1++)
         {
             const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
             float dx = points[i2].x - points[i1].x;
@@ -834,25 +1103,33 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
             // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            simd_done = 0;
+#ifdef IM_DRAWLIST_SIMD_SSE2
+            if (GImDrawListSimd)
+                simd_done = ImSimdPolylineEdges2(points, temp_normals, points_count - 1, half_draw_size, temp_points); // The wrap-around to point 0 stays scalar
+#endif
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
                 const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
-
-                // Add temporary vertexes for the outer edges
-                ImVec2* out_vtx = &temp_points[i2 * 2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
+                if (i1 >= simd_done)
+                {
+                    // Average normals
+                    float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
+                    float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
+                    IM_FIXNORMAL2F(dm_x, dm_y);
+                    dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
+                    dm_y *= half_draw_size;
+
+                    // Add temporary vertexes for the outer edges
+                    ImVec2* out_vtx = &temp_points[i2 * 2];
+                    out_vtx[0].x = points[i2].x + dm_x;
+                    out_vtx[0].y = points[i2].y + dm_y;
+                    out_vtx[1].x = points[i2].x - dm_x;
+                    out_vtx[1].y = points[i2].y - dm_y;
+                }
 
                 if (use_texture)
                 {
@@ -930,31 +1207,39 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
             // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            simd_done = 0;
+#ifdef IM_DRAWLIST_SIMD_SSE2
+            if (GImDrawListSimd)
+                simd_done = ImSimdPolylineEdges4(points, temp_normals, points_count - 1, half_inner_thickness, AA_SIZE, temp_points);
+#endif
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
                 const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertices
-                ImVec2* out_vtx = &temp_points[i2 * 4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
+                if (i1 >= simd_done)
+                {
+                    // Average normals
+                    float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
+                    float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
+                    IM_FIXNORMAL2F(dm_x, dm_y);
+                    float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
+                    float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
+                    float dm_in_x = dm_x * half_inner_thickness;
+                    float dm_in_y = dm_y * half_inner_thickness;
+
+                    // Add temporary vertices
+                    ImVec2* out_vtx = &temp_points[i2 * 4];
+                    out_vtx[0].x = points[i2].x + dm_out_x;
+                    out_vtx[0].y = points[i2].y + dm_out_y;
+                    out_vtx[1].x = points[i2].x + dm_in_x;
+                    out_vtx[1].y = points[i2].y + dm_in_y;
+                    out_vtx[2].x = points[i2].x - dm_in_x;
+                    out_vtx[2].y = points[i2].y - dm_in_y;
+                    out_vtx[3].x = points[i2].x - dm_out_x;
+                    out_vtx[3].y = points[i2].y - dm_out_y;
+                }
 
                 // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
@@ -1041,10 +1326,25 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         }
 
         // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
+        // (local) With SIMD the fringe offsets of points 1..N-1 are precomputed in the second half of TempBuffer
+#ifdef IM_DRAWLIST_SIMD_SSE2
+        const bool use_simd = GImDrawListSimd;
+#else
+        const bool use_simd = false;
+#endif
+        int simd_normals = 0, simd_offsets = 0;
+        _Data->TempBuffer.reserve_discard(use_simd ? points_count * 2 : points_count);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
+        ImVec2* temp_offsets = temp_normals + points_count;
+        IM_UNUSED(temp_offsets);
+#ifdef IM_DRAWLIST_SIMD_SSE2
+        if (use_simd)
+            simd_normals = ImSimdSegmentNormals(points, points_count - 1, temp_normals);
+#endif
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
+            if (i1 != 0 && i0 < simd_normals)
+                continue;
             const ImVec2& p0 = points[i0];
             const ImVec2& p1 = points[i1];
             float dx = p1.x - p0.x;
@@ -1054,8 +1354,20 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             temp_normals[i0].y = -dx;
         }
 
+#ifdef IM_DRAWLIST_SIMD_SSE2
+        if (use_simd)
+            simd_offsets = ImSimdFillFringeOffsets(temp_normals, points_count - 1, AA_SIZE, temp_offsets);
+#endif
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
+#ifdef IM_DRAWLIST_SIMD_SSE2
+            if (i1 == 1 && simd_offsets > 0)
+            {
+                ImSimdFillEmit(points, temp_offsets, 1, simd_offsets, uv, col, col_trans, vtx_inner_idx, _VtxWritePtr, _IdxWritePtr);
+                i1 = simd_offsets;
+                continue;
+            }
+#endif
             // Average normals
             const ImVec2& n0 = temp_normals[i0];
             const ImVec2& n1 = temp_normals[i1];
@@ -2003,10 +2315,25 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
         }
 
         // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
+        // (local) With SIMD the fringe offsets of points 1..N-1 are precomputed in the second half of TempBuffer
+#ifdef IM_DRAWLIST_SIMD_SSE2
+        const bool use_simd = GImDrawListSimd;
+#else
+        const bool use_simd = false;
+#endif
+        int simd_normals = 0, simd_offsets = 0;
+        _Data->TempBuffer.reserve_discard(use_simd ? points_count * 2 : points_count);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
+        ImVec2* temp_offsets = temp_normals + points_count;
+        IM_UNUSED(temp_offsets);
+#ifdef IM_DRAWLIST_SIMD_SSE2
+        if (use_simd)
+            simd_normals = ImSimdSegmentNormals(points, points_count - 1, temp_normals);
+#endif
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
+            if (i1 != 0 && i0 < simd_normals)
+                continue;
             const ImVec2& p0 = points[i0];
             const ImVec2& p1 = points[i1];
             float dx = p1.x - p0.x;
@@ -2016,8 +2343,20 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
             temp_normals[i0].y = -dx;
         }
 
+#ifdef IM_DRAWLIST_SIMD_SSE2
+        if (use_simd)
+            simd_offsets = ImSimdFillFringeOffsets(temp_normals, points_count - 1, AA_SIZE, temp_offsets);
+#endif
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
+#ifdef IM_DRAWLIST_SIMD_SSE2
+            if (i1 == 1 && simd_offsets > 0)
+            {
+                ImSimdFillEmit(points, temp_offsets, 1, simd_offsets, uv, col, col_trans, vtx_inner_idx, _VtxWritePtr, _IdxWritePtr);
+                i1 = simd_offsets;
+                continue;
+            }
+#endif
             // Average normals
             const ImVec2& n0 = temp_normals[i0];
             const ImVec2& n1 = temp_normals[i1];
@@ -2434,6 +2773,13 @@ static const ImVec2 FONT_ATLAS_DEFAULT_TEX_CURSOR_DATA[ImGuiMouseCursor_COUNT][3
     { ImVec2(109,0),ImVec2(13,15), ImVec2( 6, 7) }, // ImGuiMouseCursor_NotAllowed
 };
 
+static void ImFontAtlasDynamicDestroy(ImFontAtlas* atlas); // (local)
+#if defined(IMGUI_ENABLE_STB_TRUETYPE) && !defined(IMGUI_DISABLE_FILE_FUNCTIONS)
+static ImU32 ImFontAtlasCacheKey(ImFontAtlas* atlas); // (local)
+static bool ImFontAtlasCacheLoad(ImFontAtlas* atlas, ImU32 key);
+static void ImFontAtlasCacheSave(ImFontAtlas* atlas, ImU32 key);
+#endif
+
 ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
@@ -2467,6 +2813,7 @@ void    ImFontAtlas::ClearInputData()
     ConfigData.clear();
     CustomRects.clear();
     PackIdMouseCursors = PackIdLines = -1;
+    ImFontAtlasDynamicDestroy(this); // (local) Can't rasterize without the font data
     // Important: we leave TexReady untouched
 }
 
@@ -2480,12 +2827,14 @@ void    ImFontAtlas::ClearTexData()
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
     TexPixelsUseColors = false;
+    ImFontAtlasDynamicDestroy(this); // (local) Can't rasterize without the pixels
     // Important: we leave TexReady untouched
 }
 
 void    ImFontAtlas::ClearFonts()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasDynamicDestroy(this); // (local) References the fonts
     Fonts.clear_delete();
     TexReady = false;
 }
@@ -2743,6 +3092,7 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 
 bool    ImFontAtlas::Build()
 {
+    IMGUI_PROFILE_SCOPE("ImFontAtlas::Build");
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
 
     // Default font is none are specified
@@ -2766,8 +3116,27 @@ bool    ImFontAtlas::Build()
 #endif
     }
 
+    // (local) Reuse the output of an identical earlier build, see BuildCacheFilename
+    BuildCacheLoaded = false;
+#if defined(IMGUI_ENABLE_STB_TRUETYPE) && !defined(IMGUI_DISABLE_FILE_FUNCTIONS)
+    const bool use_cache = BuildCacheFilename != NULL && builder_io->FontBuilder_Build == ImFontAtlasGetBuilderForStbTruetype()->FontBuilder_Build;
+    ImU32 cache_key = 0;
+    if (use_cache)
+    {
+        ImFontAtlasBuildInit(this); // The custom rectangles it adds are part of the key
+        cache_key = ImFontAtlasCacheKey(this);
+        if (ImFontAtlasCacheLoad(this, cache_key))
+            return BuildCacheLoaded = true;
+    }
+    if (!builder_io->FontBuilder_Build(this))
+        return false;
+    if (use_cache)
+        ImFontAtlasCacheSave(this, cache_key);
+    return true;
+#else
     // Build
     return builder_io->FontBuilder_Build(this);
+#endif
 }
 
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
@@ -2801,6 +3170,7 @@ struct ImFontBuildSrcData
     int                 DstIndex;           // Index into atlas->Fonts[] and dst_tmp_array[]
     int                 GlyphsHighest;      // Highest requested codepoint
     int                 GlyphsCount;        // Glyph count (excluding missing glyphs and glyphs already set by an earlier source font)
+    bool                Dynamic;            // (local) ImFontConfig::DynamicGlyphs: measured only, not packed nor rendered
     ImBitVector         GlyphsSet;          // Glyph bit map (random access, 1-bit per codepoint. This will be a maximum of 8KB)
     ImVector<int>       GlyphsList;         // Glyph codepoints list (flattened version of GlyphsSet)
 };
@@ -2826,6 +3196,204 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+// (local) Glyphs rasterized on first use (ImFontConfig::DynamicGlyphs), see ImFontAtlasDynamicUseGlyph()
+// They are packed in shelves (rows of glyphs with similar heights) below the prebuilt glyphs. A shelf is also the unit of
+// eviction: drawing a glyph stamps its shelf, and the least recently drawn shelf is emptied when there's no room left.
+struct ImFontDynamicSource
+{
+    stbtt_fontinfo      FontInfo;
+    int                 ConfigIndex;        // Into atlas->ConfigData[]
+};
+
+struct ImFontDynamicShelf
+{
+    int                 Y, Height;
+    int                 X;                  // Next free column
+    int                 LastUsedFrame;
+};
+
+struct ImFontDynamicEntry
+{
+    ImFont*             Font;
+    int                 GlyphIndex;         // Into Font->Glyphs[]
+    int                 Shelf;
+};
+
+struct ImFontAtlasDynamicCache
+{
+    ImVector<ImFontDynamicSource>   Sources;        // Configs with DynamicGlyphs, in ConfigData[] order
+    ImVector<ImFontDynamicShelf>    Shelves;
+    ImVector<ImFontDynamicEntry>    Entries;        // Resident glyphs
+    ImVector<ImS16>                 RowShelf;       // Shelf covering each texture row, -1 for none
+    int                             RegionY;        // First row below the prebuilt glyphs
+    int                             NextShelfY;
+    int                             FrameCount;
+    bool                            GrowPending;
+    ImFontAtlasDynamicStats         Stats;
+
+    ImFontAtlasDynamicCache()       { RegionY = NextShelfY = FrameCount = 0; GrowPending = false; memset(&Stats, 0, sizeof(Stats)); }
+};
+
+// (local) Metrics of a glyph as stbtt_PackFontRangesRenderIntoRects() outputs them, without rasterizing it (atlas position left at 0)
+static void ImFontAtlasBuildMeasureGlyph(const stbtt_fontinfo* info, const ImFontConfig& cfg, int codepoint, stbtt_packedchar* out)
+{
+    const float scale = (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(info, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(info, -cfg.SizePixels * cfg.RasterizerDensity);
+    const int glyph_index_in_font = stbtt_FindGlyphIndex(info, codepoint);
+    int advance, lsb, x0, y0, x1, y1;
+    stbtt_GetGlyphHMetrics(info, glyph_index_in_font, &advance, &lsb);
+    stbtt_GetGlyphBitmapBox(info, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, &x0, &y0, &x1, &y1);
+    const int w = x1 - x0 + cfg.OversampleH - 1;
+    const int h = y1 - y0 + cfg.OversampleV - 1;
+    const float recip_h = 1.0f / cfg.OversampleH;
+    const float recip_v = 1.0f / cfg.OversampleV;
+    const float sub_x = (float)-(cfg.OversampleH - 1) / (2.0f * (float)cfg.OversampleH); // stbtt__oversample_shift()
+    const float sub_y = (float)-(cfg.OversampleV - 1) / (2.0f * (float)cfg.OversampleV);
+    memset(out, 0, sizeof(*out));
+    out->xadvance = scale * advance;
+    out->xoff = (float)x0 * recip_h + sub_x;
+    out->yoff = (float)y0 * recip_v + sub_y;
+    out->xoff2 = (x0 + w) * recip_h + sub_x;
+    out->yoff2 = (y0 + h) * recip_v + sub_y;
+}
+
+// (local) Parse the font of every config with DynamicGlyphs. Returns false if one of them can't be read, without touching the atlas.
+static bool ImFontAtlasDynamicInitSources(const ImFontAtlas* atlas, ImVector<ImFontDynamicSource>* out_sources)
+{
+    out_sources->resize(0);
+    for (int cfg_i = 0; cfg_i < atlas->ConfigData.Size; cfg_i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[cfg_i];
+        if (!cfg.DynamicGlyphs)
+            continue;
+        ImFontDynamicSource source;
+        source.ConfigIndex = cfg_i;
+        const int font_offset = stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo);
+        if (font_offset < 0 || !stbtt_InitFont(&source.FontInfo, (unsigned char*)cfg.FontData, font_offset))
+            return false;
+        out_sources->push_back(source);
+    }
+    return true;
+}
+
+// (local) Set up rasterizing glyphs on demand for the fonts with DynamicGlyphs, from row 'region_y' of the texture down.
+// Takes 'sources' from ImFontAtlasDynamicInitSources().
+static void ImFontAtlasDynamicCreate(ImFontAtlas* atlas, int region_y, ImVector<ImFontDynamicSource>* sources)
+{
+    ImFontAtlasDynamicCache* cache = atlas->DynamicCache = IM_NEW(ImFontAtlasDynamicCache)();
+    cache->Sources.swap(*sources);
+    cache->RegionY = cache->NextShelfY = region_y;
+    cache->RowShelf.resize(atlas->TexHeight, -1);
+}
+
+// (local) Glyphs of one source rendered by one worker, see ImFontAtlasBuildRenderGlyphs()
+struct ImFontBuildRenderJob
+{
+    int                 SrcIndex;
+    int                 GlyphStart, GlyphCount;
+    double              Seconds;
+};
+
+struct ImFontBuildRenderContext
+{
+    ImFontAtlas*                    Atlas;
+    ImVector<ImFontBuildSrcData>*   Sources;
+    const stbtt_pack_context*       PackContext;
+    ImVector<ImFontBuildRenderJob>  Jobs;
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+    std::atomic<int>                NextJob;
+#else
+    int                             NextJob;
+#endif
+};
+
+// No IMGUI_PROFILE_SCOPE() in here: workers are short-lived threads, and the profiler keeps a ring per thread forever.
+static void ImFontAtlasBuildRenderWorker(ImFontBuildRenderContext* ctx)
+{
+    ImFontAtlas* atlas = ctx->Atlas;
+    for (int job_n = ctx->NextJob++; job_n < ctx->Jobs.Size; job_n = ctx->NextJob++)
+    {
+        ImFontBuildRenderJob& job = ctx->Jobs[job_n];
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const ImFontConfig& cfg = atlas->ConfigData[job.SrcIndex];
+        ImFontBuildSrcData& src_tmp = (*ctx->Sources)[job.SrcIndex];
+
+        // Own copies: stbtt_PackFontRangesRenderIntoRects() writes its oversampling settings into the context.
+        // The rectangles were packed apart, so workers never write to the same pixels.
+        stbtt_pack_context spc = *ctx->PackContext;
+        stbtt_pack_range range = src_tmp.PackRange;
+        range.array_of_unicode_codepoints = src_tmp.GlyphsList.Data + job.GlyphStart;
+        range.chardata_for_range = src_tmp.PackedChars + job.GlyphStart;
+        range.num_chars = job.GlyphCount;
+        stbrp_rect* rects = src_tmp.Rects + job.GlyphStart;
+        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &range, 1, rects);
+
+        // Apply multiply operator
+        if (cfg.RasterizerMultiply != 1.0f)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+            stbrp_rect* r = rects;
+            for (int glyph_i = 0; glyph_i < job.GlyphCount; glyph_i++, r++)
+                if (r->was_packed)
+                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+        }
+        job.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+// (local) Rasterize every packed glyph, on ImFontAtlas::BuildThreadCount threads. Returns the time spent on each source.
+static void ImFontAtlasBuildRenderGlyphs(ImFontAtlas* atlas, ImVector<ImFontBuildSrcData>& src_tmp_array, const stbtt_pack_context* spc, ImVector<double>* out_src_seconds)
+{
+    IMGUI_PROFILE_SCOPE("ImFontAtlas rasterize");
+    int thread_count = 1;
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+    thread_count = (atlas->BuildThreadCount > 0) ? atlas->BuildThreadCount : (int)std::thread::hardware_concurrency();
+    thread_count = ImClamp(thread_count, 1, 64);
+#endif
+
+    // Slices of a few glyphs, so that a large source (e.g. CJK ranges) doesn't end up on a single worker
+    ImFontBuildRenderContext ctx;
+    ctx.Atlas = atlas;
+    ctx.Sources = &src_tmp_array;
+    ctx.PackContext = spc;
+    ctx.NextJob = 0;
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+    {
+        const ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+        if (src_tmp.GlyphsCount == 0 || src_tmp.Dynamic)
+            continue;
+        const int slice = (thread_count > 1) ? 64 : src_tmp.GlyphsCount;
+        for (int glyph_start = 0; glyph_start < src_tmp.GlyphsCount; glyph_start += slice)
+        {
+            ImFontBuildRenderJob job;
+            job.SrcIndex = src_i;
+            job.GlyphStart = glyph_start;
+            job.GlyphCount = ImMin(slice, src_tmp.GlyphsCount - glyph_start);
+            job.Seconds = 0.0;
+            ctx.Jobs.push_back(job);
+        }
+    }
+
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+    thread_count = ImMin(thread_count, ctx.Jobs.Size);
+    ImVector<std::thread*> threads;
+    for (int n = 1; n < thread_count; n++)
+        threads.push_back(IM_NEW(std::thread)(ImFontAtlasBuildRenderWorker, &ctx));
+    ImFontAtlasBuildRenderWorker(&ctx);
+    for (std::thread* thread : threads)
+    {
+        thread->join();
+        IM_DELETE(thread);
+    }
+#else
+    ImFontAtlasBuildRenderWorker(&ctx);
+#endif
+
+    out_src_seconds->resize(src_tmp_array.Size, 0.0);
+    for (const ImFontBuildRenderJob& job : ctx.Jobs)
+        (*out_src_seconds)[job.SrcIndex] += job.Seconds;
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -2838,6 +3406,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     atlas->TexUvScale = ImVec2(0.0f, 0.0f);
     atlas->TexUvWhitePixel = ImVec2(0.0f, 0.0f);
     atlas->ClearTexData();
+    atlas->TexUpdateX0 = atlas->TexUpdateY0 = atlas->TexUpdateX1 = atlas->TexUpdateY1 = 0;
 
     // Temporary storage for building
     ImVector<ImFontBuildSrcData> src_tmp_array;
@@ -2874,6 +3443,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         }
 
         // Measure highest codepoints
+        src_tmp.Dynamic = cfg.DynamicGlyphs;
         ImFontBuildDstData& dst_tmp = dst_tmp_array[src_tmp.DstIndex];
         src_tmp.SrcRanges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
         for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
@@ -2911,7 +3481,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
                 dst_tmp.GlyphsCount++;
                 src_tmp.GlyphsSet.SetBit(codepoint);
                 dst_tmp.GlyphsSet.SetBit(codepoint);
-                total_glyphs_count++;
+                if (!src_tmp.Dynamic)
+                    total_glyphs_count++;
             }
     }
 
@@ -2934,19 +3505,30 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     ImVector<stbtt_packedchar> buf_packedchars;
     buf_rects.resize(total_glyphs_count);
     buf_packedchars.resize(total_glyphs_count);
-    memset(buf_rects.Data, 0, (size_t)buf_rects.size_in_bytes());
-    memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
+    if (total_glyphs_count > 0) // (local) Zero when every glyph is dynamic
+    {
+        memset(buf_rects.Data, 0, (size_t)buf_rects.size_in_bytes());
+        memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
+    }
 
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
     int total_surface = 0;
     int buf_rects_out_n = 0;
     int buf_packedchars_out_n = 0;
     const int pack_padding = atlas->TexGlyphPadding;
+    int dynamic_region_height = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
+        if (src_tmp.Dynamic)
+        {
+            // (local) Start with room for 8 rows of the tallest glyphs, ImFontAtlasDynamicNewFrame() grows it when needed
+            const ImFontConfig& cfg = atlas->ConfigData[src_i];
+            dynamic_region_height = ImMax(dynamic_region_height, 8 * ((int)ImCeil(cfg.SizePixels * cfg.RasterizerDensity) * cfg.OversampleV + pack_padding + 4));
+            continue;
+        }
 
         src_tmp.Rects = &buf_rects[buf_rects_out_n];
         src_tmp.PackedChars = &buf_packedchars[buf_packedchars_out_n];
@@ -3001,7 +3583,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
+        if (src_tmp.GlyphsCount == 0 || src_tmp.Dynamic)
             continue;
 
         stbrp_pack_rects((stbrp_context*)spc.pack_info, src_tmp.Rects, src_tmp.GlyphsCount);
@@ -3014,6 +3596,9 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     }
 
     // 7. Allocate texture
+    // (local) Glyphs rasterized on demand go below the prebuilt ones
+    const int dynamic_region_y = atlas->TexHeight;
+    atlas->TexHeight += dynamic_region_height;
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
@@ -3022,27 +3607,11 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
-    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
-        {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
-        }
+    // (local) Spread over worker threads, see ImFontAtlas::BuildThreadCount
+    ImVector<double> src_render_seconds;
+    ImFontAtlasBuildRenderGlyphs(atlas, src_tmp_array, &spc, &src_render_seconds);
+    for (ImFontBuildSrcData& src_tmp : src_tmp_array)
         src_tmp.Rects = NULL;
-    }
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -3065,6 +3634,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         const float ascent = ImCeil(unscaled_ascent * font_scale);
         const float descent = ImFloor(unscaled_descent * font_scale);
         ImFontAtlasBuildSetupFont(atlas, dst_font, &cfg, ascent, descent);
+        dst_font->MetricsBuildTime += (float)src_render_seconds[src_i]; // (local)
         const float font_off_x = cfg.GlyphOffset.x;
         const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(dst_font->Ascent);
 
@@ -3073,19 +3643,32 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
         {
             // Register glyph
+            // (local) Dynamic glyphs get their metrics now (so layout never needs pixels) and their UVs once rasterized
             const int codepoint = src_tmp.GlyphsList[glyph_i];
-            const stbtt_packedchar& pc = src_tmp.PackedChars[glyph_i];
+            stbtt_packedchar dynamic_pc;
+            if (src_tmp.Dynamic)
+                ImFontAtlasBuildMeasureGlyph(&src_tmp.FontInfo, cfg, codepoint, &dynamic_pc);
+            const stbtt_packedchar* chardata = src_tmp.Dynamic ? &dynamic_pc : src_tmp.PackedChars;
+            const int chardata_i = src_tmp.Dynamic ? 0 : glyph_i;
+            const stbtt_packedchar& pc = chardata[chardata_i];
             stbtt_aligned_quad q;
             float unused_x = 0.0f, unused_y = 0.0f;
-            stbtt_GetPackedQuad(src_tmp.PackedChars, atlas->TexWidth, atlas->TexHeight, glyph_i, &unused_x, &unused_y, &q, 0);
+            stbtt_GetPackedQuad(chardata, atlas->TexWidth, atlas->TexHeight, chardata_i, &unused_x, &unused_y, &q, 0);
             float x0 = q.x0 * inv_rasterization_scale + font_off_x;
             float y0 = q.y0 * inv_rasterization_scale + font_off_y;
             float x1 = q.x1 * inv_rasterization_scale + font_off_x;
             float y1 = q.y1 * inv_rasterization_scale + font_off_y;
             dst_font->AddGlyph(&cfg, (ImWchar)codepoint, x0, y0, x1, y1, q.s0, q.t0, q.s1, q.t1, pc.xadvance * inv_rasterization_scale);
+            if (src_tmp.Dynamic)
+                dst_font->Glyphs.back().Dynamic = true;
         }
     }
 
+    // (local) Keep what rasterizing dynamic glyphs later needs
+    ImVector<ImFontDynamicSource> dynamic_sources;
+    if (dynamic_region_height > 0 && ImFontAtlasDynamicInitSources(atlas, &dynamic_sources))
+        ImFontAtlasDynamicCreate(atlas, dynamic_region_y, &dynamic_sources);
+
     // Cleanup
     src_tmp_array.clear_destruct();
 
@@ -3100,6 +3683,589 @@ const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
     return &io;
 }
 
+//-------------------------------------------------------------------------
+// (local) Dynamic glyphs
+//-------------------------------------------------------------------------
+
+#define IM_FONTATLAS_DYNAMIC_TEX_HEIGHT_MAX     8192    // Don't grow past this (the lowest GL_MAX_TEXTURE_SIZE still common)
+
+static void ImFontAtlasDynamicDestroy(ImFontAtlas* atlas)
+{
+    if (atlas->DynamicCache)
+        IM_DELETE(atlas->DynamicCache);
+    atlas->DynamicCache = NULL;
+}
+
+// Mirror a changed rectangle into the RGBA32 copy and add it to what the backend has to upload
+static void ImFontAtlasDynamicMarkUpdated(ImFontAtlas* atlas, int x, int y, int w, int h)
+{
+    if (atlas->TexPixelsRGBA32)
+        for (int row = y; row < y + h; row++)
+        {
+            const unsigned char* src = atlas->TexPixelsAlpha8 + row * atlas->TexWidth + x;
+            unsigned int* dst = atlas->TexPixelsRGBA32 + row * atlas->TexWidth + x;
+            for (int n = 0; n < w; n++)
+                dst[n] = IM_COL32(255, 255, 255, (unsigned int)src[n]);
+        }
+    if (atlas->TexUpdateX0 >= atlas->TexUpdateX1)
+    {
+        atlas->TexUpdateX0 = x;
+        atlas->TexUpdateY0 = y;
+        atlas->TexUpdateX1 = x + w;
+        atlas->TexUpdateY1 = y + h;
+        return;
+    }
+    atlas->TexUpdateX0 = ImMin(atlas->TexUpdateX0, x);
+    atlas->TexUpdateY0 = ImMin(atlas->TexUpdateY0, y);
+    atlas->TexUpdateX1 = ImMax(atlas->TexUpdateX1, x + w);
+    atlas->TexUpdateY1 = ImMax(atlas->TexUpdateY1, y + h);
+}
+
+static void ImFontAtlasDynamicEvictShelf(ImFontAtlas* atlas, int shelf_n)
+{
+    ImFontAtlasDynamicCache* cache = atlas->DynamicCache;
+    ImFontDynamicShelf& shelf = cache->Shelves[shelf_n];
+    for (int n = 0; n < cache->Entries.Size; )
+    {
+        ImFontDynamicEntry& entry = cache->Entries[n];
+        if (entry.Shelf != shelf_n)
+        {
+            n++;
+            continue;
+        }
+        ImFontGlyph& glyph = entry.Font->Glyphs[entry.GlyphIndex];
+        glyph.Resident = false;
+        glyph.U0 = glyph.V0 = glyph.U1 = glyph.V1 = 0.0f;
+        cache->Stats.GlyphsEvicted++;
+        entry = cache->Entries.back();
+        cache->Entries.pop_back();
+    }
+    for (int row = shelf.Y; row < shelf.Y + shelf.Height; row++)
+        memset(atlas->TexPixelsAlpha8 + row * atlas->TexWidth, 0, (size_t)shelf.X);
+    ImFontAtlasDynamicMarkUpdated(atlas, 0, shelf.Y, shelf.X, shelf.Height);
+    shelf.X = 0;
+}
+
+// Find room for a w*h rectangle (padding included), returns the shelf index or -1
+static int ImFontAtlasDynamicAlloc(ImFontAtlas* atlas, int w, int h, int* out_x, int* out_y)
+{
+    ImFontAtlasDynamicCache* cache = atlas->DynamicCache;
+
+    // The lowest shelf with room left that doesn't waste more than half the glyph height
+    int best = -1;
+    for (int n = 0; n < cache->Shelves.Size; n++)
+    {
+        const ImFontDynamicShelf& shelf = cache->Shelves[n];
+        if (shelf.Height >= h && shelf.Height <= h + h / 2 + 2 && shelf.X + w <= atlas->TexWidth)
+            if (best == -1 || shelf.Height < cache->Shelves[best].Height)
+                best = n;
+    }
+
+    // Open a new shelf
+    const int shelf_height = (h + 3) & ~3;
+    if (best == -1 && cache->NextShelfY + shelf_height <= atlas->TexHeight)
+    {
+        ImFontDynamicShelf shelf;
+        shelf.Y = cache->NextShelfY;
+        shelf.Height = shelf_height;
+        shelf.X = 0;
+        shelf.LastUsedFrame = cache->FrameCount;
+        best = cache->Shelves.Size;
+        cache->Shelves.push_back(shelf);
+        for (int row = shelf.Y; row < shelf.Y + shelf.Height; row++)
+            cache->RowShelf[row] = (ImS16)best;
+        cache->NextShelfY += shelf_height;
+    }
+
+    // Empty the least recently drawn shelf that is tall enough. Not one drawn this frame: its UVs may already be in a draw list.
+    if (best == -1)
+    {
+        for (int n = 0; n < cache->Shelves.Size; n++)
+        {
+            const ImFontDynamicShelf& shelf = cache->Shelves[n];
+            if (shelf.Height >= h && shelf.LastUsedFrame < cache->FrameCount)
+                if (best == -1 || shelf.LastUsedFrame < cache->Shelves[best].LastUsedFrame)
+                    best = n;
+        }
+        if (best == -1)
+            return -1;
+        ImFontAtlasDynamicEvictShelf(atlas, best);
+    }
+
+    ImFontDynamicShelf& shelf = cache->Shelves[best];
+    *out_x = shelf.X;
+    *out_y = shelf.Y;
+    shelf.X += w;
+    return best;
+}
+
+static bool ImFontAtlasDynamicRasterizeGlyph(ImFontAtlas* atlas, ImFont* font, ImFontGlyph* glyph)
+{
+    ImFontAtlasDynamicCache* cache = atlas->DynamicCache;
+
+    // Same source as Build() picked: the first dynamic config of the font that covers the codepoint and has it
+    const int codepoint = (int)glyph->Codepoint;
+    const ImFontDynamicSource* src = NULL;
+    int glyph_index_in_font = 0;
+    for (const ImFontDynamicSource& source : cache->Sources)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[source.ConfigIndex];
+        if (cfg.DstFont != font)
+            continue;
+        bool in_ranges = false;
+        for (const ImWchar* range = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault(); range[0] && range[1] && !in_ranges; range += 2)
+            in_ranges = (codepoint >= range[0] && codepoint <= range[1]);
+        if (in_ranges && (glyph_index_in_font = stbtt_FindGlyphIndex(&source.FontInfo, codepoint)) != 0)
+        {
+            src = &source;
+            break;
+        }
+    }
+    if (src == NULL)
+        return false;
+    const ImFontConfig& cfg = atlas->ConfigData[src->ConfigIndex];
+
+    // Same rectangle size as Build() gathers
+    const float scale = (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(&src->FontInfo, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(&src->FontInfo, -cfg.SizePixels * cfg.RasterizerDensity);
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBoxSubpixel(&src->FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+    const int w = x1 - x0 + atlas->TexGlyphPadding + cfg.OversampleH - 1;
+    const int h = y1 - y0 + atlas->TexGlyphPadding + cfg.OversampleV - 1;
+    int x = 0, y = 0;
+    const int shelf_n = (w <= atlas->TexWidth) ? ImFontAtlasDynamicAlloc(atlas, w, h, &x, &y) : -1;
+    if (shelf_n < 0)
+    {
+        cache->GrowPending = true;
+        cache->Stats.GlyphsDropped++;
+        return false;
+    }
+
+    // Render as Build() does, through a one-glyph range
+    stbtt_pack_context spc = {};
+    spc.width = atlas->TexWidth;
+    spc.height = atlas->TexHeight;
+    spc.stride_in_bytes = atlas->TexWidth;
+    spc.padding = atlas->TexGlyphPadding;
+    spc.pixels = atlas->TexPixelsAlpha8;
+    stbtt_packedchar pc = {};
+    stbtt_pack_range range = {};
+    range.font_size = cfg.SizePixels * cfg.RasterizerDensity;
+    range.array_of_unicode_codepoints = (int*)&codepoint;
+    range.num_chars = 1;
+    range.chardata_for_range = &pc;
+    range.h_oversample = (unsigned char)cfg.OversampleH;
+    range.v_oversample = (unsigned char)cfg.OversampleV;
+    stbrp_rect rect = {};
+    rect.x = (stbrp_coord)x;
+    rect.y = (stbrp_coord)y;
+    rect.w = (stbrp_coord)w;
+    rect.h = (stbrp_coord)h;
+    rect.was_packed = 1;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &src->FontInfo, &range, 1, &rect);
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, rect.x, rect.y, rect.w, rect.h, atlas->TexWidth * 1);
+    }
+    ImFontAtlasDynamicMarkUpdated(atlas, x, y, w, h);
+
+    stbtt_aligned_quad q;
+    float unused_x = 0.0f, unused_y = 0.0f;
+    stbtt_GetPackedQuad(&pc, atlas->TexWidth, atlas->TexHeight, 0, &unused_x, &unused_y, &q, 0);
+    glyph->U0 = q.s0;
+    glyph->V0 = q.t0;
+    glyph->U1 = q.s1;
+    glyph->V1 = q.t1;
+    glyph->Resident = true;
+
+    ImFontDynamicEntry entry;
+    entry.Font = font;
+    entry.GlyphIndex = (int)(glyph - font->Glyphs.Data);
+    entry.Shelf = shelf_n;
+    cache->Entries.push_back(entry);
+    cache->Shelves[shelf_n].LastUsedFrame = cache->FrameCount;
+    cache->Stats.GlyphsRasterized++;
+    return true;
+}
+
+bool ImFontAtlasDynamicUseGlyph(ImFontAtlas* atlas, ImFont* font, ImFontGlyph* glyph)
+{
+    IM_ASSERT(glyph->Dynamic);
+    ImFontAtlasDynamicCache* cache = atlas->DynamicCache;
+    if (glyph->Resident)
+    {
+        if (cache != NULL)
+            cache->Shelves[cache->RowShelf[(int)(glyph->V0 * atlas->TexHeight + 0.5f)]].LastUsedFrame = cache->FrameCount;
+        return true;
+    }
+    if (cache == NULL || atlas->TexPixelsAlpha8 == NULL)
+        return false;
+    return ImFontAtlasDynamicRasterizeGlyph(atlas, font, glyph);
+}
+
+void ImFontAtlasDynamicNewFrame(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamicCache* cache = atlas->DynamicCache;
+    if (cache == NULL)
+        return;
+    cache->FrameCount++;
+    if (!cache->GrowPending)
+        return;
+    cache->GrowPending = false;
+
+    // Double the height: existing pixels stay where they are, so only V coordinates change
+    const int old_height = atlas->TexHeight;
+    const int new_height = ImMin(old_height * 2, IM_FONTATLAS_DYNAMIC_TEX_HEIGHT_MAX);
+    if (new_height <= old_height)
+        return;
+    const size_t old_pixels = (size_t)atlas->TexWidth * old_height;
+    const size_t new_pixels = (size_t)atlas->TexWidth * new_height;
+    unsigned char* alpha8 = (unsigned char*)IM_ALLOC(new_pixels);
+    memcpy(alpha8, atlas->TexPixelsAlpha8, old_pixels);
+    memset(alpha8 + old_pixels, 0, new_pixels - old_pixels);
+    IM_FREE(atlas->TexPixelsAlpha8);
+    atlas->TexPixelsAlpha8 = alpha8;
+    if (atlas->TexPixelsRGBA32)
+    {
+        unsigned int* rgba32 = (unsigned int*)IM_ALLOC(new_pixels * 4);
+        memcpy(rgba32, atlas->TexPixelsRGBA32, old_pixels * 4);
+        for (size_t n = old_pixels; n < new_pixels; n++)
+            rgba32[n] = IM_COL32(255, 255, 255, 0);
+        IM_FREE(atlas->TexPixelsRGBA32);
+        atlas->TexPixelsRGBA32 = rgba32;
+    }
+
+    const float v_scale = (float)old_height / (float)new_height;
+    for (ImFont* font : atlas->Fonts)
+        for (ImFontGlyph& glyph : font->Glyphs)
+        {
+            glyph.V0 *= v_scale;
+            glyph.V1 *= v_scale;
+        }
+    atlas->TexHeight = new_height;
+    atlas->TexUvScale.y = 1.0f / new_height;
+    atlas->TexUvWhitePixel.y *= v_scale;
+    for (ImVec4& uv : atlas->TexUvLines)
+    {
+        uv.y *= v_scale;
+        uv.w *= v_scale;
+    }
+    cache->RowShelf.resize(new_height, -1);
+    atlas->TexUpdateX0 = atlas->TexUpdateY0 = 0;
+    atlas->TexUpdateX1 = atlas->TexWidth;
+    atlas->TexUpdateY1 = new_height;
+    cache->Stats.TexGrowCount++;
+}
+
+void ImFontAtlasDynamicGetStats(const ImFontAtlas* atlas, ImFontAtlasDynamicStats* out_stats)
+{
+    memset(out_stats, 0, sizeof(*out_stats));
+    if (const ImFontAtlasDynamicCache* cache = atlas->DynamicCache)
+    {
+        *out_stats = cache->Stats;
+        out_stats->GlyphsResident = cache->Entries.Size;
+    }
+}
+
+
+//-------------------------------------------------------------------------
+// (local) On-disk cache of built atlases, see ImFontAtlas::BuildCacheFilename
+//-------------------------------------------------------------------------
+// File: ImFontAtlasCacheHeader, then the payload in the order ImFontAtlasCacheSave() writes it (native endianness,
+// every size involved is part of the key). Only the output of the stb_truetype builder is cached: pixels are Alpha8.
+
+#ifndef IMGUI_DISABLE_FILE_FUNCTIONS
+
+#define IM_FONTATLAS_CACHE_VERSION  1
+
+struct ImFontAtlasCacheHeader
+{
+    char                Magic[4];           // "IFAC"
+    ImU32               Version;            // IM_FONTATLAS_CACHE_VERSION
+    ImU32               Key;                // ImFontAtlasCacheKey()
+    ImU32               PayloadHash;        // ImHashData() of the payload, catches truncated/corrupted files
+    ImU64               PayloadSize;
+};
+
+// Everything of an ImFontConfig that changes the output (not Name, nor pointers)
+struct ImFontAtlasCacheConfigKey
+{
+    int                 FontDataSize, FontNo, DstIndex;
+    float               SizePixels;
+    int                 OversampleH, OversampleV;
+    ImVec2              GlyphExtraSpacing, GlyphOffset;
+    float               GlyphMinAdvanceX, GlyphMaxAdvanceX;
+    unsigned int        FontBuilderFlags;
+    float               RasterizerMultiply, RasterizerDensity;
+    ImWchar             EllipsisChar;
+    bool                PixelSnapH, MergeMode, DynamicGlyphs;
+};
+
+struct ImFontAtlasCacheRectKey
+{
+    unsigned short      Width, Height;
+    unsigned int        GlyphID, GlyphColored;
+    float               GlyphAdvanceX;
+    ImVec2              GlyphOffset;
+    int                 FontIndex;
+};
+
+static int ImFontAtlasCacheFontIndex(const ImFontAtlas* atlas, const ImFont* font)
+{
+    for (int n = 0; n < atlas->Fonts.Size; n++)
+        if (atlas->Fonts[n] == font)
+            return n;
+    return -1;
+}
+
+// Hash of the build inputs, atlas custom rectangles included (call after ImFontAtlasBuildInit())
+static ImU32 ImFontAtlasCacheKey(ImFontAtlas* atlas)
+{
+    const int globals[] = { IMGUI_VERSION_NUM, IM_FONTATLAS_CACHE_VERSION, (int)sizeof(ImFontGlyph), (int)sizeof(ImWchar), IM_DRAWLIST_TEX_LINES_WIDTH_MAX,
+        atlas->Flags, atlas->TexDesiredWidth, atlas->TexGlyphPadding, atlas->Fonts.Size, atlas->ConfigData.Size, atlas->CustomRects.Size, atlas->PackIdMouseCursors, atlas->PackIdLines };
+    ImU32 key = ImHashData(globals, sizeof(globals), 0);
+    for (const ImFontConfig& cfg : atlas->ConfigData)
+    {
+        ImFontAtlasCacheConfigKey cfg_key;
+        memset(&cfg_key, 0, sizeof(cfg_key)); // Padding is hashed too
+        cfg_key.FontDataSize = cfg.FontDataSize;
+        cfg_key.FontNo = cfg.FontNo;
+        cfg_key.DstIndex = ImFontAtlasCacheFontIndex(atlas, cfg.DstFont);
+        cfg_key.SizePixels = cfg.SizePixels;
+        cfg_key.OversampleH = cfg.OversampleH;
+        cfg_key.OversampleV = cfg.OversampleV;
+        cfg_key.GlyphExtraSpacing = cfg.GlyphExtraSpacing;
+        cfg_key.GlyphOffset = cfg.GlyphOffset;
+        cfg_key.GlyphMinAdvanceX = cfg.GlyphMinAdvanceX;
+        cfg_key.GlyphMaxAdvanceX = cfg.GlyphMaxAdvanceX;
+        cfg_key.FontBuilderFlags = cfg.FontBuilderFlags;
+        cfg_key.RasterizerMultiply = cfg.RasterizerMultiply;
+        cfg_key.RasterizerDensity = cfg.RasterizerDensity;
+        cfg_key.EllipsisChar = cfg.EllipsisChar;
+        cfg_key.PixelSnapH = cfg.PixelSnapH;
+        cfg_key.MergeMode = cfg.MergeMode;
+        cfg_key.DynamicGlyphs = cfg.DynamicGlyphs;
+        key = ImHashData(&cfg_key, sizeof(cfg_key), key);
+        key = ImHashData(cfg.FontData, (size_t)cfg.FontDataSize, key);
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+        int ranges_count = 0;
+        while (ranges[ranges_count])
+            ranges_count++;
+        key = ImHashData(ranges, sizeof(ImWchar) * (ranges_count + 1), key);
+    }
+    for (const ImFontAtlasCustomRect& r : atlas->CustomRects)
+    {
+        ImFontAtlasCacheRectKey rect_key;
+        memset(&rect_key, 0, sizeof(rect_key));
+        rect_key.Width = r.Width;
+        rect_key.Height = r.Height;
+        rect_key.GlyphID = r.GlyphID;
+        rect_key.GlyphColored = r.GlyphColored;
+        rect_key.GlyphAdvanceX = r.GlyphAdvanceX;
+        rect_key.GlyphOffset = r.GlyphOffset;
+        rect_key.FontIndex = ImFontAtlasCacheFontIndex(atlas, r.Font);
+        key = ImHashData(&rect_key, sizeof(rect_key), key);
+    }
+    return key;
+}
+
+static void ImFontAtlasCacheWrite(ImVector<char>* buf, const void* data, size_t size)
+{
+    const int offset = buf->Size;
+    buf->resize(buf->Size + (int)size);
+    if (size > 0)
+        memcpy(buf->Data + offset, data, size);
+}
+
+// Bounds-checked reads from the mapped payload: a short or inconsistent file is a mismatch, not a crash
+struct ImFontAtlasCacheReader
+{
+    const char*         Data;
+    size_t              Size, Pos;
+
+    const void*         Read(size_t size)               { if (size > Size - Pos) return NULL; const void* p = Data + Pos; Pos += size; return p; }
+    bool                Read(void* dst, size_t size)    { const void* p = Read(size); if (p) memcpy(dst, p, size); return p != NULL; }
+};
+
+// Whole file in memory: mapped (read-only, the kernel pages it in from the page cache), or loaded on platforms without mmap
+struct ImFontAtlasCacheFile
+{
+    const char*         Data;
+    size_t              Size;
+#ifdef _WIN32
+    bool                Open(const char* filename)      { Data = (const char*)ImFileLoadToMemory(filename, "rb", &Size); return Data != NULL; }
+    void                Close()                         { IM_FREE((void*)Data); }
+#else
+    bool                Open(const char* filename)
+    {
+        Data = NULL;
+        const int fd = open(filename, O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            Size = (size_t)st.st_size;
+            void* mapped = mmap(NULL, Size, PROT_READ, MAP_PRIVATE, fd, 0);
+            Data = (mapped != MAP_FAILED) ? (const char*)mapped : NULL;
+        }
+        close(fd);
+        return Data != NULL;
+    }
+    void                Close()                         { munmap((void*)Data, Size); }
+#endif
+};
+
+// Replaces the build with the cached one. Returns false, before modifying anything, unless the whole file matches.
+static bool ImFontAtlasCacheLoad(ImFontAtlas* atlas, ImU32 key)
+{
+    IMGUI_PROFILE_SCOPE("ImFontAtlas cache load");
+    ImFontAtlasCacheFile file;
+    if (!file.Open(atlas->BuildCacheFilename))
+        return false;
+
+    ImFontAtlasCacheHeader header;
+    ImFontAtlasCacheReader reader = { file.Data, file.Size, 0 };
+    bool ok = reader.Read(&header, sizeof(header)) && memcmp(header.Magic, "IFAC", 4) == 0 && header.Version == IM_FONTATLAS_CACHE_VERSION && header.Key == key
+        && header.PayloadSize == file.Size - sizeof(header) && header.PayloadHash == ImHashData(file.Data + sizeof(header), (size_t)header.PayloadSize, 0);
+
+    // Validate everything first, keeping pointers into the mapping
+    int tex_size[2] = {}, pack_ids[2] = {}, dynamic_region_y = -1, counts[2] = {};
+    ImVec2 uv[2];
+    ImVec4 uv_lines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+    ok = ok && reader.Read(tex_size, sizeof(tex_size)) && reader.Read(uv, sizeof(uv)) && reader.Read(uv_lines, sizeof(uv_lines)) && reader.Read(pack_ids, sizeof(pack_ids))
+        && reader.Read(&dynamic_region_y, sizeof(int)) && reader.Read(counts, sizeof(counts))
+        && tex_size[0] > 0 && tex_size[1] > 0 && counts[0] == atlas->CustomRects.Size && counts[1] == atlas->Fonts.Size;
+    const unsigned short* rects_xy = ok ? (const unsigned short*)reader.Read(sizeof(unsigned short) * 2 * counts[0]) : NULL;
+    ImVector<const char*> fonts;
+    for (int font_n = 0; ok && rects_xy && font_n < counts[1]; font_n++)
+    {
+        // FontSize, Ascent, Descent, MetricsTotalSurface, glyph count, glyphs
+        const char* font = (const char*)reader.Read(sizeof(float) * 3 + sizeof(int) * 2);
+        int glyph_count = 0;
+        if (font)
+            memcpy(&glyph_count, font + sizeof(float) * 3 + sizeof(int), sizeof(int));
+        ok = font && glyph_count >= 0 && reader.Read(sizeof(ImFontGlyph) * (size_t)glyph_count);
+        fonts.push_back(font);
+    }
+    const unsigned char* pixels = (ok && rects_xy) ? (const unsigned char*)reader.Read((size_t)tex_size[0] * tex_size[1]) : NULL;
+    ImVector<ImFontDynamicSource> dynamic_sources;
+    if (!pixels || reader.Pos != reader.Size || (dynamic_region_y >= 0 && !ImFontAtlasDynamicInitSources(atlas, &dynamic_sources)))
+    {
+        file.Close();
+        return false;
+    }
+
+    // Same state as ImFontAtlasBuildWithStbTruetype() + ImFontAtlasBuildFinish() leave
+    atlas->TexID = (ImTextureID)NULL;
+    atlas->ClearTexData();
+    atlas->TexUpdateX0 = atlas->TexUpdateY0 = atlas->TexUpdateX1 = atlas->TexUpdateY1 = 0;
+    atlas->TexWidth = tex_size[0];
+    atlas->TexHeight = tex_size[1];
+    atlas->TexUvScale = uv[0];
+    atlas->TexUvWhitePixel = uv[1];
+    memcpy(atlas->TexUvLines, uv_lines, sizeof(uv_lines));
+    atlas->PackIdMouseCursors = pack_ids[0];
+    atlas->PackIdLines = pack_ids[1];
+    for (int n = 0; n < atlas->CustomRects.Size; n++)
+    {
+        atlas->CustomRects[n].X = rects_xy[n * 2];
+        atlas->CustomRects[n].Y = rects_xy[n * 2 + 1];
+    }
+    atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC((size_t)atlas->TexWidth * atlas->TexHeight);
+    memcpy(atlas->TexPixelsAlpha8, pixels, (size_t)atlas->TexWidth * atlas->TexHeight);
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+    {
+        ImFont* font = atlas->Fonts[font_n];
+        const char* src = fonts[font_n];
+        int glyph_count;
+        font->ClearOutputData();
+        font->ContainerAtlas = atlas;
+        memcpy(&font->FontSize, src, sizeof(float));
+        memcpy(&font->Ascent, src + sizeof(float), sizeof(float));
+        memcpy(&font->Descent, src + sizeof(float) * 2, sizeof(float));
+        memcpy(&font->MetricsTotalSurface, src + sizeof(float) * 3, sizeof(int));
+        memcpy(&glyph_count, src + sizeof(float) * 3 + sizeof(int), sizeof(int));
+        font->Glyphs.resize(glyph_count);
+        if (glyph_count > 0)
+            memcpy(font->Glyphs.Data, src + sizeof(float) * 3 + sizeof(int) * 2, sizeof(ImFontGlyph) * (size_t)glyph_count);
+        font->BuildLookupTable();
+    }
+    file.Close();
+
+    if (dynamic_region_y >= 0)
+        ImFontAtlasDynamicCreate(atlas, dynamic_region_y, &dynamic_sources);
+    atlas->TexReady = true;
+    return true;
+}
+
+// Written right after a full build, before the application fills custom rectangles or draws dynamic glyphs
+static void ImFontAtlasCacheSave(ImFontAtlas* atlas, ImU32 key)
+{
+    IMGUI_PROFILE_SCOPE("ImFontAtlas cache save");
+    if (atlas->TexPixelsAlpha8 == NULL || atlas->TexPixelsUseColors)
+        return;
+    ImVector<char> payload;
+    const int tex_size[2] = { atlas->TexWidth, atlas->TexHeight };
+    const ImVec2 uv[2] = { atlas->TexUvScale, atlas->TexUvWhitePixel };
+    const int pack_ids[2] = { atlas->PackIdMouseCursors, atlas->PackIdLines };
+    const int dynamic_region_y = atlas->DynamicCache ? atlas->DynamicCache->RegionY : -1;
+    const int counts[2] = { atlas->CustomRects.Size, atlas->Fonts.Size };
+    ImFontAtlasCacheWrite(&payload, tex_size, sizeof(tex_size));
+    ImFontAtlasCacheWrite(&payload, uv, sizeof(uv));
+    ImFontAtlasCacheWrite(&payload, atlas->TexUvLines, sizeof(atlas->TexUvLines));
+    ImFontAtlasCacheWrite(&payload, pack_ids, sizeof(pack_ids));
+    ImFontAtlasCacheWrite(&payload, &dynamic_region_y, sizeof(int));
+    ImFontAtlasCacheWrite(&payload, counts, sizeof(counts));
+    for (const ImFontAtlasCustomRect& r : atlas->CustomRects)
+    {
+        const unsigned short xy[2] = { r.X, r.Y };
+        ImFontAtlasCacheWrite(&payload, xy, sizeof(xy));
+    }
+    for (const ImFont* font : atlas->Fonts)
+    {
+        const float metrics[3] = { font->FontSize, font->Ascent, font->Descent };
+        const int sizes[2] = { font->MetricsTotalSurface, font->Glyphs.Size };
+        ImFontAtlasCacheWrite(&payload, metrics, sizeof(metrics));
+        ImFontAtlasCacheWrite(&payload, sizes, sizeof(sizes));
+        ImFontAtlasCacheWrite(&payload, font->Glyphs.Data, (size_t)font->Glyphs.size_in_bytes());
+    }
+    ImFontAtlasCacheWrite(&payload, atlas->TexPixelsAlpha8, (size_t)atlas->TexWidth * atlas->TexHeight);
+
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, "IFAC", 4);
+    header.Version = IM_FONTATLAS_CACHE_VERSION;
+    header.Key = key;
+    header.PayloadHash = ImHashData(payload.Data, (size_t)payload.Size, 0);
+    header.PayloadSize = (ImU64)payload.Size;
+
+    // Through a temporary file, so that another instance never maps a partial one
+    char tmp_filename[512];
+    ImFormatString(tmp_filename, IM_ARRAYSIZE(tmp_filename), "%s.tmp", atlas->BuildCacheFilename);
+    ImFileHandle f = ImFileOpen(tmp_filename, "wb");
+    if (!f)
+        return;
+    const bool written = ImFileWrite(&header, sizeof(header), 1, f) == 1 && ImFileWrite(payload.Data, (ImU64)payload.Size, 1, f) == 1;
+    ImFileClose(f);
+#ifdef _WIN32
+    remove(atlas->BuildCacheFilename); // rename() doesn't replace there
+#endif
+    if (!written || rename(tmp_filename, atlas->BuildCacheFilename) != 0)
+        remove(tmp_filename);
+}
+
+#endif // #ifndef IMGUI_DISABLE_FILE_FUNCTIONS
+
+#else // IMGUI_ENABLE_STB_TRUETYPE
+
+// (local) Dynamic glyphs are a stb_truetype feature: other builders prebuild every glyph and never create a cache
+static void ImFontAtlasDynamicDestroy(ImFontAtlas*) {}
+bool ImFontAtlasDynamicUseGlyph(ImFontAtlas*, ImFont*, ImFontGlyph*) { return false; }
+void ImFontAtlasDynamicNewFrame(ImFontAtlas*) {}
+void ImFontAtlasDynamicGetStats(const ImFontAtlas*, ImFontAtlasDynamicStats* out_stats) { memset(out_stats, 0, sizeof(*out_stats)); }
+
 #endif // IMGUI_ENABLE_STB_TRUETYPE
 
 void ImFontAtlasUpdateConfigDataPointers(ImFontAtlas* atlas)
@@ -3647,6 +4813,7 @@ ImFont::ImFont()
     Scale = 1.0f;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
+    MetricsBuildTime = 0.0f; // (local)
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
 }
 
@@ -3667,6 +4834,7 @@ void    ImFont::ClearOutputData()
     DirtyLookupTables = true;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
+    MetricsBuildTime = 0.0f; // (local)
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
 }
 
@@ -3821,6 +4989,7 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
     glyph.Codepoint = (unsigned int)codepoint;
     glyph.Visible = (x0 != x1) && (y0 != y1);
     glyph.Colored = false;
+    glyph.Dynamic = glyph.Resident = false;
     glyph.X0 = x0;
     glyph.Y0 = y0;
     glyph.X1 = x1;
@@ -4065,12 +5234,24 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     return text_size;
 }
 
+// (local) Rasterizing a dynamic glyph updates the shared atlas: only the context's own draw lists may do it, on its thread
+static inline bool ImFontCanUseDynamicGlyphs(const ImDrawList* draw_list)
+{
+    return GImGui == NULL || draw_list->_Data == &GImGui->DrawListSharedData;
+}
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, ImWchar c)
 {
     const ImFontGlyph* glyph = FindGlyph(c);
     if (!glyph || !glyph->Visible)
         return;
+    if (glyph->Dynamic) // (local) Rasterize on first use
+    {
+        IM_ASSERT(ImFontCanUseDynamicGlyphs(draw_list) && "Fonts with DynamicGlyphs can't be drawn into detached draw lists");
+        if (!ImFontAtlasDynamicUseGlyph(ContainerAtlas, this, (ImFontGlyph*)(void*)glyph))
+            return;
+    }
     if (glyph->Colored)
         col |= ~IM_COL32_A_MASK;
     float scale = (size >= 0.0f) ? (size / FontSize) : 1.0f;
@@ -4202,6 +5383,17 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
             float y2 = y + glyph->Y1 * scale;
             if (x1 <= clip_rect.z && x2 >= clip_rect.x)
             {
+                // (local) Rasterize on first use, skip for this frame when the cache is full
+                if (glyph->Dynamic)
+                {
+                    IM_ASSERT(ImFontCanUseDynamicGlyphs(draw_list) && "Fonts with DynamicGlyphs can't be drawn into detached draw lists");
+                    if (!ImFontAtlasDynamicUseGlyph(ContainerAtlas, this, (ImFontGlyph*)(void*)glyph))
+                    {
+                        x += char_width;
+                        continue;
+                    }
+                }
+
                 // Render a character
                 float u1 = glyph->U0;
                 float v1 = glyph->V0;
@@ -230,6 +230,12 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 // Static Asserts
 #define IM_STATIC_ASSERT(_COND)         static_assert(_COND, "")
 
+// Profiling scopes in hot paths (NewFrame, Begin, Render...). Expands to nothing unless you define it in your imconfig.h,
+// e.g. '#define IMGUI_PROFILE_SCOPE(_NAME) MyProfilerScope MyScope(_NAME)'. _NAME is a string literal.
+#ifndef IMGUI_PROFILE_SCOPE
+#define IMGUI_PROFILE_SCOPE(_NAME)
+#endif
+
 // "Paranoid" Debug Asserts are meant to only be enabled during specific debugging/work, otherwise would slow down the code too much.
 // We currently don't have many of those so the effect is currently negligible, but onward intent to add more aggressive ones in the code.
 //#define IMGUI_DEBUG_PARANOID
@@ -343,6 +349,17 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImGuiID seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImGuiID seed = 0);
+// (local) Implementation used by ImHashData()/ImHashStr(). All of them produce the same CRC32C hashes.
+enum ImGuiHashBackend
+{
+    ImGuiHashBackend_Auto,          // Hardware CRC32C when the CPU has it (checked on first use), table otherwise
+    ImGuiHashBackend_Table,         // Byte at a time through a 1KB lookup table (upstream behavior)
+    ImGuiHashBackend_Crc32cHw,      // SSE4.2 or ARMv8 CRC32C instructions, 8 bytes at a time
+};
+IMGUI_API bool          ImHashSetBackend(ImGuiHashBackend backend);     // Return false when unsupported by this CPU/build
+IMGUI_API ImGuiHashBackend ImHashGetBackend();                          // Resolved backend (never _Auto)
+// (local) SSE2 normal/offset computation in ImDrawList::AddPolyline() and the AA fills (on by default, same output either way)
+IMGUI_API bool          ImDrawListSetSimdEnabled(bool enabled);         // Return false when asking for SIMD in a build without it
 
 // Helpers: Sorting
 #ifndef ImQsort
@@ -3549,6 +3566,23 @@ IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
 
+// (local) Glyphs rasterized on first use (ImFontConfig::DynamicGlyphs)
+// - ImFontAtlasDynamicNewFrame() is called by ImGui::NewFrame(): glyphs drawn since the previous call can't be evicted, and the texture
+//   only grows there (growing rescales every V coordinate, which would break vertices already emitted in the frame).
+// - ImFontAtlasDynamicUseGlyph() rasterizes a Dynamic glyph if needed and marks it used. Returns false when the cache is full of
+//   glyphs drawn this frame: the glyph is skipped and the texture grows at the next frame.
+struct ImFontAtlasDynamicStats
+{
+    int     GlyphsResident;     // Dynamic glyphs with pixels in the atlas
+    int     GlyphsRasterized;   // Since Build()
+    int     GlyphsEvicted;      // Since Build()
+    int     GlyphsDropped;      // Draws skipped because nothing could be evicted
+    int     TexGrowCount;       // Since Build()
+};
+IMGUI_API void      ImFontAtlasDynamicNewFrame(ImFontAtlas* atlas);
+IMGUI_API bool      ImFontAtlasDynamicUseGlyph(ImFontAtlas* atlas, ImFont* font, ImFontGlyph* glyph);
+IMGUI_API void      ImFontAtlasDynamicGetStats(const ImFontAtlas* atlas, ImFontAtlasDynamicStats* out_stats);
+
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
 //-----------------------------------------------------------------------------
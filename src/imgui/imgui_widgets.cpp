@@ -8022,7 +8022,7 @@ void ImGuiSelectionBasicStorage::Swap(ImGuiSelectionBasicStorage& r)
 {
     ImSwap(Size, r.Size);
     ImSwap(_SelectionOrder, r._SelectionOrder);
-    _Storage.Data.swap(r._Storage.Data);
+    _Storage.Swap(r._Storage);
 }
 
 bool ImGuiSelectionBasicStorage::Contains(ImGuiID id) const
@@ -8070,12 +8070,24 @@ void ImGuiSelectionBasicStorage::SetItemSelected(ImGuiID id, bool selected)
 static void ImGuiSelectionBasicStorage_BatchSetItemSelected(ImGuiSelectionBasicStorage* selection, ImGuiID id, bool selected, int size_before_amends, int selection_order)
 {
     ImGuiStorage* storage = &selection->_Storage;
+#ifdef IMGUI_STORAGE_USE_HASH_MAP
+    // (local) Insert through the index: pushing into Data directly would cost a full reindex on the next lookup
+    ImGuiStoragePair* it = storage->_Find(id);
+    const bool is_contained = (it != NULL);
+    IM_UNUSED(size_before_amends);
+    if (selected == (is_contained && it->val_i != 0))
+        return;
+    bool inserted;
+    if (selected && !is_contained)
+        storage->_FindOrInsert(id, &inserted)->val_i = selection_order;
+#else
     ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + size_before_amends, id);
     const bool is_contained = (it != storage->Data.Data + size_before_amends) && (it->key == id);
     if (selected == (is_contained && it->val_i != 0))
         return;
     if (selected && !is_contained)
         storage->Data.push_back(ImGuiStoragePair(id, selection_order)); // Push unsorted at end of vector, will be sorted in SelectionMultiAmendsFinish()
+#endif
     else if (is_contained)
         it->val_i = selected ? selection_order : 0; // Modify in-place.
     selection->Size += selected ? +1 : -1;
@@ -8316,6 +8328,7 @@ bool ImGui::ListBox(const char* label, int* current_item, const char* (*getter)(
 // - PlotEx() [Internal]
 // - PlotLines()
 // - PlotHistogram()
+// - PlotLinesMinMax() (local)
 //-------------------------------------------------------------------------
 // Plot/Graph widgets are not very good.
 // Consider writing your own, or using a third-party one, see:
@@ -8476,6 +8489,266 @@ void ImGui::PlotHistogram(const char* label, float (*values_getter)(void* data,
     PlotEx(ImGuiPlotType_Histogram, label, values_getter, data, values_count, values_offset, overlay_text, scale_min, scale_max, graph_size);
 }
 
+// (local) PlotLinesMinMax() and the ImGuiPlotPyramid it reads.
+
+// Min/max of values[0, count) ignoring NaN, merged into *out_min/*out_max.
+// minps/maxps return their second operand when either one is NaN, so keeping the accumulator second skips NaN like the scalar tail does.
+static void ImPlotReduceMinMax(const float* values, int count, float* out_min, float* out_max)
+{
+    float v_min = *out_min;
+    float v_max = *out_max;
+    int i = 0;
+#ifdef IMGUI_ENABLE_SSE
+    if (count >= 8)
+    {
+        __m128 acc_min0 = _mm_set1_ps(v_min), acc_min1 = acc_min0;
+        __m128 acc_max0 = _mm_set1_ps(v_max), acc_max1 = acc_max0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128 v0 = _mm_loadu_ps(values + i);
+            const __m128 v1 = _mm_loadu_ps(values + i + 4);
+            acc_min0 = _mm_min_ps(v0, acc_min0);
+            acc_min1 = _mm_min_ps(v1, acc_min1);
+            acc_max0 = _mm_max_ps(v0, acc_max0);
+            acc_max1 = _mm_max_ps(v1, acc_max1);
+        }
+        __m128 acc_min = _mm_min_ps(acc_min0, acc_min1);
+        __m128 acc_max = _mm_max_ps(acc_max0, acc_max1);
+        acc_min = _mm_min_ps(acc_min, _mm_movehl_ps(acc_min, acc_min));
+        acc_max = _mm_max_ps(acc_max, _mm_movehl_ps(acc_max, acc_max));
+        acc_min = _mm_min_ss(acc_min, _mm_shuffle_ps(acc_min, acc_min, _MM_SHUFFLE(1, 1, 1, 1)));
+        acc_max = _mm_max_ss(acc_max, _mm_shuffle_ps(acc_max, acc_max, _MM_SHUFFLE(1, 1, 1, 1)));
+        v_min = _mm_cvtss_f32(acc_min);
+        v_max = _mm_cvtss_f32(acc_max);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const float v = values[i];
+        v_min = (v < v_min) ? v : v_min;
+        v_max = (v > v_max) ? v : v_max;
+    }
+    *out_min = v_min;
+    *out_max = v_max;
+}
+
+void ImGuiPlotPyramid::Clear()
+{
+    for (int level = 0; level < IM_PLOT_PYRAMID_LEVELS; level++)
+        Levels[level].clear();
+    Count = 0;
+    _Columns.clear();
+}
+
+void ImGuiPlotPyramid::Update(const float* values, int count)
+{
+    if (count < Count)
+        Clear();
+    if (count == Count)
+        return;
+
+    // Level 0, starting over from the block the previous update left partial
+    int first = Count / 8;
+    Levels[0].resize((count + 7) / 8);
+    for (int k = first; k < Levels[0].Size; k++)
+    {
+        ImVec2 block(FLT_MAX, -FLT_MAX);
+        ImPlotReduceMinMax(values + k * 8, ImMin(8, count - k * 8), &block.x, &block.y);
+        Levels[0].Data[k] = block;
+    }
+
+    // Every level above: only the blocks covering a changed block of the level below
+    for (int level = 1; level < IM_PLOT_PYRAMID_LEVELS; level++)
+    {
+        const ImVector<ImVec2>& below = Levels[level - 1];
+        ImVector<ImVec2>& dst = Levels[level];
+        first /= 4;
+        dst.resize((below.Size + 3) / 4);
+        for (int k = first; k < dst.Size; k++)
+        {
+            ImVec2 block(FLT_MAX, -FLT_MAX);
+            for (int j = k * 4, j_end = ImMin(k * 4 + 4, below.Size); j < j_end; j++)
+            {
+                block.x = ImMin(block.x, below.Data[j].x);
+                block.y = ImMax(block.y, below.Data[j].y);
+            }
+            dst.Data[k] = block;
+        }
+    }
+    Count = count;
+}
+
+// Exact min/max of values[begin, end): raw samples up to the first/last 8-aligned index, then at each level
+// the blocks that don't fill a whole block of the next level, so at most 6 blocks per level.
+static void ImPlotPyramidRangeMinMax(const ImGuiPlotPyramid* pyramid, const float* values, int begin, int end, float* out_min, float* out_max)
+{
+    const int aligned_begin = ImMin((begin + 7) & ~7, end);
+    const int aligned_end = ImMax(end & ~7, aligned_begin);
+    ImPlotReduceMinMax(values + begin, aligned_begin - begin, out_min, out_max);
+    ImPlotReduceMinMax(values + aligned_end, end - aligned_end, out_min, out_max);
+
+    int lo = aligned_begin / 8;
+    int hi = aligned_end / 8;
+    for (int level = 0; lo < hi; level++)
+    {
+        const ImVec2* blocks = pyramid->Levels[level].Data;
+        const bool top = (level == IM_PLOT_PYRAMID_LEVELS - 1);
+        for (; lo < hi && (top || (lo & 3) != 0); lo++)
+        {
+            *out_min = ImMin(*out_min, blocks[lo].x);
+            *out_max = ImMax(*out_max, blocks[lo].y);
+        }
+        for (; lo < hi && (hi & 3) != 0; hi--)
+        {
+            *out_min = ImMin(*out_min, blocks[hi - 1].x);
+            *out_max = ImMax(*out_max, blocks[hi - 1].y);
+        }
+        lo /= 4;
+        hi /= 4;
+    }
+}
+
+void ImGui::PlotLinesMinMax(const char* label, const float* values, int values_count, ImGuiPlotPyramid* pyramid, int view_offset, int view_count, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+{
+    // Also while clipped, so a plot scrolled back into view doesn't have to catch up with a long backlog at once
+    IM_ASSERT(pyramid != NULL);
+    pyramid->Update(values, values_count);
+
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+
+    const ImGuiStyle& style = g.Style;
+    const ImGuiID id = window->GetID(label);
+
+    const ImVec2 label_size = CalcTextSize(label, NULL, true);
+    const ImVec2 frame_size = CalcItemSize(graph_size, CalcItemWidth(), label_size.y + style.FramePadding.y * 2.0f);
+
+    const ImRect frame_bb(window->DC.CursorPos, window->DC.CursorPos + frame_size);
+    const ImRect inner_bb(frame_bb.Min + style.FramePadding, frame_bb.Max - style.FramePadding);
+    const ImRect total_bb(frame_bb.Min, frame_bb.Max + ImVec2(label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f, 0));
+    ItemSize(total_bb, style.FramePadding.y);
+    if (!ItemAdd(total_bb, id, &frame_bb, ImGuiItemFlags_NoNav))
+        return;
+    bool hovered;
+    ButtonBehavior(frame_bb, id, &hovered, NULL);
+
+    view_offset = ImClamp(view_offset, 0, values_count);
+    if (view_count < 0 || view_count > values_count - view_offset)
+        view_count = values_count - view_offset;
+    const int res_w = (int)inner_bb.GetWidth();
+    const bool decimate = view_count > res_w;
+
+    // Envelope of each pixel column, which is also all the autoscale needs
+    ImVector<ImVec2>& columns = pyramid->_Columns;
+    columns.resize(0);
+    if (decimate && res_w > 0)
+    {
+        columns.resize(res_w);
+        for (int n = 0; n < res_w; n++)
+        {
+            const int begin = view_offset + (int)((ImS64)view_count * n / res_w);
+            const int end = view_offset + (int)((ImS64)view_count * (n + 1) / res_w);
+            ImVec2 column(FLT_MAX, -FLT_MAX);
+            ImPlotPyramidRangeMinMax(pyramid, values, begin, end, &column.x, &column.y);
+            columns.Data[n] = column;
+        }
+    }
+    if (scale_min == FLT_MAX || scale_max == FLT_MAX)
+    {
+        float v_min = FLT_MAX;
+        float v_max = -FLT_MAX;
+        if (decimate)
+            for (const ImVec2& column : columns)
+            {
+                v_min = ImMin(v_min, column.x);
+                v_max = ImMax(v_max, column.y);
+            }
+        else
+            ImPlotReduceMinMax(values + view_offset, view_count, &v_min, &v_max);
+        if (scale_min == FLT_MAX)
+            scale_min = v_min;
+        if (scale_max == FLT_MAX)
+            scale_max = v_max;
+    }
+
+    RenderFrame(frame_bb.Min, frame_bb.Max, GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
+
+    const float inv_scale = (scale_min == scale_max) ? 0.0f : (1.0f / (scale_max - scale_min));
+    const ImU32 col_base = GetColorU32(ImGuiCol_PlotLines);
+    const ImU32 col_hovered = GetColorU32(ImGuiCol_PlotLinesHovered);
+    const bool mouse_inside = hovered && inner_bb.Contains(g.IO.MousePos);
+    ImDrawList* draw_list = window->DrawList;
+    if (decimate && res_w > 0)
+    {
+        // One vertical span per column. Each span is stretched to reach the previous column's range,
+        // since the line between their last and first samples crosses that gap.
+        const float column_w = inner_bb.GetWidth() / (float)res_w;
+        const int n_hovered = mouse_inside ? ImClamp((int)((g.IO.MousePos.x - inner_bb.Min.x) / column_w), 0, res_w - 1) : -1;
+        ImVec2 prev(FLT_MAX, -FLT_MAX);
+        for (int n = 0; n < res_w; n++)
+        {
+            const ImVec2 column = columns.Data[n];
+            if (column.x > column.y) // Only NaN
+            {
+                prev = column;
+                continue;
+            }
+            const float v_lo = (prev.x <= prev.y) ? ImMin(column.x, prev.y) : column.x;
+            const float v_hi = (prev.x <= prev.y) ? ImMax(column.y, prev.x) : column.y;
+            prev = column;
+            float y0 = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_hi - scale_min) * inv_scale));
+            float y1 = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_lo - scale_min) * inv_scale));
+            if (y1 - y0 < 1.0f)
+            {
+                y0 = ImMax(inner_bb.Min.y, y0 - 0.5f);
+                y1 = y0 + 1.0f;
+            }
+            const float x0 = inner_bb.Min.x + n * column_w;
+            draw_list->AddRectFilled(ImVec2(x0, y0), ImVec2(x0 + ImMax(column_w, 1.0f), y1), n == n_hovered ? col_hovered : col_base);
+        }
+        if (n_hovered >= 0)
+        {
+            const int begin = view_offset + (int)((ImS64)view_count * n_hovered / res_w);
+            const int end = view_offset + (int)((ImS64)view_count * (n_hovered + 1) / res_w);
+            SetTooltip("%d..%d\nmin: %8.4g\nmax: %8.4g", begin, end - 1, columns.Data[n_hovered].x, columns.Data[n_hovered].y);
+        }
+    }
+    else if (view_count >= 2)
+    {
+        // Zoomed in to a sample or less per pixel: plain lines, broken at NaN
+        const float x_step = inner_bb.GetWidth() / (float)(view_count - 1);
+        for (int i = 0; i < view_count; i++)
+        {
+            const float v = values[view_offset + i];
+            if (v != v)
+            {
+                draw_list->PathStroke(col_base);
+                continue;
+            }
+            draw_list->PathLineTo(ImVec2(inner_bb.Min.x + i * x_step, ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v - scale_min) * inv_scale))));
+        }
+        draw_list->PathStroke(col_base);
+        if (mouse_inside)
+        {
+            const int i = ImClamp((int)((g.IO.MousePos.x - inner_bb.Min.x) / x_step + 0.5f), 0, view_count - 1);
+            const float v = values[view_offset + i];
+            const ImVec2 pos(inner_bb.Min.x + i * x_step, ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v - scale_min) * inv_scale)));
+            if (v == v)
+                draw_list->AddCircleFilled(pos, 2.0f, col_hovered);
+            SetTooltip("%d: %8.4g", view_offset + i, v);
+        }
+    }
+
+    // Text overlay
+    if (overlay_text)
+        RenderTextClipped(ImVec2(frame_bb.Min.x, frame_bb.Min.y + style.FramePadding.y), frame_bb.Max, overlay_text, NULL, NULL, ImVec2(0.5f, 0.0f));
+
+    if (label_size.x > 0.0f)
+        RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, inner_bb.Min.y), label);
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Value helpers
 // Those is not very useful, legacy API.
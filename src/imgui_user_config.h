@@ -0,0 +1,16 @@
+#ifndef IMGUI_USER_CONFIG_H
+#define IMGUI_USER_CONFIG_H
+
+// Project-side Dear ImGui configuration, pulled in by imgui.h through
+// IMGUI_USER_CONFIG (set in CMakeLists.txt) so the vendored imconfig.h stays untouched.
+
+#include "cpu_profiler.h"
+
+// Route ImGui's hot-path scopes into the application's CPU profiler
+#define IMGUI_PROFILE_SCOPE(_NAME) CPU_PROFILE_SCOPE(_NAME)
+
+// Hash-indexed ImGuiStorage: O(1) window state lookups and insertions instead of
+// a sorted array (see ImGuiStorage in imgui.h)
+#define IMGUI_STORAGE_USE_HASH_MAP
+
+#endif // IMGUI_USER_CONFIG_H
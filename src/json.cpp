@@ -0,0 +1,292 @@
+#include "json.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+
+static const JsonValue nullValue;
+
+const JsonValue& JsonValue::operator[](const char* key) const
+{
+    if (type != JsonType::Object)
+        return nullValue;
+    for (const auto& member : members)
+        if (member.first == key)
+            return member.second;
+    return nullValue;
+}
+
+const JsonValue& JsonValue::operator[](size_t index) const
+{
+    if (type != JsonType::Array || index >= items.size())
+        return nullValue;
+    return items[index];
+}
+
+namespace {
+
+struct JsonParser {
+    const char* p;
+    const char* end;
+    std::string error;
+    int depth = 0;
+
+    bool fail(const char* message)
+    {
+        if (error.empty())
+            error = message;
+        return false;
+    }
+
+    void skipWhitespace()
+    {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+            ++p;
+    }
+
+    bool literal(const char* word)
+    {
+        size_t length = strlen(word);
+        if ((size_t)(end - p) < length || memcmp(p, word, length) != 0)
+            return fail("invalid literal");
+        p += length;
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, unsigned codepoint)
+    {
+        if (codepoint < 0x80) {
+            out += (char)codepoint;
+        } else if (codepoint < 0x800) {
+            out += (char)(0xC0 | (codepoint >> 6));
+            out += (char)(0x80 | (codepoint & 0x3F));
+        } else if (codepoint < 0x10000) {
+            out += (char)(0xE0 | (codepoint >> 12));
+            out += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+            out += (char)(0x80 | (codepoint & 0x3F));
+        } else {
+            out += (char)(0xF0 | (codepoint >> 18));
+            out += (char)(0x80 | ((codepoint >> 12) & 0x3F));
+            out += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+            out += (char)(0x80 | (codepoint & 0x3F));
+        }
+    }
+
+    bool hex4(unsigned& value)
+    {
+        if (end - p < 4)
+            return fail("truncated \\u escape");
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = *p++;
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= c - '0';
+            else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+            else return fail("invalid \\u escape");
+        }
+        return true;
+    }
+
+    bool parseString(std::string& out)
+    {
+        ++p; // opening quote
+        out.clear();
+        for (;;) {
+            // Copy unescaped runs in one go
+            const char* run = p;
+            while (p < end && *p != '"' && *p != '\\')
+                ++p;
+            out.append(run, p);
+            if (p >= end)
+                return fail("unterminated string");
+            if (*p == '"') {
+                ++p;
+                return true;
+            }
+            ++p; // backslash
+            if (p >= end)
+                return fail("unterminated string");
+            char c = *p++;
+            switch (c) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                unsigned codepoint = 0;
+                if (!hex4(codepoint))
+                    return false;
+                // Surrogate pair
+                if (codepoint >= 0xD800 && codepoint < 0xDC00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                    p += 2;
+                    unsigned low = 0;
+                    if (!hex4(low))
+                        return false;
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(out, codepoint);
+                break;
+            }
+            default:
+                return fail("invalid escape");
+            }
+        }
+    }
+
+    bool parseNumber(JsonValue& value)
+    {
+        // strtod needs a terminator; numbers are short, copy into a local buffer
+        char buffer[64];
+        size_t length = 0;
+        while (p < end && length + 1 < sizeof(buffer) && strchr("+-0123456789.eE", *p))
+            buffer[length++] = *p++;
+        buffer[length] = '\0';
+        char* parsedEnd = nullptr;
+        value.number = strtod(buffer, &parsedEnd);
+        if (length == 0 || parsedEnd != buffer + length)
+            return fail("invalid number");
+        value.type = JsonType::Number;
+        return true;
+    }
+
+    bool parseValue(JsonValue& value)
+    {
+        skipWhitespace();
+        if (p >= end)
+            return fail("unexpected end of input");
+        if (++depth > 256)
+            return fail("nesting too deep");
+
+        bool ok = true;
+        switch (*p) {
+        case '{': {
+            value.type = JsonType::Object;
+            ++p;
+            skipWhitespace();
+            if (p < end && *p == '}') {
+                ++p;
+                break;
+            }
+            for (;;) {
+                skipWhitespace();
+                if (p >= end || *p != '"') {
+                    ok = fail("expected member name");
+                    break;
+                }
+                value.members.emplace_back();
+                auto& member = value.members.back();
+                if (!parseString(member.first)) {
+                    ok = false;
+                    break;
+                }
+                skipWhitespace();
+                if (p >= end || *p != ':') {
+                    ok = fail("expected ':'");
+                    break;
+                }
+                ++p;
+                if (!parseValue(member.second)) {
+                    ok = false;
+                    break;
+                }
+                skipWhitespace();
+                if (p < end && *p == ',') {
+                    ++p;
+                    continue;
+                }
+                if (p < end && *p == '}') {
+                    ++p;
+                    break;
+                }
+                ok = fail("expected ',' or '}'");
+                break;
+            }
+            break;
+        }
+        case '[': {
+            value.type = JsonType::Array;
+            ++p;
+            skipWhitespace();
+            if (p < end && *p == ']') {
+                ++p;
+                break;
+            }
+            for (;;) {
+                value.items.emplace_back();
+                if (!parseValue(value.items.back())) {
+                    ok = false;
+                    break;
+                }
+                skipWhitespace();
+                if (p < end && *p == ',') {
+                    ++p;
+                    continue;
+                }
+                if (p < end && *p == ']') {
+                    ++p;
+                    break;
+                }
+                ok = fail("expected ',' or ']'");
+                break;
+            }
+            break;
+        }
+        case '"':
+            value.type = JsonType::String;
+            ok = parseString(value.string);
+            break;
+        case 't':
+            value.type = JsonType::Bool;
+            value.boolean = true;
+            ok = literal("true");
+            break;
+        case 'f':
+            value.type = JsonType::Bool;
+            ok = literal("false");
+            break;
+        case 'n':
+            ok = literal("null");
+            break;
+        default:
+            ok = parseNumber(value);
+            break;
+        }
+        --depth;
+        return ok;
+    }
+};
+
+} // namespace
+
+bool parseJson(const char* text, size_t length, JsonValue& root, std::string& error)
+{
+    JsonParser parser{text, text + length, std::string()};
+    root = JsonValue();
+    bool ok = parser.parseValue(root);
+    if (ok) {
+        parser.skipWhitespace();
+        // GLB pads the JSON chunk with spaces, but nothing else may follow the document
+        if (parser.p != parser.end && *parser.p != '\0')
+            ok = parser.fail("trailing characters");
+    }
+    if (!ok)
+        error = parser.error + " at offset " + std::to_string(parser.p - text);
+    return ok;
+}
+
+void writeJsonString(std::ostream& out, const char* text)
+{
+    out << '"';
+    for (const char* c = text; c != nullptr && *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\')
+            out << '\\';
+        if ((unsigned char)*c >= 0x20)
+            out << *c;
+    }
+    out << '"';
+}
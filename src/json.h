@@ -0,0 +1,51 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <climits>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal DOM JSON reader, enough for asset manifests such as glTF.
+// Strings are unescaped (\uXXXX becomes UTF-8); numbers are doubles.
+
+enum class JsonType { Null, Bool, Number, String, Array, Object };
+
+struct JsonValue {
+    JsonType type = JsonType::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> items;                           // Array
+    std::vector<std::pair<std::string, JsonValue>> members; // Object, in file order
+
+    // Member lookup; returns a shared null value when missing or not an object
+    const JsonValue& operator[](const char* key) const;
+    // Array element; null value when out of range or not an array
+    const JsonValue& operator[](size_t index) const;
+    // Negative indices (e.g. a missing glTF reference read as -1) give the null value
+    const JsonValue& operator[](int index) const { return (*this)[index < 0 ? (size_t)-1 : (size_t)index]; }
+
+    bool isNull() const { return type == JsonType::Null; }
+    size_t size() const { return type == JsonType::Array ? items.size() : members.size(); }
+
+    double asNumber(double fallback = 0.0) const { return type == JsonType::Number ? number : fallback; }
+    // Fallback too for numbers that aren't an int exactly (fractions, out of range)
+    int asInt(int fallback = -1) const
+    {
+        return type == JsonType::Number && number >= INT_MIN && number <= INT_MAX && number == (int)number ? (int)number
+                                                                                                         : fallback;
+    }
+    bool asBool(bool fallback = false) const { return type == JsonType::Bool ? boolean : fallback; }
+    const std::string& asString() const { return string; }
+};
+
+// Parses a complete document; on failure returns false and describes the problem in error
+bool parseJson(const char* text, size_t length, JsonValue& root, std::string& error);
+
+// Writes text as a quoted JSON string; null writes "" (e.g. a failed glGetString)
+void writeJsonString(std::ostream& out, const char* text);
+
+#endif // JSON_H
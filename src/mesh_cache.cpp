@@ -0,0 +1,155 @@
+#include "mesh_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+static_assert(sizeof(MeshCacheHeader) == 88, "MeshCacheHeader layout is part of the file format");
+static_assert(sizeof(MeshCacheLod) == 16, "MeshCacheLod layout is part of the file format");
+static_assert(sizeof(Meshlet) == 52, "Meshlet layout is part of the file format");
+
+static uint64_t alignUp(uint64_t value)
+{
+    return (value + meshCacheAlignment - 1) / meshCacheAlignment * meshCacheAlignment;
+}
+
+static bool hostIsLittleEndian()
+{
+    uint16_t probe = 1;
+    return *(const unsigned char*)&probe == 1;
+}
+
+static bool writePadding(FILE* file, uint64_t from, uint64_t to)
+{
+    static const char zeros[meshCacheAlignment] = {};
+    return to == from || fwrite(zeros, 1, (size_t)(to - from), file) == to - from;
+}
+
+bool writeMeshCache(const char* path, const MeshData& mesh)
+{
+    if (!hostIsLittleEndian()) {
+        std::cerr << "Mesh cache is little endian only" << std::endl;
+        return false;
+    }
+
+    std::vector<MeshCacheLod> lods;
+    if (mesh.lods.empty()) {
+        lods.push_back({0, (uint32_t)mesh.indices.size(), 0.0f, 0});
+    } else {
+        for (const MeshLod& lod : mesh.lods)
+            lods.push_back({lod.firstIndex, lod.indexCount, lod.error, 0});
+    }
+
+    MeshCacheHeader header = {};
+    header.magic = meshCacheMagic;
+    header.version = meshCacheVersion;
+    header.headerSize = sizeof(MeshCacheHeader);
+    header.vertexStride = 8 * sizeof(float);
+    header.vertexCount = mesh.vertexCount();
+    header.indexCount = mesh.indices.size();
+    uint64_t lodEnd = sizeof(MeshCacheHeader) + lods.size() * sizeof(MeshCacheLod);
+    header.vertexOffset = alignUp(lodEnd);
+    header.indexOffset = alignUp(header.vertexOffset + header.vertexCount * header.vertexStride);
+    memcpy(header.boundsMin, mesh.boundsMin, sizeof(header.boundsMin));
+    memcpy(header.boundsMax, mesh.boundsMax, sizeof(header.boundsMax));
+    header.lodCount = (uint32_t)lods.size();
+    header.meshletCount = (uint32_t)mesh.meshlets.size();
+    uint64_t indexEnd = header.indexOffset + header.indexCount * sizeof(uint32_t);
+    header.meshletOffset = mesh.meshlets.empty() ? indexEnd : alignUp(indexEnd);
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        std::cerr << "Unable to write mesh cache: " << path << std::endl;
+        return false;
+    }
+    uint64_t vertexBytes = header.vertexCount * header.vertexStride;
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(lods.data(), sizeof(MeshCacheLod), lods.size(), file) == lods.size() &&
+              writePadding(file, lodEnd, header.vertexOffset) &&
+              fwrite(mesh.vertices.data(), 1, (size_t)vertexBytes, file) == vertexBytes &&
+              writePadding(file, header.vertexOffset + vertexBytes, header.indexOffset) &&
+              fwrite(mesh.indices.data(), sizeof(uint32_t), mesh.indices.size(), file) == mesh.indices.size() &&
+              writePadding(file, indexEnd, header.meshletOffset) &&
+              fwrite(mesh.meshlets.data(), sizeof(Meshlet), mesh.meshlets.size(), file) == mesh.meshlets.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        std::cerr << "Unable to write mesh cache: " << path << std::endl;
+        remove(path);
+    }
+    return ok;
+}
+
+bool openMeshCache(const char* path, MeshCacheFile& cache)
+{
+    cache.header = nullptr;
+    cache.lods = nullptr;
+    cache.vertices = nullptr;
+    cache.indices = nullptr;
+    cache.meshlets = nullptr;
+    if (!cache.file.open(path)) {
+        std::cerr << "Unable to open mesh cache: " << path << std::endl;
+        return false;
+    }
+
+    const char* data = cache.file.data;
+    uint64_t size = cache.file.size;
+    const MeshCacheHeader* header = (const MeshCacheHeader*)data;
+    bool valid = hostIsLittleEndian() && size >= sizeof(MeshCacheHeader) &&
+                 header->magic == meshCacheMagic && header->version == meshCacheVersion &&
+                 header->headerSize == sizeof(MeshCacheHeader) && header->vertexStride == 8 * sizeof(float) &&
+                 header->lodCount >= 1;
+    // Every blob has to be inside the file and aligned (the mapping itself is page aligned).
+    // Offsets and counts come from the file: compare against what is left so nothing can wrap.
+    valid = valid && header->vertexOffset <= size && header->indexOffset <= size && header->meshletOffset <= size &&
+            sizeof(MeshCacheHeader) + (uint64_t)header->lodCount * sizeof(MeshCacheLod) <= header->vertexOffset &&
+            header->vertexOffset % meshCacheAlignment == 0 && header->indexOffset % meshCacheAlignment == 0 &&
+            header->meshletOffset % 4 == 0 &&
+            header->vertexCount <= (size - header->vertexOffset) / header->vertexStride &&
+            header->vertexOffset + header->vertexCount * header->vertexStride <= header->indexOffset &&
+            header->indexCount <= (size - header->indexOffset) / sizeof(uint32_t) &&
+            header->indexOffset + header->indexCount * sizeof(uint32_t) <= header->meshletOffset &&
+            header->meshletCount <= (size - header->meshletOffset) / sizeof(Meshlet);
+    if (!valid) {
+        std::cerr << "Invalid or outdated mesh cache: " << path << std::endl;
+        cache.file.close();
+        return false;
+    }
+
+    const MeshCacheLod* lods = (const MeshCacheLod*)(data + sizeof(MeshCacheHeader));
+    for (uint32_t i = 0; i < header->lodCount; ++i) {
+        if ((uint64_t)lods[i].firstIndex + lods[i].indexCount > header->indexCount) {
+            std::cerr << "Invalid LOD table in mesh cache: " << path << std::endl;
+            cache.file.close();
+            return false;
+        }
+    }
+
+    // Indices feed CPU-side meshlet culling and glDrawElements as they are
+    const uint32_t* indices = (const uint32_t*)(data + header->indexOffset);
+    uint32_t maxIndex = 0;
+    for (uint64_t i = 0; i < header->indexCount; ++i)
+        maxIndex = std::max(maxIndex, indices[i]);
+    if (header->indexCount > 0 && maxIndex >= header->vertexCount) {
+        std::cerr << "Invalid index data in mesh cache: " << path << std::endl;
+        cache.file.close();
+        return false;
+    }
+
+    const Meshlet* meshlets = (const Meshlet*)(data + header->meshletOffset);
+    for (uint32_t i = 0; i < header->meshletCount; ++i) {
+        if ((uint64_t)meshlets[i].firstIndex + meshlets[i].indexCount > header->indexCount ||
+            (i > 0 && meshlets[i].firstIndex < meshlets[i - 1].firstIndex)) {
+            std::cerr << "Invalid meshlet table in mesh cache: " << path << std::endl;
+            cache.file.close();
+            return false;
+        }
+    }
+
+    cache.header = header;
+    cache.lods = lods;
+    cache.vertices = (const float*)(data + header->vertexOffset);
+    cache.indices = indices;
+    cache.meshlets = header->meshletCount ? meshlets : nullptr;
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include "mapped_file.h"
+#include "mesh_loader.h"
+
+#include <cstdint>
+
+// Binary mesh container (*.mesh), laid out so a mapped file can be handed
+// straight to glBufferData:
+//
+//   MeshCacheHeader | MeshCacheLod[lodCount] | pad | vertices | pad | indices
+//   | pad | Meshlet[meshletCount]
+//
+// Vertices are the 8-float initVAOs() layout, indices are uint32, meshlets
+// are the struct from mesh_loader.h; every blob starts on a 64-byte boundary.
+// All fields are little endian.
+
+const uint32_t meshCacheMagic = 0x4853454Du; // "MESH"
+const uint32_t meshCacheVersion = 3; // 2: LOD chains from mesh_simplify.h, 3: meshlets
+const uint32_t meshCacheAlignment = 64;
+
+struct MeshCacheLod {
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    float error;
+    uint32_t reserved;
+};
+
+struct MeshCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;   // sizeof(MeshCacheHeader), rejects layout mismatches
+    uint32_t vertexStride; // bytes per vertex (32)
+    uint64_t vertexCount;
+    uint64_t indexCount;   // all LODs
+    uint64_t vertexOffset; // from the start of the file
+    uint64_t indexOffset;
+    float boundsMin[3];
+    float boundsMax[3];
+    uint32_t lodCount;     // at least 1
+    uint32_t meshletCount; // 0 if the mesh has no meshlets
+    uint64_t meshletOffset;
+};
+
+// Read-only view into a mapped cache file; the pointers live as long as the mapping
+struct MeshCacheFile {
+    MappedFile file;
+    const MeshCacheHeader* header = nullptr;
+    const MeshCacheLod* lods = nullptr;
+    const float* vertices = nullptr;
+    const uint32_t* indices = nullptr;
+    const Meshlet* meshlets = nullptr;
+};
+
+bool writeMeshCache(const char* path, const MeshData& mesh);
+
+// Maps and validates a cache file (header, offsets, LOD and meshlet ranges, and every
+// index against the vertex count). No data is copied or converted.
+bool openMeshCache(const char* path, MeshCacheFile& cache);
+
+#endif // MESH_CACHE_H
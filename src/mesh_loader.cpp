@@ -0,0 +1,914 @@
+#include "mesh_loader.h"
+#include "cpu_profiler.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+// Small files are not worth a thread each
+static const size_t minBytesPerThread = 1 << 20;
+
+static int loaderThreadCount(size_t bytes)
+{
+    int hardware = std::max(1, (int)std::thread::hardware_concurrency());
+    return (int)std::max<size_t>(1, std::min<size_t>(hardware, bytes / minBytesPerThread));
+}
+
+// Runs fn(0..count-1), one task per thread, the last one on the calling thread
+template <typename F>
+static void parallelFor(int count, F fn)
+{
+    std::vector<std::thread> workers;
+    for (int i = 0; i + 1 < count; ++i)
+        workers.emplace_back(fn, i);
+    if (count > 0)
+        fn(count - 1);
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+// --- Number parsing: locale-independent, no allocation, no null terminator needed ---
+
+static const double powersOf10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static inline bool isDigit(char c)
+{
+    return (unsigned)(c - '0') < 10u;
+}
+
+// Returns the position after the number, or p itself if there is no number
+static const char* parseFloat(const char* p, const char* end, float& out)
+{
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0; // significant digits kept in the mantissa
+    bool any = false;
+    for (; p < end && isDigit(*p); ++p) {
+        any = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits += mantissa != 0;
+        } else {
+            exponent++;
+        }
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        for (; p < end && isDigit(*p); ++p) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += mantissa != 0;
+                exponent--;
+            }
+        }
+    }
+    if (!any)
+        return start;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        bool negativeExponent = false;
+        if (q < end && (*q == '-' || *q == '+')) {
+            negativeExponent = *q == '-';
+            ++q;
+        }
+        if (q < end && isDigit(*q)) {
+            int e = 0;
+            for (; q < end && isDigit(*q); ++q)
+                e = std::min(e * 10 + (*q - '0'), 10000);
+            exponent += negativeExponent ? -e : e;
+            p = q;
+        }
+    }
+
+    double value = (double)mantissa;
+    if (exponent < 0)
+        value = exponent >= -22 ? value / powersOf10[-exponent] : value * std::pow(10.0, exponent);
+    else if (exponent > 0)
+        value = exponent <= 22 ? value * powersOf10[exponent] : value * std::pow(10.0, exponent);
+    out = (float)(negative ? -value : value);
+    return p;
+}
+
+static const char* parseInt(const char* p, const char* end, long long& out)
+{
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+    if (p >= end || !isDigit(*p))
+        return start;
+    // Saturates instead of overflowing; callers range-check the result anyway
+    long long value = 0;
+    for (; p < end && isDigit(*p); ++p)
+        if (value < 100000000000000000ll)
+            value = value * 10 + (*p - '0');
+    out = negative ? -value : value;
+    return p;
+}
+
+static inline const char* skipSpaces(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+        ++p;
+    return p;
+}
+
+// --- Shared helpers ---
+
+// Area-weighted smooth normals: accumulates face normals per position, then normalizes
+static void accumulateNormals(const float* positions, size_t stride, size_t positionCount,
+                              const uint32_t* indices, size_t indexCount, std::vector<float>& normals)
+{
+    normals.assign(positionCount * 3, 0.0f);
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        const float* a = positions + indices[i] * stride;
+        const float* b = positions + indices[i + 1] * stride;
+        const float* c = positions + indices[i + 2] * stride;
+        float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+        for (int k = 0; k < 3; ++k) {
+            float* target = &normals[indices[i + k] * 3];
+            target[0] += n[0];
+            target[1] += n[1];
+            target[2] += n[2];
+        }
+    }
+    for (size_t i = 0; i < positionCount; ++i) {
+        float* n = &normals[i * 3];
+        float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length > 0.0f) {
+            n[0] /= length;
+            n[1] /= length;
+            n[2] /= length;
+        } else {
+            n[1] = 1.0f;
+        }
+    }
+}
+
+void computeMeshBounds(MeshData& mesh)
+{
+    size_t count = mesh.vertexCount();
+    for (int k = 0; k < 3; ++k) {
+        mesh.boundsMin[k] = count ? mesh.vertices[k] : 0.0f;
+        mesh.boundsMax[k] = count ? mesh.vertices[k] : 0.0f;
+    }
+    for (size_t i = 1; i < count; ++i) {
+        const float* p = &mesh.vertices[i * 8];
+        for (int k = 0; k < 3; ++k) {
+            mesh.boundsMin[k] = std::min(mesh.boundsMin[k], p[k]);
+            mesh.boundsMax[k] = std::max(mesh.boundsMax[k], p[k]);
+        }
+    }
+}
+
+void computeMeshNormals(MeshData& mesh)
+{
+    std::vector<float> normals;
+    size_t vertexCount = mesh.vertexCount();
+    accumulateNormals(mesh.vertices.data(), 8, vertexCount, mesh.indices.data(), mesh.indices.size(), normals);
+    for (size_t i = 0; i < vertexCount; ++i)
+        memcpy(&mesh.vertices[i * 8 + 3], &normals[i * 3], 3 * sizeof(float));
+}
+
+// --- OBJ ---
+
+enum OBJCornerFlags {
+    OBJCorner_HasTexcoord = 1 << 0,
+    OBJCorner_HasNormal = 1 << 1,
+    // Negative OBJ indices are relative to the elements seen so far; a chunk only
+    // knows its own count, so they are stored chunk-relative until resolved
+    OBJCorner_RelativePosition = 1 << 2,
+    OBJCorner_RelativeTexcoord = 1 << 3,
+    OBJCorner_RelativeNormal = 1 << 4,
+};
+
+// After resolveOBJChunk(): 0-based global indices, -1 when absent
+struct OBJCorner {
+    int32_t v = 0;
+    int32_t vt = -1;
+    int32_t vn = -1;
+    uint32_t flags = 0;
+};
+
+struct OBJChunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    std::vector<float> positions; // 3 per element
+    std::vector<float> texcoords; // 2 per element
+    std::vector<float> normals;   // 3 per element
+    std::vector<OBJCorner> corners; // 3 per triangle
+    size_t positionBase = 0, texcoordBase = 0, normalBase = 0;
+    bool failed = false;
+};
+
+// OBJ indices are 1-based, negative ones count back from the last element.
+// Fails for 0 and for anything the int32 corner fields can't hold.
+static bool setOBJIndex(int32_t& target, long long index, size_t localCount, uint32_t relativeFlag, uint32_t& flags)
+{
+    if (index > 0 && index <= INT32_MAX) {
+        target = (int32_t)(index - 1);
+        return true;
+    }
+    long long relative = (long long)localCount + index;
+    if (index < 0 && relative >= INT32_MIN && relative <= INT32_MAX) {
+        target = (int32_t)relative;
+        flags |= relativeFlag;
+        return true;
+    }
+    return false;
+}
+
+static void parseOBJChunk(OBJChunk& chunk)
+{
+    CPU_PROFILE_FUNCTION();
+    // Rough reservation from typical line lengths, avoids most regrowth
+    size_t estimate = (size_t)(chunk.end - chunk.begin) / 32;
+    chunk.positions.reserve(estimate);
+    chunk.corners.reserve(estimate);
+
+    const char* p = chunk.begin;
+    while (p < chunk.end) {
+        const char* lineEnd = (const char*)memchr(p, '\n', chunk.end - p);
+        if (!lineEnd)
+            lineEnd = chunk.end;
+        const char* next = lineEnd + (lineEnd < chunk.end ? 1 : 0);
+        if (lineEnd > p && lineEnd[-1] == '\r')
+            --lineEnd;
+
+        p = skipSpaces(p, lineEnd);
+        if (p + 1 < lineEnd && p[0] == 'v') {
+            float values[3] = {0.0f, 0.0f, 0.0f};
+            int wanted = p[1] == 't' ? 2 : 3;
+            const char* q = p + (p[1] == ' ' || p[1] == '\t' ? 1 : 2);
+            for (int i = 0; i < wanted; ++i)
+                q = parseFloat(skipSpaces(q, lineEnd), lineEnd, values[i]);
+            if (p[1] == ' ' || p[1] == '\t')
+                chunk.positions.insert(chunk.positions.end(), values, values + 3);
+            else if (p[1] == 't')
+                chunk.texcoords.insert(chunk.texcoords.end(), values, values + 2);
+            else if (p[1] == 'n')
+                chunk.normals.insert(chunk.normals.end(), values, values + 3);
+        } else if (p + 1 < lineEnd && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+            size_t positionCount = chunk.positions.size() / 3;
+            size_t texcoordCount = chunk.texcoords.size() / 2;
+            size_t normalCount = chunk.normals.size() / 3;
+            OBJCorner first, previous;
+            int cornerCount = 0;
+            const char* q = p + 1;
+            for (;;) {
+                q = skipSpaces(q, lineEnd);
+                if (q >= lineEnd)
+                    break;
+                OBJCorner corner;
+                long long index = 0;
+                const char* after = parseInt(q, lineEnd, index);
+                if (after == q || !setOBJIndex(corner.v, index, positionCount, OBJCorner_RelativePosition, corner.flags)) {
+                    chunk.failed = true;
+                    return;
+                }
+                q = after;
+                if (q < lineEnd && *q == '/') {
+                    ++q;
+                    after = parseInt(q, lineEnd, index);
+                    if (after != q && setOBJIndex(corner.vt, index, texcoordCount, OBJCorner_RelativeTexcoord, corner.flags))
+                        corner.flags |= OBJCorner_HasTexcoord;
+                    q = after;
+                    if (q < lineEnd && *q == '/') {
+                        ++q;
+                        after = parseInt(q, lineEnd, index);
+                        if (after != q && setOBJIndex(corner.vn, index, normalCount, OBJCorner_RelativeNormal, corner.flags))
+                            corner.flags |= OBJCorner_HasNormal;
+                        q = after;
+                    }
+                }
+                // Skip anything unexpected up to the next corner
+                while (q < lineEnd && *q != ' ' && *q != '\t')
+                    ++q;
+
+                // Fan triangulation
+                if (cornerCount == 0)
+                    first = corner;
+                if (cornerCount >= 2) {
+                    chunk.corners.push_back(first);
+                    chunk.corners.push_back(previous);
+                    chunk.corners.push_back(corner);
+                }
+                previous = corner;
+                cornerCount++;
+            }
+        }
+        // Comments, groups, materials, smoothing groups, lines and points are ignored
+        p = next;
+    }
+}
+
+static bool resolveOBJChunk(OBJChunk& chunk, size_t positionCount, size_t texcoordCount, size_t normalCount)
+{
+    for (OBJCorner& corner : chunk.corners) {
+        long long v = corner.v + ((corner.flags & OBJCorner_RelativePosition) ? (long long)chunk.positionBase : 0);
+        long long vt = corner.vt + ((corner.flags & OBJCorner_RelativeTexcoord) ? (long long)chunk.texcoordBase : 0);
+        long long vn = corner.vn + ((corner.flags & OBJCorner_RelativeNormal) ? (long long)chunk.normalBase : 0);
+        if (v < 0 || v >= (long long)positionCount || v > INT32_MAX)
+            return false;
+        corner.v = (int32_t)v;
+        corner.vt = (corner.flags & OBJCorner_HasTexcoord) && vt >= 0 && vt < (long long)texcoordCount && vt <= INT32_MAX
+                        ? (int32_t)vt : -1;
+        corner.vn = (corner.flags & OBJCorner_HasNormal) && vn >= 0 && vn < (long long)normalCount && vn <= INT32_MAX
+                        ? (int32_t)vn : -1;
+        corner.flags = 0;
+    }
+    return true;
+}
+
+// Open-addressing (linear probing) map from a v/vt/vn triple to the welded vertex index
+class CornerWeldMap {
+public:
+    explicit CornerWeldMap(size_t expected)
+    {
+        size_t capacity = 1024;
+        while (capacity < expected * 2)
+            capacity *= 2;
+        slots.assign(capacity, Slot());
+    }
+
+    // Returns the vertex index for the corner, inserting nextIndex if it is new
+    uint32_t findOrInsert(const OBJCorner& corner, uint32_t nextIndex, bool& inserted)
+    {
+        if ((used + 1) * 10 > slots.size() * 7)
+            grow();
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash(corner) & mask;; i = (i + 1) & mask) {
+            Slot& slot = slots[i];
+            if (slot.index == emptySlot) {
+                slot.v = corner.v;
+                slot.vt = corner.vt;
+                slot.vn = corner.vn;
+                slot.index = nextIndex;
+                used++;
+                inserted = true;
+                return nextIndex;
+            }
+            if (slot.v == corner.v && slot.vt == corner.vt && slot.vn == corner.vn) {
+                inserted = false;
+                return slot.index;
+            }
+        }
+    }
+
+private:
+    static const uint32_t emptySlot = 0xFFFFFFFFu;
+
+    struct Slot {
+        int32_t v = 0, vt = 0, vn = 0;
+        uint32_t index = emptySlot;
+    };
+
+    std::vector<Slot> slots;
+    size_t used = 0;
+
+    static size_t hash(const OBJCorner& corner)
+    {
+        uint64_t h = (uint64_t)(uint32_t)corner.v * 0x9E3779B97F4A7C15ull;
+        h ^= (uint64_t)(uint32_t)corner.vt * 0xC2B2AE3D27D4EB4Full;
+        h ^= (uint64_t)(uint32_t)corner.vn * 0x165667B19E3779F9ull;
+        return (size_t)(h ^ (h >> 29));
+    }
+
+    void grow()
+    {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.assign(old.size() * 2, Slot());
+        size_t mask = slots.size() - 1;
+        for (const Slot& slot : old) {
+            if (slot.index == emptySlot)
+                continue;
+            OBJCorner corner;
+            corner.v = slot.v;
+            corner.vt = slot.vt;
+            corner.vn = slot.vn;
+            size_t i = hash(corner) & mask;
+            while (slots[i].index != emptySlot)
+                i = (i + 1) & mask;
+            slots[i] = slot;
+        }
+    }
+};
+
+bool loadOBJ(const char* path, MeshData& mesh, MeshLoadStats* stats)
+{
+    CPU_PROFILE_FUNCTION();
+    MeshLoadStats localStats;
+    MeshLoadStats& s = stats ? *stats : localStats;
+
+    auto mapBegin = Clock::now();
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Unable to open mesh: " << path << std::endl;
+        return false;
+    }
+    s.fileBytes = file.size;
+    s.mapMs = elapsedMs(mapBegin);
+
+    // Split into chunks at line boundaries, one per thread
+    auto parseBegin = Clock::now();
+    int threads = loaderThreadCount(file.size);
+    std::vector<OBJChunk> chunks(threads);
+    const char* fileEnd = file.data + file.size;
+    const char* chunkBegin = file.data;
+    for (int i = 0; i < threads; ++i) {
+        const char* chunkEnd = i + 1 == threads ? fileEnd : file.data + file.size * (i + 1) / threads;
+        if (chunkEnd < chunkBegin)
+            chunkEnd = chunkBegin;
+        if (chunkEnd < fileEnd) {
+            const char* newline = (const char*)memchr(chunkEnd, '\n', fileEnd - chunkEnd);
+            chunkEnd = newline ? newline + 1 : fileEnd;
+        }
+        chunks[i].begin = chunkBegin;
+        chunks[i].end = chunkEnd;
+        chunkBegin = chunkEnd;
+    }
+    parallelFor(threads, [&](int i) { parseOBJChunk(chunks[i]); });
+    s.threads = threads;
+
+    size_t positionCount = 0, texcoordCount = 0, normalCount = 0, cornerCount = 0;
+    for (OBJChunk& chunk : chunks) {
+        if (chunk.failed) {
+            std::cerr << "Malformed face in " << path << std::endl;
+            return false;
+        }
+        chunk.positionBase = positionCount;
+        chunk.texcoordBase = texcoordCount;
+        chunk.normalBase = normalCount;
+        positionCount += chunk.positions.size() / 3;
+        texcoordCount += chunk.texcoords.size() / 2;
+        normalCount += chunk.normals.size() / 3;
+        cornerCount += chunk.corners.size();
+    }
+
+    std::vector<bool> resolved(threads);
+    parallelFor(threads, [&](int i) { resolved[i] = resolveOBJChunk(chunks[i], positionCount, texcoordCount, normalCount); });
+    s.parseMs = elapsedMs(parseBegin);
+    if (std::find(resolved.begin(), resolved.end(), false) != resolved.end()) {
+        std::cerr << "Face index out of range in " << path << std::endl;
+        return false;
+    }
+    if (cornerCount == 0) {
+        std::cerr << "No faces in " << path << std::endl;
+        return false;
+    }
+
+    auto weldBegin = Clock::now();
+    // Gather the attribute streams so indices can address them directly
+    std::vector<float> positions, texcoords, normals;
+    positions.reserve(positionCount * 3);
+    texcoords.reserve(texcoordCount * 2);
+    normals.reserve(normalCount * 3);
+    bool missingNormals = false;
+    for (OBJChunk& chunk : chunks) {
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        texcoords.insert(texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+        for (const OBJCorner& corner : chunk.corners)
+            missingNormals = missingNormals || corner.vn < 0;
+    }
+
+    std::vector<float> generatedNormals;
+    if (missingNormals) {
+        std::vector<uint32_t> positionIndices;
+        positionIndices.reserve(cornerCount);
+        for (const OBJChunk& chunk : chunks)
+            for (const OBJCorner& corner : chunk.corners)
+                positionIndices.push_back((uint32_t)corner.v);
+        accumulateNormals(positions.data(), 3, positionCount, positionIndices.data(), positionIndices.size(),
+                          generatedNormals);
+    }
+
+    mesh = MeshData();
+    mesh.indices.reserve(cornerCount);
+    mesh.vertices.reserve(positionCount * 8);
+    CornerWeldMap weldMap(positionCount);
+    for (const OBJChunk& chunk : chunks) {
+        for (const OBJCorner& corner : chunk.corners) {
+            bool inserted = false;
+            uint32_t index = weldMap.findOrInsert(corner, (uint32_t)mesh.vertexCount(), inserted);
+            mesh.indices.push_back(index);
+            if (!inserted)
+                continue;
+            const float* position = &positions[(size_t)corner.v * 3];
+            const float* normal = corner.vn >= 0 ? &normals[(size_t)corner.vn * 3] : &generatedNormals[(size_t)corner.v * 3];
+            float vertex[8] = {position[0], position[1], position[2], normal[0], normal[1], normal[2], 0.0f, 0.0f};
+            if (corner.vt >= 0) {
+                vertex[6] = texcoords[(size_t)corner.vt * 2];
+                vertex[7] = texcoords[(size_t)corner.vt * 2 + 1];
+            }
+            mesh.vertices.insert(mesh.vertices.end(), vertex, vertex + 8);
+        }
+    }
+    computeMeshBounds(mesh);
+    s.weldMs = elapsedMs(weldBegin);
+    return true;
+}
+
+// --- PLY ---
+
+enum class PlyType { Invalid, Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
+struct PlyProperty {
+    std::string name;
+    PlyType type = PlyType::Invalid;
+    PlyType countType = PlyType::Invalid; // list properties only
+    bool isList = false;
+};
+
+struct PlyElement {
+    std::string name;
+    size_t count = 0;
+    std::vector<PlyProperty> properties;
+};
+
+static PlyType plyTypeFromName(const std::string& name)
+{
+    if (name == "char" || name == "int8") return PlyType::Int8;
+    if (name == "uchar" || name == "uint8") return PlyType::UInt8;
+    if (name == "short" || name == "int16") return PlyType::Int16;
+    if (name == "ushort" || name == "uint16") return PlyType::UInt16;
+    if (name == "int" || name == "int32") return PlyType::Int32;
+    if (name == "uint" || name == "uint32") return PlyType::UInt32;
+    if (name == "float" || name == "float32") return PlyType::Float32;
+    if (name == "double" || name == "float64") return PlyType::Float64;
+    return PlyType::Invalid;
+}
+
+static size_t plyTypeSize(PlyType type)
+{
+    switch (type) {
+    case PlyType::Int8: case PlyType::UInt8: return 1;
+    case PlyType::Int16: case PlyType::UInt16: return 2;
+    case PlyType::Int32: case PlyType::UInt32: case PlyType::Float32: return 4;
+    case PlyType::Float64: return 8;
+    default: return 0;
+    }
+}
+
+// Reads one scalar, byte-swapping first when the file endianness differs from ours
+static double readPlyScalar(const char* p, PlyType type, bool swap)
+{
+    unsigned char bytes[8];
+    size_t size = plyTypeSize(type);
+    for (size_t i = 0; i < size; ++i)
+        bytes[i] = (unsigned char)p[swap ? size - 1 - i : i];
+    switch (type) {
+    case PlyType::Int8: { int8_t v; memcpy(&v, bytes, 1); return v; }
+    case PlyType::UInt8: return bytes[0];
+    case PlyType::Int16: { int16_t v; memcpy(&v, bytes, 2); return v; }
+    case PlyType::UInt16: { uint16_t v; memcpy(&v, bytes, 2); return v; }
+    case PlyType::Int32: { int32_t v; memcpy(&v, bytes, 4); return v; }
+    case PlyType::UInt32: { uint32_t v; memcpy(&v, bytes, 4); return v; }
+    case PlyType::Float32: { float v; memcpy(&v, bytes, 4); return v; }
+    case PlyType::Float64: { double v; memcpy(&v, bytes, 8); return v; }
+    default: return 0.0;
+    }
+}
+
+// List counts and vertex indices: false for negative or fractional values and
+// for anything past uint32 (a count of 2^32 values can't be in the file anyway)
+static bool readPlyUnsigned(const char* p, PlyType type, bool swap, uint32_t& out)
+{
+    double value = readPlyScalar(p, type, swap);
+    if (!(value >= 0.0 && value <= 4294967295.0) || value != std::floor(value))
+        return false;
+    out = (uint32_t)value;
+    return true;
+}
+
+static int findPlyProperty(const PlyElement& element, std::initializer_list<const char*> names)
+{
+    for (const char* name : names)
+        for (size_t i = 0; i < element.properties.size(); ++i)
+            if (!element.properties[i].isList && element.properties[i].name == name)
+                return (int)i;
+    return -1;
+}
+
+bool loadPLY(const char* path, MeshData& mesh, MeshLoadStats* stats)
+{
+    CPU_PROFILE_FUNCTION();
+    MeshLoadStats localStats;
+    MeshLoadStats& s = stats ? *stats : localStats;
+
+    auto mapBegin = Clock::now();
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Unable to open mesh: " << path << std::endl;
+        return false;
+    }
+    s.fileBytes = file.size;
+    s.mapMs = elapsedMs(mapBegin);
+
+    auto parseBegin = Clock::now();
+    const char* p = file.data;
+    const char* end = file.data + file.size;
+    if (file.size < 4 || memcmp(p, "ply", 3) != 0) {
+        std::cerr << "Not a PLY file: " << path << std::endl;
+        return false;
+    }
+
+    // Header: plain text lines up to end_header
+    std::vector<PlyElement> elements;
+    bool bigEndian = false;
+    bool headerDone = false;
+    while (p < end && !headerDone) {
+        const char* lineEnd = (const char*)memchr(p, '\n', end - p);
+        if (!lineEnd)
+            break;
+        std::string line(p, lineEnd);
+        p = lineEnd + 1;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        std::vector<std::string> tokens;
+        size_t pos = 0;
+        while (pos < line.size()) {
+            size_t start = line.find_first_not_of(" \t", pos);
+            if (start == std::string::npos)
+                break;
+            size_t stop = line.find_first_of(" \t", start);
+            tokens.push_back(line.substr(start, stop - start));
+            pos = stop == std::string::npos ? line.size() : stop;
+        }
+        if (tokens.empty())
+            continue;
+
+        if (tokens[0] == "format" && tokens.size() >= 2) {
+            if (tokens[1] == "binary_big_endian") {
+                bigEndian = true;
+            } else if (tokens[1] != "binary_little_endian") {
+                std::cerr << "Only binary PLY is supported: " << path << std::endl;
+                return false;
+            }
+        } else if (tokens[0] == "element" && tokens.size() >= 3) {
+            PlyElement element;
+            element.name = tokens[1];
+            element.count = (size_t)strtoull(tokens[2].c_str(), nullptr, 10);
+            elements.push_back(element);
+        } else if (tokens[0] == "property" && !elements.empty()) {
+            PlyProperty property;
+            if (tokens.size() >= 5 && tokens[1] == "list") {
+                property.isList = true;
+                property.countType = plyTypeFromName(tokens[2]);
+                property.type = plyTypeFromName(tokens[3]);
+                property.name = tokens[4];
+            } else if (tokens.size() >= 3) {
+                property.type = plyTypeFromName(tokens[1]);
+                property.name = tokens[2];
+            }
+            if (property.type == PlyType::Invalid || (property.isList && property.countType == PlyType::Invalid)) {
+                std::cerr << "Unsupported PLY property type in " << path << std::endl;
+                return false;
+            }
+            elements.back().properties.push_back(property);
+        } else if (tokens[0] == "end_header") {
+            headerDone = true;
+        }
+    }
+    if (!headerDone) {
+        std::cerr << "Truncated PLY header: " << path << std::endl;
+        return false;
+    }
+
+    uint16_t endianProbe = 1;
+    bool hostLittleEndian = *(const unsigned char*)&endianProbe == 1;
+    bool swap = bigEndian == hostLittleEndian;
+
+    mesh = MeshData();
+    bool hasNormals = false;
+    bool truncated = false;
+    for (const PlyElement& element : elements) {
+        bool fixedSize = true;
+        size_t stride = 0;
+        for (const PlyProperty& property : element.properties) {
+            fixedSize = fixedSize && !property.isList;
+            stride += property.isList ? 0 : plyTypeSize(property.type);
+        }
+
+        if (element.name == "vertex") {
+            if (!fixedSize) {
+                std::cerr << "PLY vertex lists are not supported: " << path << std::endl;
+                return false;
+            }
+            if (stride > 0 && element.count > (size_t)(end - p) / stride) {
+                truncated = true;
+                break;
+            }
+            int x = findPlyProperty(element, {"x"});
+            int y = findPlyProperty(element, {"y"});
+            int z = findPlyProperty(element, {"z"});
+            int nx = findPlyProperty(element, {"nx"});
+            int ny = findPlyProperty(element, {"ny"});
+            int nz = findPlyProperty(element, {"nz"});
+            int u = findPlyProperty(element, {"u", "s", "texture_u", "texture_s"});
+            int v = findPlyProperty(element, {"v", "t", "texture_v", "texture_t"});
+            if (x < 0 || y < 0 || z < 0) {
+                std::cerr << "PLY vertices without x/y/z: " << path << std::endl;
+                return false;
+            }
+            hasNormals = nx >= 0 && ny >= 0 && nz >= 0;
+
+            int attributes[8] = {x, y, z, hasNormals ? nx : -1, hasNormals ? ny : -1, hasNormals ? nz : -1, u, v};
+            size_t offsets[8] = {};
+            PlyType types[8] = {};
+            for (int a = 0; a < 8; ++a) {
+                if (attributes[a] < 0)
+                    continue;
+                for (int i = 0; i < attributes[a]; ++i)
+                    offsets[a] += plyTypeSize(element.properties[i].type);
+                types[a] = element.properties[attributes[a]].type;
+            }
+
+            // Fixed stride: every thread converts its own range of vertices
+            mesh.vertices.resize(element.count * 8);
+            const char* base = p;
+            int threads = loaderThreadCount(element.count * stride);
+            s.threads = std::max(s.threads, threads);
+            parallelFor(threads, [&](int t) {
+                size_t first = element.count * t / threads;
+                size_t last = element.count * (t + 1) / threads;
+                for (size_t i = first; i < last; ++i) {
+                    const char* record = base + i * stride;
+                    float* out = &mesh.vertices[i * 8];
+                    for (int a = 0; a < 8; ++a)
+                        out[a] = attributes[a] >= 0 ? (float)readPlyScalar(record + offsets[a], types[a], swap) : 0.0f;
+                }
+            });
+            p += element.count * stride;
+        } else if (element.name == "face") {
+            int listIndex = -1;
+            for (size_t i = 0; i < element.properties.size(); ++i)
+                if (element.properties[i].isList &&
+                    (element.properties[i].name == "vertex_indices" || element.properties[i].name == "vertex_index"))
+                    listIndex = (int)i;
+            if (listIndex < 0) {
+                std::cerr << "PLY faces without vertex_indices: " << path << std::endl;
+                return false;
+            }
+            // Variable-length records: walked sequentially, every read checked
+            // against what is left. A face takes at least one byte.
+            mesh.indices.reserve(std::min(element.count, (size_t)(end - p)) * 3);
+            for (size_t f = 0; f < element.count && !truncated; ++f) {
+                for (size_t i = 0; i < element.properties.size(); ++i) {
+                    const PlyProperty& property = element.properties[i];
+                    size_t valueSize = plyTypeSize(property.type);
+                    if (!property.isList) {
+                        if ((size_t)(end - p) < valueSize) {
+                            truncated = true;
+                            break;
+                        }
+                        p += valueSize;
+                        continue;
+                    }
+                    size_t countSize = plyTypeSize(property.countType);
+                    uint32_t count = 0;
+                    if ((size_t)(end - p) < countSize || !readPlyUnsigned(p, property.countType, swap, count)) {
+                        truncated = true;
+                        break;
+                    }
+                    p += countSize;
+                    if (count > (size_t)(end - p) / valueSize) {
+                        truncated = true;
+                        break;
+                    }
+                    if ((int)i == listIndex) {
+                        // Unreadable indices become UINT32_MAX and fail the range check below
+                        uint32_t first = UINT32_MAX, previous = UINT32_MAX;
+                        for (size_t c = 0; c < count; ++c) {
+                            uint32_t index = UINT32_MAX;
+                            readPlyUnsigned(p + c * valueSize, property.type, swap, index);
+                            if (c == 0)
+                                first = index;
+                            if (c >= 2) {
+                                mesh.indices.push_back(first);
+                                mesh.indices.push_back(previous);
+                                mesh.indices.push_back(index);
+                            }
+                            previous = index;
+                        }
+                    }
+                    p += (size_t)count * valueSize;
+                }
+            }
+        } else {
+            // Unused element (edges, materials...): skip it
+            if (fixedSize) {
+                if (stride > 0 && element.count > (size_t)(end - p) / stride) {
+                    truncated = true;
+                    break;
+                }
+                p += element.count * stride;
+                continue;
+            }
+            for (size_t r = 0; r < element.count && !truncated; ++r) {
+                for (const PlyProperty& property : element.properties) {
+                    size_t size = property.isList ? plyTypeSize(property.countType) : plyTypeSize(property.type);
+                    if ((size_t)(end - p) < size) {
+                        truncated = true;
+                        break;
+                    }
+                    if (property.isList) {
+                        uint32_t count = 0;
+                        if (!readPlyUnsigned(p, property.countType, swap, count)) {
+                            truncated = true;
+                            break;
+                        }
+                        p += size;
+                        if (count > (size_t)(end - p) / plyTypeSize(property.type)) {
+                            truncated = true;
+                            break;
+                        }
+                        size = (size_t)count * plyTypeSize(property.type);
+                    }
+                    p += size;
+                }
+            }
+        }
+        if (truncated)
+            break;
+    }
+    s.parseMs = elapsedMs(parseBegin);
+
+    if (truncated) {
+        std::cerr << "Truncated or invalid PLY data: " << path << std::endl;
+        return false;
+    }
+    size_t vertexCount = mesh.vertexCount();
+    for (uint32_t index : mesh.indices) {
+        if (index >= vertexCount) {
+            std::cerr << "Face index out of range in " << path << std::endl;
+            return false;
+        }
+    }
+    if (mesh.indices.empty()) {
+        std::cerr << "No faces in " << path << std::endl;
+        return false;
+    }
+
+    // PLY vertices are already indexed, nothing to weld; only fill in missing normals
+    auto weldBegin = Clock::now();
+    if (!hasNormals)
+        computeMeshNormals(mesh);
+    computeMeshBounds(mesh);
+    s.weldMs = elapsedMs(weldBegin);
+    return true;
+}
+
+static bool hasExtension(const char* path, const char* extension)
+{
+    size_t pathLength = strlen(path), extensionLength = strlen(extension);
+    if (pathLength < extensionLength)
+        return false;
+    const char* tail = path + pathLength - extensionLength;
+    for (size_t i = 0; i < extensionLength; ++i)
+        if (tolower((unsigned char)tail[i]) != extension[i])
+            return false;
+    return true;
+}
+
+bool loadMesh(const char* path, MeshData& mesh, MeshLoadStats* stats)
+{
+    if (hasExtension(path, ".obj"))
+        return loadOBJ(path, mesh, stats);
+    if (hasExtension(path, ".ply"))
+        return loadPLY(path, mesh, stats);
+    std::cerr << "Unknown mesh format: " << path << std::endl;
+    return false;
+}
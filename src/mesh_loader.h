@@ -0,0 +1,69 @@
+#ifndef MESH_LOADER_H
+#define MESH_LOADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A level of detail: a range of MeshData::indices over the shared vertices
+struct MeshLod {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f; // geometric error relative to LOD 0, in model units
+};
+
+// A cluster of triangles (meshlet.h): a range of MeshData::indices inside one
+// LOD, with the bounds used to cull it. All fields are 4 bytes, the struct is
+// stored as is in the mesh cache.
+struct Meshlet {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float center[3] = {0.0f, 0.0f, 0.0f}; // bounding sphere
+    float radius = 0.0f;
+    // Normal cone: every triangle faces away from an eye at e when
+    // dot(normalize(coneApex - e), coneAxis) >= coneCutoff (> 1: never)
+    float coneApex[3] = {0.0f, 0.0f, 0.0f};
+    float coneAxis[3] = {0.0f, 0.0f, 0.0f};
+    float coneCutoff = 2.0f;
+};
+
+// Indexed triangle mesh in the vertex layout used by initVAOs():
+// 8 floats per vertex (position, normal, texcoord).
+struct MeshData {
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<MeshLod> lods; // empty: a single LOD covering all indices
+    std::vector<Meshlet> meshlets; // sorted by firstIndex, empty if not built
+    float boundsMin[3] = {0.0f, 0.0f, 0.0f};
+    float boundsMax[3] = {0.0f, 0.0f, 0.0f};
+
+    size_t vertexCount() const { return vertices.size() / 8; }
+    // Triangles of LOD 0
+    size_t triangleCount() const { return (lods.empty() ? indices.size() : lods[0].indexCount) / 3; }
+};
+
+struct MeshLoadStats {
+    size_t fileBytes = 0;
+    int threads = 0;
+    double mapMs = 0.0;   // open + mmap
+    double parseMs = 0.0; // text/binary parsing (multithreaded)
+    double weldMs = 0.0;  // index resolution, vertex welding, generated normals
+};
+
+// Loads a Wavefront OBJ (v/vt/vn/f, polygons are fan-triangulated) or a
+// binary PLY (little or big endian) through mmap. The file is parsed in
+// parallel, in chunks split at line boundaries; identical OBJ corners
+// (position/texcoord/normal triples) are welded into one vertex. Missing
+// normals are generated (area-weighted smooth normals), missing texcoords are 0.
+// Returns false and prints the reason on failure.
+bool loadMesh(const char* path, MeshData& mesh, MeshLoadStats* stats = nullptr);
+
+bool loadOBJ(const char* path, MeshData& mesh, MeshLoadStats* stats = nullptr);
+bool loadPLY(const char* path, MeshData& mesh, MeshLoadStats* stats = nullptr);
+
+// Recomputes boundsMin/boundsMax from the vertices
+void computeMeshBounds(MeshData& mesh);
+// Replaces the normals with area-weighted smooth normals
+void computeMeshNormals(MeshData& mesh);
+
+#endif // MESH_LOADER_H
@@ -0,0 +1,520 @@
+#include "mesh_simplify.h"
+#include "cpu_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+// Sum of squared distances to a set of planes, weighted by triangle area
+struct Quadric {
+    double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+    double c = 0.0;
+    double weight = 0.0;
+
+    // Plane n.p + d = 0 with a unit normal
+    void addPlane(double nx, double ny, double nz, double d, double w)
+    {
+        a00 += w * nx * nx; a01 += w * nx * ny; a02 += w * nx * nz;
+        a11 += w * ny * ny; a12 += w * ny * nz; a22 += w * nz * nz;
+        b0 += w * nx * d; b1 += w * ny * d; b2 += w * nz * d;
+        c += w * d * d;
+        weight += w;
+    }
+
+    void add(const Quadric& q)
+    {
+        a00 += q.a00; a01 += q.a01; a02 += q.a02;
+        a11 += q.a11; a12 += q.a12; a22 += q.a22;
+        b0 += q.b0; b1 += q.b1; b2 += q.b2;
+        c += q.c;
+        weight += q.weight;
+    }
+
+    double evaluate(const float* p) const
+    {
+        double x = p[0], y = p[1], z = p[2];
+        return a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+               2.0 * (b0 * x + b1 * y + b2 * z) + c;
+    }
+};
+
+// Mean squared distance of the planes of a and b to p
+double collapseError(const Quadric& a, const Quadric& b, const float* p)
+{
+    double weight = a.weight + b.weight;
+    return weight > 0.0 ? std::max(0.0, (a.evaluate(p) + b.evaluate(p)) / weight) : 0.0;
+}
+
+inline void cross(const float* a, const float* b, const float* c, double* n)
+{
+    double e1[3] = {(double)b[0] - a[0], (double)b[1] - a[1], (double)b[2] - a[2]};
+    double e2[3] = {(double)c[0] - a[0], (double)c[1] - a[1], (double)c[2] - a[2]};
+    n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+// What may happen to the vertices at one position
+enum VertexKind : uint8_t {
+    Manifold, // collapses onto any neighbour
+    Border,   // on an open border: only along the border
+    Seam,     // two vertices with different attributes: both along the seam
+    Locked,   // corners, non-manifold edges, more than two attribute sets
+};
+
+struct Collapse {
+    uint32_t v; // vertex that disappears
+    uint32_t t; // vertex it merges into
+    double cost;
+};
+
+// Simplification state kept across runs, so a LOD chain continues from the
+// previous LOD and its quadrics instead of starting over.
+//
+// Vertices are welded by position: quadrics, kinds and edge topology live on
+// positions, while the index list keeps referencing the original vertices.
+struct Simplifier {
+    const float* vertices;
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> weld;         // vertex -> position
+    std::vector<uint32_t> wedgeOffsets; // position -> range in wedges
+    std::vector<uint32_t> wedges;       // vertices sharing a position
+    std::vector<Quadric> quadrics;      // per position
+    std::vector<uint32_t> remap;        // vertex -> vertex, applied to the index list after each pass
+    double errorSq = 0.0;               // largest collapse error so far
+
+    // Rebuilt every pass
+    std::vector<uint8_t> kinds;           // per position
+    std::vector<uint32_t> fanOffsets;     // vertex -> range in fans
+    std::vector<uint32_t> fans;           // triangles around each vertex
+    std::vector<uint8_t> touched;         // positions changed in this pass
+    bool topologyStale = false;           // the index list changed since buildTopology()
+
+    Simplifier(const float* vertexData, size_t vertexCount, const uint32_t* indexData, size_t indexCount)
+        : vertices(vertexData), weld(vertexCount, UINT32_MAX), remap(vertexCount)
+    {
+        weldPositions(indexData, indexCount);
+        for (size_t i = 0; i + 2 < indexCount; i += 3) {
+            uint32_t a = indexData[i], b = indexData[i + 1], c = indexData[i + 2];
+            if (weld[a] != weld[b] && weld[b] != weld[c] && weld[a] != weld[c])
+                indices.insert(indices.end(), {a, b, c});
+        }
+        for (size_t v = 0; v < vertexCount; ++v)
+            remap[v] = (uint32_t)v;
+        buildTopology();
+        initQuadrics();
+    }
+
+    const float* position(uint32_t vertex) const { return vertices + (size_t)vertex * 8; }
+    uint32_t wedgeCount(uint32_t p) const { return wedgeOffsets[p + 1] - wedgeOffsets[p]; }
+
+    void weldPositions(const uint32_t* indexData, size_t indexCount)
+    {
+        std::vector<uint32_t> referenced;
+        for (size_t i = 0; i < indexCount; ++i) {
+            if (weld[indexData[i]] == UINT32_MAX) {
+                weld[indexData[i]] = 0;
+                referenced.push_back(indexData[i]);
+            }
+        }
+        auto samePosition = [&](uint32_t a, uint32_t b) {
+            const float* pa = position(a);
+            const float* pb = position(b);
+            return pa[0] == pb[0] && pa[1] == pb[1] && pa[2] == pb[2];
+        };
+        std::sort(referenced.begin(), referenced.end(), [&](uint32_t a, uint32_t b) {
+            const float* pa = position(a);
+            const float* pb = position(b);
+            if (pa[0] != pb[0]) return pa[0] < pb[0];
+            if (pa[1] != pb[1]) return pa[1] < pb[1];
+            if (pa[2] != pb[2]) return pa[2] < pb[2];
+            return a < b;
+        });
+        wedges = referenced;
+        for (size_t i = 0; i < wedges.size(); ++i) {
+            if (i == 0 || !samePosition(wedges[i - 1], wedges[i]))
+                wedgeOffsets.push_back((uint32_t)i);
+            weld[wedges[i]] = (uint32_t)wedgeOffsets.size() - 1;
+        }
+        wedgeOffsets.push_back((uint32_t)wedges.size());
+        quadrics.resize(wedgeOffsets.size() - 1);
+    }
+
+    bool triangleHas(uint32_t triangle, uint32_t p) const
+    {
+        const uint32_t* corners = &indices[(size_t)triangle * 3];
+        return weld[corners[0]] == p || weld[corners[1]] == p || weld[corners[2]] == p;
+    }
+
+    // Triangles using the position edge a-b. Fans are short, so walking them
+    // beats keeping a sorted edge list up to date between passes.
+    uint32_t edgeUseCount(uint32_t a, uint32_t b) const
+    {
+        uint32_t count = 0;
+        for (uint32_t w = wedgeOffsets[a]; w < wedgeOffsets[a + 1]; ++w)
+            for (uint32_t f = fanOffsets[wedges[w]]; f < fanOffsets[wedges[w] + 1]; ++f)
+                count += triangleHas(fans[f], b);
+        return count;
+    }
+
+    // Vertices a and b are corners of one triangle
+    bool shareTriangle(uint32_t a, uint32_t b) const
+    {
+        for (uint32_t f = fanOffsets[a]; f < fanOffsets[a + 1]; ++f) {
+            const uint32_t* corners = &indices[(size_t)fans[f] * 3];
+            if (corners[0] == b || corners[1] == b || corners[2] == b)
+                return true;
+        }
+        return false;
+    }
+
+    void buildTopology()
+    {
+        size_t triangleCount = indices.size() / 3;
+        size_t positionCount = quadrics.size();
+
+        fanOffsets.assign(weld.size() + 1, 0);
+        for (uint32_t index : indices)
+            fanOffsets[index + 1]++;
+        for (size_t v = 0; v < weld.size(); ++v)
+            fanOffsets[v + 1] += fanOffsets[v];
+        fans.resize(indices.size());
+        std::vector<uint32_t> fill(fanOffsets.begin(), fanOffsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t)
+            for (int k = 0; k < 3; ++k)
+                fans[fill[indices[t * 3 + k]]++] = (uint32_t)t;
+
+        // Border and non-manifold positions from the use counts of their edges:
+        // every neighbour appears once per triangle on the edge
+        kinds.assign(positionCount, Manifold);
+        std::vector<uint32_t> neighbours;
+        for (uint32_t p = 0; p < positionCount; ++p) {
+            neighbours.clear();
+            for (uint32_t w = wedgeOffsets[p]; w < wedgeOffsets[p + 1]; ++w) {
+                for (uint32_t f = fanOffsets[wedges[w]]; f < fanOffsets[wedges[w] + 1]; ++f) {
+                    const uint32_t* corners = &indices[(size_t)fans[f] * 3];
+                    for (int k = 0; k < 3; ++k)
+                        if (weld[corners[k]] != p)
+                            neighbours.push_back(weld[corners[k]]);
+                }
+            }
+            std::sort(neighbours.begin(), neighbours.end());
+            bool border = false, nonManifold = false;
+            for (size_t i = 0; i < neighbours.size();) {
+                size_t run = i;
+                while (run < neighbours.size() && neighbours[run] == neighbours[i])
+                    ++run;
+                border |= run - i == 1;
+                nonManifold |= run - i > 2;
+                i = run;
+            }
+            uint32_t count = wedgeCount(p);
+            if (nonManifold || count > 2 || (border && count > 1))
+                kinds[p] = Locked;
+            else if (count == 2)
+                kinds[p] = Seam;
+            else if (border)
+                kinds[p] = Border;
+        }
+    }
+
+    void initQuadrics()
+    {
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            const float* p[3] = {position(indices[i]), position(indices[i + 1]), position(indices[i + 2])};
+            double n[3];
+            cross(p[0], p[1], p[2], n);
+            double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length == 0.0)
+                continue;
+            n[0] /= length; n[1] /= length; n[2] /= length;
+            double d = -(n[0] * p[0][0] + n[1] * p[0][1] + n[2] * p[0][2]);
+            for (int k = 0; k < 3; ++k)
+                quadrics[weld[indices[i + k]]].addPlane(n[0], n[1], n[2], d, length * 0.5);
+
+            // Open borders get a plane through the edge, perpendicular to the
+            // triangle, so that collapses along them keep the outline
+            for (int k = 0; k < 3; ++k) {
+                uint32_t a = indices[i + k], b = indices[i + (k + 1) % 3];
+                if (edgeUseCount(weld[a], weld[b]) != 1)
+                    continue;
+                const float* pa = position(a);
+                const float* pb = position(b);
+                double e[3] = {(double)pb[0] - pa[0], (double)pb[1] - pa[1], (double)pb[2] - pa[2]};
+                double m[3] = {e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0]};
+                double edgeLength = std::sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+                if (edgeLength == 0.0)
+                    continue;
+                m[0] /= edgeLength; m[1] /= edgeLength; m[2] /= edgeLength;
+                double md = -(m[0] * pa[0] + m[1] * pa[1] + m[2] * pa[2]);
+                double weight = edgeLength * edgeLength;
+                quadrics[weld[a]].addPlane(m[0], m[1], m[2], md, weight);
+                quadrics[weld[b]].addPlane(m[0], m[1], m[2], md, weight);
+            }
+        }
+    }
+
+    bool canCollapse(uint32_t v, uint32_t t) const
+    {
+        uint32_t pv = weld[v], pt = weld[t];
+        switch (kinds[pv]) {
+        case Manifold: return true;
+        case Border: return edgeUseCount(pv, pt) == 1;
+        case Seam: return wedgeCount(pt) >= 2 && edgeUseCount(pv, pt) == 2;
+        default: return false;
+        }
+    }
+
+    // The triangles around v keep their orientation when v moves onto target
+    bool keepsOrientation(uint32_t v, uint32_t targetPosition, const float* target) const
+    {
+        for (uint32_t f = fanOffsets[v]; f < fanOffsets[v + 1]; ++f) {
+            if (triangleHas(fans[f], targetPosition))
+                continue; // removed by the collapse
+            const uint32_t* triangle = &indices[(size_t)fans[f] * 3];
+            const float* before[3] = {position(triangle[0]), position(triangle[1]), position(triangle[2])};
+            const float* after[3] = {before[0], before[1], before[2]};
+            for (int k = 0; k < 3; ++k)
+                if (triangle[k] == v)
+                    after[k] = target;
+            double n0[3], n1[3];
+            cross(before[0], before[1], before[2], n0);
+            cross(after[0], after[1], after[2], n1);
+            double dot = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+            double length0 = std::sqrt(n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2]);
+            double length1 = std::sqrt(n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2]);
+            // Flipped or folded past ~78 degrees: the collapse would crease the surface
+            if (dot <= 0.2 * length0 * length1)
+                return false;
+        }
+        return true;
+    }
+
+    // Positions around all vertices at position p
+    void ring(uint32_t p, std::vector<uint32_t>& out) const
+    {
+        out.clear();
+        for (uint32_t w = wedgeOffsets[p]; w < wedgeOffsets[p + 1]; ++w) {
+            uint32_t v = wedges[w];
+            for (uint32_t f = fanOffsets[v]; f < fanOffsets[v + 1]; ++f)
+                for (int k = 0; k < 3; ++k)
+                    if (weld[indices[(size_t)fans[f] * 3 + k]] != p)
+                        out.push_back(weld[indices[(size_t)fans[f] * 3 + k]]);
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    // Link condition: the only positions adjacent to both ends are the
+    // opposite corners of the triangles on the edge, otherwise the collapse
+    // pinches the surface into a non-manifold edge
+    bool keepsManifold(uint32_t pv, uint32_t pt, std::vector<uint32_t>& ringV, std::vector<uint32_t>& ringT) const
+    {
+        ring(pv, ringV);
+        ring(pt, ringT);
+        size_t common = 0;
+        for (size_t i = 0, j = 0; i < ringV.size() && j < ringT.size();) {
+            if (ringV[i] < ringT[j]) {
+                ++i;
+            } else if (ringV[i] > ringT[j]) {
+                ++j;
+            } else {
+                ++common;
+                ++i;
+                ++j;
+            }
+        }
+        return common == edgeUseCount(pv, pt);
+    }
+
+    // Returns the number of triangles removed, 0 if the collapse was rejected
+    size_t tryCollapse(const Collapse& collapse, std::vector<uint32_t>& ringV, std::vector<uint32_t>& ringT)
+    {
+        uint32_t pv = weld[collapse.v], pt = weld[collapse.t];
+        uint32_t from[2] = {collapse.v, 0}, to[2] = {collapse.t, 0};
+        int pairs = 1;
+        if (kinds[pv] == Seam) {
+            // The other side of the seam moves along with it, onto the vertex
+            // at the target position that shares an edge with it
+            uint32_t other = wedges[wedgeOffsets[pv]] == collapse.v ? wedges[wedgeOffsets[pv] + 1]
+                                                                     : wedges[wedgeOffsets[pv]];
+            for (uint32_t w = wedgeOffsets[pt]; w < wedgeOffsets[pt + 1] && pairs == 1; ++w) {
+                if (wedges[w] != collapse.t && shareTriangle(other, wedges[w])) {
+                    from[1] = other;
+                    to[1] = wedges[w];
+                    pairs = 2;
+                }
+            }
+            if (pairs == 1)
+                return 0;
+        }
+
+        const float* target = position(collapse.t);
+        for (int i = 0; i < pairs; ++i)
+            if (!keepsOrientation(from[i], pt, target))
+                return 0;
+        if (!keepsManifold(pv, pt, ringV, ringT))
+            return 0;
+
+        size_t removed = 0;
+        for (int i = 0; i < pairs; ++i) {
+            uint32_t v = from[i];
+            remap[v] = to[i];
+            for (uint32_t f = fanOffsets[v]; f < fanOffsets[v + 1]; ++f) {
+                const uint32_t* triangle = &indices[(size_t)fans[f] * 3];
+                for (int k = 0; k < 3; ++k)
+                    touched[weld[triangle[k]]] = 1;
+                removed += triangleHas(fans[f], pt);
+            }
+        }
+        quadrics[pt].add(quadrics[pv]);
+        touched[pv] = touched[pt] = 1;
+        return removed;
+    }
+
+    // Collapses edges, cheapest first, until the index count reaches
+    // targetIndexCount or every remaining collapse costs more than maxErrorSq
+    void run(size_t targetIndexCount, double maxErrorSq)
+    {
+        std::vector<Collapse> candidates;
+        std::vector<uint32_t> ringV, ringT;
+        while (indices.size() > targetIndexCount) {
+            if (topologyStale)
+                buildTopology();
+            topologyStale = false;
+
+            candidates.clear();
+            for (size_t i = 0; i < indices.size(); i += 3) {
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t a = indices[i + k], b = indices[i + (k + 1) % 3];
+                    // An edge between manifold vertices is seen from both of its
+                    // triangles, take it from one
+                    if (a > b && kinds[weld[a]] == Manifold && kinds[weld[b]] == Manifold)
+                        continue;
+                    const Quadric& qa = quadrics[weld[a]];
+                    const Quadric& qb = quadrics[weld[b]];
+                    double costAB = canCollapse(a, b) ? collapseError(qa, qb, position(b)) : -1.0;
+                    double costBA = canCollapse(b, a) ? collapseError(qb, qa, position(a)) : -1.0;
+                    if (costAB >= 0.0 && (costBA < 0.0 || costAB <= costBA))
+                        candidates.push_back({a, b, costAB});
+                    else if (costBA >= 0.0)
+                        candidates.push_back({b, a, costBA});
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(),
+                      [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+            // One collapse per neighbourhood and pass, so every check above sees the
+            // triangles as they will be after the pass
+            touched.assign(quadrics.size(), 0);
+            size_t needed = (indices.size() - targetIndexCount + 2) / 3;
+            size_t removed = 0;
+            for (const Collapse& collapse : candidates) {
+                if (removed >= needed || collapse.cost > maxErrorSq)
+                    break;
+                if (touched[weld[collapse.v]] || touched[weld[collapse.t]])
+                    continue;
+                size_t count = tryCollapse(collapse, ringV, ringT);
+                if (count > 0) {
+                    removed += count;
+                    errorSq = std::max(errorSq, collapse.cost);
+                }
+            }
+            if (removed == 0)
+                break;
+
+            size_t write = 0;
+            for (size_t i = 0; i < indices.size(); i += 3) {
+                uint32_t a = remap[indices[i]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
+                if (weld[a] == weld[b] || weld[b] == weld[c] || weld[a] == weld[c])
+                    continue;
+                indices[write++] = a;
+                indices[write++] = b;
+                indices[write++] = c;
+            }
+            indices.resize(write);
+            topologyStale = true;
+        }
+    }
+};
+
+} // namespace
+
+size_t simplifyMesh(uint32_t* destination, const uint32_t* indices, size_t indexCount, const float* vertices,
+                    size_t vertexCount, size_t targetIndexCount, float maxError, float* error)
+{
+    Simplifier simplifier(vertices, vertexCount, indices, indexCount);
+    simplifier.run(targetIndexCount, (double)maxError * maxError);
+    memmove(destination, simplifier.indices.data(), simplifier.indices.size() * sizeof(uint32_t));
+    if (error)
+        *error = (float)std::sqrt(simplifier.errorSq);
+    return simplifier.indices.size();
+}
+
+void generateMeshLods(MeshData& mesh, const MeshLodSettings& settings)
+{
+    CPU_PROFILE_FUNCTION();
+    if (mesh.lods.size() > 1)
+        return;
+    size_t baseCount = mesh.lods.empty() ? mesh.indices.size() : mesh.lods[0].indexCount;
+    mesh.indices.resize(baseCount);
+    mesh.lods.assign(1, MeshLod{0, (uint32_t)baseCount, 0.0f});
+    if (settings.maxLods < 2 || baseCount / 3 <= settings.minTriangles)
+        return;
+
+    // The error bound scales with the mesh
+    float lo[3] = {0.0f, 0.0f, 0.0f}, hi[3] = {0.0f, 0.0f, 0.0f};
+    for (size_t v = 0; v < mesh.vertexCount(); ++v) {
+        for (int k = 0; k < 3; ++k) {
+            float x = mesh.vertices[v * 8 + k];
+            lo[k] = v ? std::min(lo[k], x) : x;
+            hi[k] = v ? std::max(hi[k], x) : x;
+        }
+    }
+    double diagonal = std::sqrt((double)(hi[0] - lo[0]) * (hi[0] - lo[0]) + (double)(hi[1] - lo[1]) * (hi[1] - lo[1]) +
+                                (double)(hi[2] - lo[2]) * (hi[2] - lo[2]));
+    double maxError = settings.maxError * diagonal;
+
+    Simplifier simplifier(mesh.vertices.data(), mesh.vertexCount(), mesh.indices.data(), baseCount);
+    size_t previous = baseCount;
+    for (int level = 1; level < settings.maxLods && previous / 3 > settings.minTriangles; ++level) {
+        size_t target = std::max((size_t)(previous / 3 * settings.ratio), settings.minTriangles) * 3;
+        simplifier.run(target, maxError * maxError);
+        size_t count = simplifier.indices.size();
+        // Not worth another index range
+        if (count * 20 > previous * 19)
+            break;
+        mesh.lods.push_back({(uint32_t)mesh.indices.size(), (uint32_t)count, (float)std::sqrt(simplifier.errorSq)});
+        mesh.indices.insert(mesh.indices.end(), simplifier.indices.begin(), simplifier.indices.end());
+        previous = count;
+        if (count > target)
+            break; // stopped by the error bound or by locked vertices
+    }
+}
+
+int generateMeshLods(const std::vector<MeshData*>& meshes, const MeshLodSettings& settings)
+{
+    // Largest meshes first, so a big one does not start last and run alone
+    std::vector<MeshData*> order = meshes;
+    std::sort(order.begin(), order.end(),
+              [](const MeshData* a, const MeshData* b) { return a->indices.size() > b->indices.size(); });
+
+    int threads = std::max(1, std::min((int)order.size(), (int)std::thread::hardware_concurrency()));
+    std::atomic<size_t> next(0);
+    auto worker = [&] {
+        for (size_t i = next++; i < order.size(); i = next++)
+            generateMeshLods(*order[i], settings);
+    };
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i)
+        workers.emplace_back(worker);
+    worker();
+    for (std::thread& w : workers)
+        w.join();
+    return threads;
+}
@@ -0,0 +1,41 @@
+#ifndef MESH_SIMPLIFY_H
+#define MESH_SIMPLIFY_H
+
+#include "mesh_loader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Quadric error metric edge-collapse simplification (Garland-Heckbert).
+// A vertex always collapses onto one of its neighbours, so every LOD indexes
+// the original vertex buffer and a LOD chain is just more index ranges in
+// MeshData::lods. Open borders only collapse along the border, attribute
+// seams (two vertices sharing a position, e.g. the texcoord seam of
+// generateSphere()) only along the seam; corners where more vertices share a
+// position are kept.
+
+struct MeshLodSettings {
+    int maxLods = 4;          // including LOD 0
+    float ratio = 0.5f;       // target triangle count relative to the previous LOD
+    float maxError = 0.02f;   // relative to the bounds diagonal; the chain ends at this error
+    size_t minTriangles = 64; // no LOD is generated from fewer triangles
+};
+
+// Simplifies indexCount indices (triangles over 8-float vertices) towards
+// targetIndexCount without exceeding maxError (model units). destination has
+// room for indexCount indices and may alias indices. Returns the index count
+// reached; error receives the geometric error of the result.
+size_t simplifyMesh(uint32_t* destination, const uint32_t* indices, size_t indexCount, const float* vertices,
+                    size_t vertexCount, size_t targetIndexCount, float maxError, float* error = nullptr);
+
+// Appends successively simplified LODs of LOD 0 to mesh.indices and records
+// them in mesh.lods. The chain stops early when the error bound or the locked
+// features prevent further progress. Meshes that already have LODs are kept.
+void generateMeshLods(MeshData& mesh, const MeshLodSettings& settings = MeshLodSettings());
+
+// Same for several meshes in parallel, one mesh at a time per worker thread.
+// Returns the number of threads used.
+int generateMeshLods(const std::vector<MeshData*>& meshes, const MeshLodSettings& settings = MeshLodSettings());
+
+#endif // MESH_SIMPLIFY_H
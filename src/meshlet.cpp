@@ -0,0 +1,282 @@
+#include "meshlet.h"
+#include "cpu_profiler.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+static inline float dot3(const float* a, const float* b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// Unit normal of a counter-clockwise triangle, zero if it is degenerate
+static void triangleNormal(const float* vertices, const uint32_t* triangle, float* normal)
+{
+    const float* p0 = vertices + (size_t)triangle[0] * 8;
+    const float* p1 = vertices + (size_t)triangle[1] * 8;
+    const float* p2 = vertices + (size_t)triangle[2] * 8;
+    float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+    float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+    normal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    normal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    normal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+    float length = std::sqrt(dot3(normal, normal));
+    float scale = length > 0.0f ? 1.0f / length : 0.0f;
+    normal[0] *= scale;
+    normal[1] *= scale;
+    normal[2] *= scale;
+}
+
+// Bounding sphere around the box of the vertices, normal cone as in
+// meshoptimizer's meshopt_computeMeshletBounds()
+static void computeMeshletBounds(const MeshData& mesh, Meshlet& meshlet)
+{
+    const float* vertices = mesh.vertices.data();
+    const uint32_t* indices = mesh.indices.data() + meshlet.firstIndex;
+
+    float lo[3] = {FLT_MAX, FLT_MAX, FLT_MAX}, hi[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (uint32_t i = 0; i < meshlet.indexCount; ++i) {
+        const float* p = vertices + (size_t)indices[i] * 8;
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = std::min(lo[k], p[k]);
+            hi[k] = std::max(hi[k], p[k]);
+        }
+    }
+    float radiusSq = 0.0f;
+    for (int k = 0; k < 3; ++k)
+        meshlet.center[k] = (lo[k] + hi[k]) * 0.5f;
+    for (uint32_t i = 0; i < meshlet.indexCount; ++i) {
+        const float* p = vertices + (size_t)indices[i] * 8;
+        float d[3] = {p[0] - meshlet.center[0], p[1] - meshlet.center[1], p[2] - meshlet.center[2]};
+        radiusSq = std::max(radiusSq, dot3(d, d));
+    }
+    meshlet.radius = std::sqrt(radiusSq);
+
+    float axis[3] = {0.0f, 0.0f, 0.0f};
+    for (uint32_t i = 0; i < meshlet.indexCount; i += 3) {
+        float n[3];
+        triangleNormal(vertices, indices + i, n);
+        axis[0] += n[0];
+        axis[1] += n[1];
+        axis[2] += n[2];
+    }
+    float length = std::sqrt(dot3(axis, axis));
+    meshlet.coneCutoff = 2.0f;
+    if (length == 0.0f)
+        return;
+    for (int k = 0; k < 3; ++k)
+        axis[k] /= length;
+
+    float minDot = 1.0f;
+    for (uint32_t i = 0; i < meshlet.indexCount; i += 3) {
+        float n[3];
+        triangleNormal(vertices, indices + i, n);
+        if (dot3(n, n) > 0.0f)
+            minDot = std::min(minDot, dot3(n, axis));
+    }
+    // Normals spread over (almost) a hemisphere: the cone would never cull
+    if (minDot <= 0.1f)
+        return;
+
+    // Move the apex back along the axis until every triangle plane is in
+    // front of it, so the test holds for eyes close to the cluster too
+    float maxT = 0.0f;
+    for (uint32_t i = 0; i < meshlet.indexCount; i += 3) {
+        float n[3];
+        triangleNormal(vertices, indices + i, n);
+        float dn = dot3(axis, n);
+        if (dn <= 0.0f)
+            continue;
+        const float* p0 = vertices + (size_t)indices[i] * 8;
+        float d[3] = {meshlet.center[0] - p0[0], meshlet.center[1] - p0[1], meshlet.center[2] - p0[2]};
+        maxT = std::max(maxT, dot3(d, n) / dn);
+    }
+    for (int k = 0; k < 3; ++k) {
+        meshlet.coneAxis[k] = axis[k];
+        meshlet.coneApex[k] = meshlet.center[k] - axis[k] * maxT;
+    }
+    meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+// Clusters one LOD range; the reordered triangles replace the range in place
+static void buildLodMeshlets(MeshData& mesh, uint32_t firstIndex, uint32_t indexCount, size_t maxVertices,
+                             size_t maxTriangles, std::vector<uint32_t>& stamp)
+{
+    const uint32_t* indices = mesh.indices.data() + firstIndex;
+    size_t triangleCount = indexCount / 3;
+    size_t vertexCount = mesh.vertexCount();
+
+    // Vertex -> triangles
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (uint32_t i = 0; i < indexCount; ++i)
+        offsets[indices[i] + 1]++;
+    for (size_t v = 0; v < vertexCount; ++v)
+        offsets[v + 1] += offsets[v];
+    std::vector<uint32_t> adjacency(indexCount);
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (uint32_t i = 0; i < indexCount; ++i)
+        adjacency[fill[indices[i]]++] = i / 3;
+
+    std::vector<float> normals(triangleCount * 3);
+    for (size_t t = 0; t < triangleCount; ++t)
+        triangleNormal(mesh.vertices.data(), indices + t * 3, &normals[t * 3]);
+
+    std::vector<uint32_t> reordered;
+    reordered.reserve(indexCount);
+    std::vector<char> used(triangleCount, 0);
+    std::vector<uint32_t> candidates;
+    size_t cursor = 0;
+    for (;;) {
+        while (cursor < triangleCount && used[cursor])
+            ++cursor;
+        if (cursor == triangleCount)
+            break;
+
+        uint32_t id = (uint32_t)mesh.meshlets.size();
+        Meshlet meshlet;
+        meshlet.firstIndex = firstIndex + (uint32_t)reordered.size();
+        size_t vertices = 0, triangles = 0;
+        float normalSum[3] = {0.0f, 0.0f, 0.0f};
+        candidates.clear();
+
+        size_t next = cursor;
+        for (;;) {
+            used[next] = 1;
+            for (int k = 0; k < 3; ++k) {
+                uint32_t v = indices[next * 3 + k];
+                reordered.push_back(v);
+                if (stamp[v] == id)
+                    continue;
+                stamp[v] = id;
+                vertices++;
+                for (uint32_t a = offsets[v]; a < offsets[v + 1]; ++a)
+                    if (!used[adjacency[a]])
+                        candidates.push_back(adjacency[a]);
+            }
+            for (int k = 0; k < 3; ++k)
+                normalSum[k] += normals[next * 3 + k];
+            if (++triangles == maxTriangles)
+                break;
+
+            // Next: the neighbour adding the fewest vertices, then the one
+            // closest to the cluster's average facing (tighter normal cones)
+            float length = std::sqrt(dot3(normalSum, normalSum));
+            float axis[3] = {0.0f, 0.0f, 0.0f};
+            if (length > 0.0f)
+                for (int k = 0; k < 3; ++k)
+                    axis[k] = normalSum[k] / length;
+            float bestScore = FLT_MAX;
+            size_t best = triangleCount;
+            for (size_t c = 0; c < candidates.size();) {
+                uint32_t t = candidates[c];
+                if (used[t]) {
+                    candidates[c] = candidates.back();
+                    candidates.pop_back();
+                    continue;
+                }
+                ++c;
+                size_t added = (stamp[indices[t * 3]] != id) + (stamp[indices[t * 3 + 1]] != id) +
+                               (stamp[indices[t * 3 + 2]] != id);
+                if (vertices + added > maxVertices)
+                    continue;
+                float score = (float)added + (1.0f - dot3(&normals[t * 3], axis)) * 0.5f;
+                if (score < bestScore) {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+            if (best == triangleCount && candidates.empty()) {
+                // Nothing connected left (e.g. a triangle soup): continue in index
+                // order, which is usually spatially coherent too
+                while (cursor < triangleCount && used[cursor])
+                    ++cursor;
+                if (cursor < triangleCount) {
+                    size_t added = (stamp[indices[cursor * 3]] != id) + (stamp[indices[cursor * 3 + 1]] != id) +
+                                   (stamp[indices[cursor * 3 + 2]] != id);
+                    if (vertices + added <= maxVertices)
+                        best = cursor;
+                }
+            }
+            if (best == triangleCount)
+                break;
+            next = best;
+        }
+
+        meshlet.indexCount = (uint32_t)(triangles * 3);
+        mesh.meshlets.push_back(meshlet);
+    }
+
+    std::copy(reordered.begin(), reordered.end(), mesh.indices.begin() + firstIndex);
+}
+
+void buildMeshlets(MeshData& mesh, size_t maxVertices, size_t maxTriangles)
+{
+    CPU_PROFILE_FUNCTION();
+    mesh.meshlets.clear();
+    std::vector<MeshLod> lods = mesh.lods;
+    if (lods.empty())
+        lods.push_back({0, (uint32_t)mesh.indices.size(), 0.0f});
+
+    std::vector<uint32_t> stamp(mesh.vertexCount(), UINT32_MAX);
+    for (const MeshLod& lod : lods)
+        buildLodMeshlets(mesh, lod.firstIndex, lod.indexCount / 3 * 3, maxVertices, maxTriangles, stamp);
+    for (Meshlet& meshlet : mesh.meshlets)
+        computeMeshletBounds(mesh, meshlet);
+    std::sort(mesh.meshlets.begin(), mesh.meshlets.end(),
+              [](const Meshlet& a, const Meshlet& b) { return a.firstIndex < b.firstIndex; });
+}
+
+void findLodMeshlets(const std::vector<Meshlet>& meshlets, uint32_t firstIndex, uint32_t indexCount,
+                     size_t& first, size_t& count)
+{
+    auto begin = std::lower_bound(meshlets.begin(), meshlets.end(), firstIndex,
+                                  [](const Meshlet& m, uint32_t index) { return m.firstIndex < index; });
+    auto end = std::lower_bound(begin, meshlets.end(), firstIndex + indexCount,
+                                [](const Meshlet& m, uint32_t index) { return m.firstIndex < index; });
+    first = begin - meshlets.begin();
+    count = end - begin;
+}
+
+void extractFrustumPlanes(const float* clip, float planes[6][4])
+{
+    // Gribb-Hartmann: row 3 plus/minus rows 0..2 of the matrix
+    for (int i = 0; i < 6; ++i) {
+        int row = i / 2;
+        float sign = (i & 1) ? -1.0f : 1.0f;
+        for (int k = 0; k < 4; ++k)
+            planes[i][k] = clip[k * 4 + 3] + sign * clip[k * 4 + row];
+        float length = std::sqrt(dot3(planes[i], planes[i]));
+        if (length > 0.0f)
+            for (int k = 0; k < 4; ++k)
+                planes[i][k] /= length;
+    }
+}
+
+size_t cullMeshlets(const Meshlet* meshlets, size_t count, const uint32_t* indices, const float planes[6][4],
+                    const float eye[3], uint32_t* out, MeshletCullStats& stats)
+{
+    uint32_t* begin = out;
+    for (size_t i = 0; i < count; ++i) {
+        const Meshlet& meshlet = meshlets[i];
+        stats.meshlets++;
+
+        bool outside = false;
+        for (int p = 0; p < 6 && !outside; ++p)
+            outside = dot3(planes[p], meshlet.center) + planes[p][3] < -meshlet.radius;
+        if (outside) {
+            stats.frustumCulled++;
+            continue;
+        }
+
+        float view[3] = {meshlet.coneApex[0] - eye[0], meshlet.coneApex[1] - eye[1], meshlet.coneApex[2] - eye[2]};
+        float distance = std::sqrt(dot3(view, view));
+        if (distance > 0.0f && dot3(view, meshlet.coneAxis) >= meshlet.coneCutoff * distance) {
+            stats.backfaceCulled++;
+            continue;
+        }
+
+        out = std::copy(indices + meshlet.firstIndex, indices + meshlet.firstIndex + meshlet.indexCount, out);
+    }
+    return out - begin;
+}
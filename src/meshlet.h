@@ -0,0 +1,45 @@
+#ifndef MESHLET_H
+#define MESHLET_H
+
+#include "mesh_loader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Meshlets split every LOD of a mesh into small clusters that can be culled
+// one by one on the CPU: against the view frustum with their bounding sphere,
+// and as a whole when all of their triangles face away from the camera. The
+// surviving clusters are gathered into the index buffer drawn for the frame.
+
+const size_t meshletMaxVertices = 64;
+const size_t meshletMaxTriangles = 124;
+
+// Reorders the triangles of each LOD range into clusters of at most
+// maxVertices distinct vertices and maxTriangles triangles, grown over shared
+// edges, and fills mesh.meshlets. The rendered result is unchanged.
+void buildMeshlets(MeshData& mesh, size_t maxVertices = meshletMaxVertices,
+                   size_t maxTriangles = meshletMaxTriangles);
+
+// Meshlets of mesh.meshlets (sorted) lying in [firstIndex, firstIndex + indexCount)
+void findLodMeshlets(const std::vector<Meshlet>& meshlets, uint32_t firstIndex, uint32_t indexCount,
+                     size_t& first, size_t& count);
+
+struct MeshletCullStats {
+    int meshlets = 0;       // tested
+    int frustumCulled = 0;
+    int backfaceCulled = 0;
+};
+
+// Frustum planes of a column-major clip matrix, in the space it transforms
+// from (pass projection * view * model to get model-space planes). A point
+// is inside when dot(plane.xyz, p) + plane.w >= 0; normals are unit length.
+void extractFrustumPlanes(const float* clip, float planes[6][4]);
+
+// Writes the indices of the visible meshlets to out, which must have room
+// for all of them, and returns how many were written. planes and eye are in
+// the mesh's model space; the cone test assumes a uniform scale.
+size_t cullMeshlets(const Meshlet* meshlets, size_t count, const uint32_t* indices, const float planes[6][4],
+                    const float eye[3], uint32_t* out, MeshletCullStats& stats);
+
+#endif // MESHLET_H
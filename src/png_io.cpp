@@ -0,0 +1,58 @@
+#include "png_io.h"
+
+#include <png.h>
+
+#include <cstdio>
+#include <iostream>
+
+bool writePNG(const char* path, const uint8_t* rgba, int width, int height)
+{
+    png_image image = {};
+    image.version = PNG_IMAGE_VERSION;
+    image.width = width;
+    image.height = height;
+    image.format = PNG_FORMAT_RGBA;
+    if (!png_image_write_to_file(&image, path, 0, rgba, 0, nullptr)) {
+        std::cerr << "Unable to write PNG " << path << ": " << image.message << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool readPNG(const char* path, std::vector<uint8_t>& rgba, int& width, int& height)
+{
+    png_image image = {};
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&image, path))
+        return false;
+
+    image.format = PNG_FORMAT_RGBA;
+    rgba.resize(PNG_IMAGE_SIZE(image));
+    if (!png_image_finish_read(&image, nullptr, rgba.data(), 0, nullptr)) {
+        std::cerr << "Unable to decode PNG " << path << ": " << image.message << std::endl;
+        png_image_free(&image);
+        return false;
+    }
+    width = image.width;
+    height = image.height;
+    return true;
+}
+
+bool decodePNG(const uint8_t* data, size_t size, std::vector<uint8_t>& rgba, int& width, int& height)
+{
+    png_image image = {};
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_memory(&image, data, size))
+        return false;
+
+    image.format = PNG_FORMAT_RGBA;
+    rgba.resize(PNG_IMAGE_SIZE(image));
+    if (!png_image_finish_read(&image, nullptr, rgba.data(), 0, nullptr)) {
+        std::cerr << "Unable to decode PNG: " << image.message << std::endl;
+        png_image_free(&image);
+        return false;
+    }
+    width = image.width;
+    height = image.height;
+    return true;
+}
@@ -0,0 +1,14 @@
+#ifndef PNG_IO_H
+#define PNG_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 8-bit RGBA PNG files, rows top to bottom
+bool writePNG(const char* path, const uint8_t* rgba, int width, int height);
+bool readPNG(const char* path, std::vector<uint8_t>& rgba, int& width, int& height);
+// Same as readPNG() for a PNG already in memory (e.g. embedded in a GLB)
+bool decodePNG(const uint8_t* data, size_t size, std::vector<uint8_t>& rgba, int& width, int& height);
+
+#endif // PNG_IO_H
@@ -0,0 +1,1084 @@
+#include "scene.h"
+#include "camera_control.h"
+#include "cpu_profiler.h"
+#include "gl_state_cache.h"
+#include "gltf_loader.h"
+#include "gpu_profiler.h"
+#include "mesh_cache.h"
+#include "mesh_loader.h"
+#include "mesh_simplify.h"
+#include "meshlet.h"
+#include "stream_buffer.h"
+#include "texture_array.h"
+
+#include <sys/stat.h>
+
+#include <glm/glm.hpp>          // For matrices and vectors
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Texture slots in the shared texture array
+TextureSlot cubeTextureSlot;
+TextureSlot planeTextureSlot;
+
+// Light properties
+float lightPosition[] = {1.0f, 1.0f, 1.0f};
+float lightAmbient[] = {0.2f, 0.2f, 0.2f, 1.0f};
+float lightSpecular[] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+float lightBaseColor[] = {0.8f, 0.8f, 0.8f};
+float lightDiffuse[] = {0.8f, 0.8f, 0.8f, 1.0f};
+float lightIntensity = 1.0f;
+
+float scale = 1.0f;
+float previousScale = 1.0f; // scale at the previous simulation step
+float renderScale = 1.0f;   // scale interpolated between simulation steps, used for drawing
+float targetScale = 1.0f;
+bool isScaling = false;
+const float scaleSpeed = 0.625f; // scale units per second (0.01 per 16 ms tick)
+
+GLuint shaderProgram; // Shader program
+
+// Size of the render target drawScene() projects onto
+int viewportWidth = 800;
+int viewportHeight = 600;
+
+RenderStats renderStats;
+
+// VAOs and VBOs
+GLuint cubeVAO, cubeVBO;
+GLuint planeVAO, planeVBO;
+GLuint sphereVAO = 0;
+int sphereVertexCount = 0;
+GLuint coneVAO = 0;
+int coneVertexCount = 0;
+
+// Imported model: GPU meshes with their LODs, materials and placed instances.
+// OBJ/PLY/.mesh files give one primitive drawn once with the default material.
+struct ModelMaterial {
+    float diffuse[3] = {0.8f, 0.8f, 0.8f};
+    float specular[3] = {0.5f, 0.5f, 0.5f};
+    float shininess = 32.0f;
+    float alpha = 1.0f;
+    TextureSlot texture;
+};
+
+// Index ranges of a mesh's LODs (mesh_simplify.h) and the bounding sphere
+// their screen-space error is measured at
+struct LodChain {
+    std::vector<MeshLod> lods;
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+};
+
+struct ModelPrimitive {
+    MeshBuffers buffers;
+    LodChain lodChain;
+    int material = 0;
+    // Only for meshes worth culling per cluster: the meshlets of all LODs and
+    // a CPU copy of the indices they are gathered from
+    std::vector<Meshlet> meshlets;
+    std::vector<GLuint> indices;
+};
+
+struct ModelInstance {
+    int primitive = 0;
+    glm::mat4 transform = glm::mat4(1.0f);
+};
+
+static std::vector<ModelMaterial> modelMaterials; // [0] is the default material
+static std::vector<ModelPrimitive> modelPrimitives;
+static std::vector<ModelInstance> modelInstances;
+static glm::mat4 sceneModelFit(1.0f); // centers the model on the plane and scales it to the fit box
+
+// Material textures are uploaded at the texture array layer size
+static const int materialTextureSize = 64;
+// Texture array state before the model's textures, restored when it is unloaded
+static TextureArrayMark modelTextureMark;
+
+static LodChain sphereLodChain;
+static LodChain coneLodChain;
+
+// A LOD is drawn once its error projects to at most this many pixels
+float lodErrorPixels = 1.0f;
+
+bool meshletCulling = true;
+// Smaller primitives are cheaper to draw whole than to cull and re-upload
+static const size_t meshletMinTriangles = 4096;
+
+// std140 layout of the FrameUniforms block shared by both shaders, streamed
+// once per frame and bound at frameUniformsBinding
+struct FrameUniforms {
+    float viewMatrix[16];
+    float projectionMatrix[16];
+    float lightPos[4];   // xyz
+    float viewPos[4];    // xyz
+    float lightColor[3];
+    float lightIntensity;
+};
+static_assert(sizeof(FrameUniforms) == 176, "FrameUniforms must match the std140 block");
+static const GLuint frameUniformsBinding = 0;
+// Starting size of each stream buffer region (stream_buffer.h); it grows as needed
+static const size_t streamFrameBytes = 1 << 20;
+
+static LodChain makeLodChain(const std::vector<MeshLod>& lods, size_t indexCount, const float* boundsMin,
+                             const float* boundsMax) {
+    LodChain chain;
+    chain.lods = lods;
+    if (chain.lods.empty())
+        chain.lods.push_back({0, (uint32_t)indexCount, 0.0f});
+    glm::vec3 lo = glm::make_vec3(boundsMin), hi = glm::make_vec3(boundsMax);
+    chain.center = (lo + hi) * 0.5f;
+    chain.radius = glm::length(hi - lo) * 0.5f;
+    return chain;
+}
+
+// Uploads a generated mesh (all LODs in one index buffer) into the layout of initVAOs()
+static void uploadProceduralMesh(MeshData& mesh, GLuint& vao, int& indexCount, LodChain& chain) {
+    computeMeshBounds(mesh);
+    MeshBuffers buffers = createMeshBuffers(mesh.vertices.data(), mesh.vertexCount(), mesh.indices.data(),
+                                            mesh.indices.size());
+    vao = buffers.vao;
+    chain = makeLodChain(mesh.lods, mesh.indices.size(), mesh.boundsMin, mesh.boundsMax);
+    indexCount = (int)chain.lods[0].indexCount;
+}
+
+
+static void buildSphereMesh(MeshData& mesh, float radius, int sectorCount, int stackCount) {
+    std::vector<GLfloat>& vertices = mesh.vertices;
+    std::vector<GLuint>& indices = mesh.indices;
+
+    float x, y, z, xy;                              // vertex position
+    float nx, ny, nz, lengthInv = 1.0f / radius;    // normal
+    float s, t;                                     // texCoord
+
+    float sectorStep = 2 * M_PI / sectorCount;
+    float stackStep = M_PI / stackCount;
+    float sectorAngle, stackAngle;
+
+    for(int i = 0; i <= stackCount; ++i) {
+        stackAngle = M_PI / 2 - i * stackStep;        // from pi/2 to -pi/2
+        xy = radius * cosf(stackAngle);             // r * cos(u)
+        z = radius * sinf(stackAngle);              // r * sin(u)
+
+        for(int j = 0; j <= sectorCount; ++j) {
+            sectorAngle = j * sectorStep;           // from 0 to 2pi
+
+            // vertex position
+            x = xy * cosf(sectorAngle);             // r * cos(u) * cos(v)
+            y = xy * sinf(sectorAngle);             // r * cos(u) * sin(v)
+            vertices.push_back(x);
+            vertices.push_back(y);
+            vertices.push_back(z);
+
+            // normalized vertex normal
+            nx = x * lengthInv;
+            ny = y * lengthInv;
+            nz = z * lengthInv;
+            vertices.push_back(nx);
+            vertices.push_back(ny);
+            vertices.push_back(nz);
+
+            // vertex tex coord between [0, 1]
+            s = (float)j / sectorCount;
+            t = (float)i / stackCount;
+            vertices.push_back(s);
+            vertices.push_back(t);
+        }
+    }
+
+    // indices
+    int k1, k2;
+    for(int i = 0; i < stackCount; ++i){
+        k1 = i * (sectorCount + 1);     // beginning of current stack
+        k2 = k1 + sectorCount + 1;      // beginning of next stack
+
+        for(int j = 0; j < sectorCount; ++j, ++k1, ++k2){
+            if(i != 0){
+                indices.push_back(k1);
+                indices.push_back(k2);
+                indices.push_back(k1 + 1);
+            }
+            if(i != (stackCount - 1)){
+                indices.push_back(k1 + 1);
+                indices.push_back(k2);
+                indices.push_back(k2 + 1);
+            }
+        }
+    }
+}
+
+void generateSphere(float radius, int sectorCount, int stackCount) {
+    MeshData mesh;
+    buildSphereMesh(mesh, radius, sectorCount, stackCount);
+    generateMeshLods(mesh);
+    uploadProceduralMesh(mesh, sphereVAO, sphereVertexCount, sphereLodChain);
+}
+
+static void buildConeMesh(MeshData& mesh, float radius, float height, int sectorCount) {
+    std::vector<GLfloat>& vertices = mesh.vertices;
+    std::vector<GLuint>& indices = mesh.indices;
+
+    float sectorStep = 2 * M_PI / sectorCount;
+    float sectorAngle;
+
+    // Предварительный расчет нормалей боковых граней
+    float slantHeight = sqrt(radius * radius + height * height);
+    float normalLength = 1.0f / slantHeight;
+    float nx, ny, nz;
+
+    // Генерация вершин основания (нормали вниз)
+    for (int i = 0; i < sectorCount; ++i) {
+        sectorAngle = i * sectorStep;
+        float x = radius * cosf(sectorAngle);
+        float z = radius * sinf(sectorAngle);
+        float y = 0.0f;
+
+        // Позиция вершины
+        vertices.push_back(x);
+        vertices.push_back(y);
+        vertices.push_back(z);
+
+        // Нормаль для основания
+        vertices.push_back(0.0f);
+        vertices.push_back(-1.0f);
+        vertices.push_back(0.0f);
+
+        // Текстурные координаты
+        vertices.push_back((x / radius + 1.0f) * 0.5f);
+        vertices.push_back((z / radius + 1.0f) * 0.5f);
+    }
+
+    // Центр основания
+    vertices.push_back(0.0f);
+    vertices.push_back(0.0f);
+    vertices.push_back(0.0f);
+    // Нормаль для центра основания
+    vertices.push_back(0.0f);
+    vertices.push_back(-1.0f);
+    vertices.push_back(0.0f);
+    // Текстурные координаты для центра основания
+    vertices.push_back(0.5f);
+    vertices.push_back(0.5f);
+
+    // Индексы для основания (треугольники фан)
+    for (int i = 0; i < sectorCount; ++i) {
+        indices.push_back(i);
+        indices.push_back((i + 1) % sectorCount);
+        indices.push_back(sectorCount); // Центр основания
+    }
+
+    // Генерация вершин боковых граней (нормали по боковой поверхности)
+    for (int i = 0; i < sectorCount; ++i) {
+        sectorAngle = i * sectorStep;
+        float x = radius * cosf(sectorAngle);
+        float z = radius * sinf(sectorAngle);
+        float y = 0.0f;
+
+        // Позиция вершины основания для боковых граней
+        vertices.push_back(x);
+        vertices.push_back(y);
+        vertices.push_back(z);
+
+        // Нормаль для боковой грани
+        nx = x * normalLength;
+        ny = radius * normalLength;
+        nz = z * normalLength;
+        glm::vec3 normal(nx, ny, nz);
+        normal = glm::normalize(normal);
+        vertices.push_back(normal.x);
+        vertices.push_back(normal.y);
+        vertices.push_back(normal.z);
+
+        // Текстурные координаты для боковых граней
+        vertices.push_back((float)i / sectorCount);
+        vertices.push_back(0.0f);
+    }
+
+    // Вершина апекса
+    vertices.push_back(0.0f);
+    vertices.push_back(height);
+    vertices.push_back(0.0f);
+    // Нормаль для апекса (для сглаженного освещения используем нормали боковых граней)
+    // Однако, нормаль апекса как отдельная вершина не имеет смысла для сглаживания
+    // Поэтому можно оставить нормаль апекса как (0,1,0) или использовать технику нормалей без апекса
+    vertices.push_back(0.0f);
+    vertices.push_back(1.0f);
+    vertices.push_back(0.0f);
+    // Текстурные координаты апекса
+    vertices.push_back(0.5f);
+    vertices.push_back(1.0f);
+
+    int sideBaseStart = sectorCount + 1; // После вершин основания и центра основания
+    int apexIndex = sideBaseStart + sectorCount; // Индекс апекса
+
+    // Индексы для боковых граней (треугольники)
+    for (int i = 0; i < sectorCount; ++i) {
+        indices.push_back(sideBaseStart + i);
+        indices.push_back(apexIndex);
+        indices.push_back(sideBaseStart + ((i + 1) % sectorCount));
+    }
+}
+
+void generateCone(float radius, float height, int sectorCount) {
+    MeshData mesh;
+    buildConeMesh(mesh, radius, height, sectorCount);
+    generateMeshLods(mesh);
+    uploadProceduralMesh(mesh, coneVAO, coneVertexCount, coneLodChain);
+}
+
+
+
+// Function to load and compile shaders
+GLuint loadShaders(const char* vertex_file_path, const char* fragment_file_path)
+{
+    // Create shader program
+    GLuint programID = glCreateProgram();
+
+    // Create vertex shader
+    GLuint vertexShaderID = glCreateShader(GL_VERTEX_SHADER);
+    // Load shader code from file and compile it
+    std::string VertexShaderCode;
+    std::ifstream VertexShaderStream(vertex_file_path, std::ios::in);
+    if(VertexShaderStream.is_open()){
+        std::stringstream sstr;
+        sstr << VertexShaderStream.rdbuf();
+        VertexShaderCode = sstr.str();
+        VertexShaderStream.close();
+    }else{
+        std::cerr << "Unable to access vertex shader file: " << vertex_file_path << std::endl;
+        return 0;
+    }
+
+    char const * VertexSourcePointer = VertexShaderCode.c_str();
+    glShaderSource(vertexShaderID, 1, &VertexSourcePointer , NULL);
+    glCompileShader(vertexShaderID);
+
+    // Check for vertex shader compilation errors
+    GLint Result = GL_FALSE;
+    int InfoLogLength;
+    glGetShaderiv(vertexShaderID, GL_COMPILE_STATUS, &Result);
+    glGetShaderiv(vertexShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
+    if ( InfoLogLength > 0 ){
+        std::vector<char> VertexShaderErrorMessage(InfoLogLength+1);
+        glGetShaderInfoLog(vertexShaderID, InfoLogLength, NULL, &VertexShaderErrorMessage[0]);
+        std::cerr << "Vertex shader compilation Error: " << &VertexShaderErrorMessage[0] << std::endl;
+    }
+
+    // Create fragment shader
+    GLuint fragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
+    // Load shader code from file and compile it
+    std::string FragmentShaderCode;
+    std::ifstream FragmentShaderStream(fragment_file_path, std::ios::in);
+    if(FragmentShaderStream.is_open()){
+        std::stringstream sstr;
+        sstr << FragmentShaderStream.rdbuf();
+        FragmentShaderCode = sstr.str();
+        FragmentShaderStream.close();
+    }else{
+        std::cerr << "Unable to access fragment shader file: " << fragment_file_path << std::endl;
+        return 0;
+    }
+
+    char const * FragmentSourcePointer = FragmentShaderCode.c_str();
+    glShaderSource(fragmentShaderID, 1, &FragmentSourcePointer , NULL);
+    glCompileShader(fragmentShaderID);
+
+    // Check for fragment shader compilation errors
+    glGetShaderiv(fragmentShaderID, GL_COMPILE_STATUS, &Result);
+    glGetShaderiv(fragmentShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
+    if ( InfoLogLength > 0 ){
+        std::vector<char> FragmentShaderErrorMessage(InfoLogLength+1);
+        glGetShaderInfoLog(fragmentShaderID, InfoLogLength, NULL, &FragmentShaderErrorMessage[0]);
+        std::cerr << "Fragment shader compilation Error: " << &FragmentShaderErrorMessage[0] << std::endl;
+    }
+
+    // Attach shaders to program and link it
+    glAttachShader(programID, vertexShaderID);
+    glAttachShader(programID, fragmentShaderID);
+    glLinkProgram(programID);
+
+    // Check program
+    glGetProgramiv(programID, GL_LINK_STATUS, &Result);
+    glGetProgramiv(programID, GL_INFO_LOG_LENGTH, &InfoLogLength);
+    if ( InfoLogLength > 0 ){
+        std::vector<char> ProgramErrorMessage(InfoLogLength+1);
+        glGetProgramInfoLog(programID, InfoLogLength, NULL, &ProgramErrorMessage[0]);
+        std::cerr << "Shader program linking error: " << &ProgramErrorMessage[0] << std::endl;
+    }
+
+    // Delete shaders after linking
+    glDeleteShader(vertexShaderID);
+    glDeleteShader(fragmentShaderID);
+
+    return programID;
+}
+
+// Fills an RGB buffer of texWidth * texHeight * 3 bytes with a checkerboard
+void fillCheckerboard(GLubyte* textureData, int texWidth, int texHeight, GLubyte color1[3], GLubyte color2[3]) {
+    for (int i = 0; i < texHeight; i++) {
+        for (int j = 0; j < texWidth; j++) {
+            int c = (((i & 8) == 0) ^ ((j & 8) == 0));
+            GLubyte* color = c ? color1 : color2;
+            int index = (i * texWidth + j) * 3;
+            textureData[index + 0] = color[0];
+            textureData[index + 1] = color[1];
+            textureData[index + 2] = color[2];
+        }
+    }
+}
+
+// Function to generate a checkerboard texture
+GLuint generateCheckerboardTexture(int texWidth, int texHeight, GLubyte color1[3], GLubyte color2[3]) {
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+
+    GLubyte* textureData = new GLubyte[texWidth * texHeight * 3];
+    fillCheckerboard(textureData, texWidth, texHeight, color1, color2);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, texWidth, texHeight, 0, GL_RGB,
+                 GL_UNSIGNED_BYTE, textureData);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    delete[] textureData;
+
+    return textureID;
+}
+
+// Vertex data for the cube
+GLfloat cubeVertices[] = {
+    // Positions          // Normals           // Texture Coords
+    // Back face
+    -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f, // Bottom-left
+     0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f, // Top-right
+     0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f, // Bottom-right     
+     0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f, // Top-right
+    -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f, // Bottom-left
+    -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f, // Top-left
+    // Front face
+    -0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 0.0f, // Bottom-left
+     0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 0.0f, // Bottom-right
+     0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 1.0f, // Top-right
+     0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   1.0f, 1.0f, // Top-right
+    -0.5f,  0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 1.0f, // Top-left
+    -0.5f, -0.5f,  0.5f,  0.0f,  0.0f, 1.0f,   0.0f, 0.0f, // Bottom-left
+    // Left face
+    -0.5f,  0.5f,  0.5f,  -1.0f, 0.0f,  0.0f,  1.0f, 0.0f, // Top-right
+    -0.5f,  0.5f, -0.5f,  -1.0f, 0.0f,  0.0f,  1.0f, 1.0f, // Top-left
+    -0.5f, -0.5f, -0.5f,  -1.0f, 0.0f,  0.0f,  0.0f, 1.0f, // Bottom-left
+    -0.5f, -0.5f, -0.5f,  -1.0f, 0.0f,  0.0f,  0.0f, 1.0f, // Bottom-left
+    -0.5f, -0.5f,  0.5f,  -1.0f, 0.0f,  0.0f,  0.0f, 0.0f, // Bottom-right
+    -0.5f,  0.5f,  0.5f,  -1.0f, 0.0f,  0.0f,  1.0f, 0.0f, // Top-right
+    // Right face
+     0.5f,  0.5f,  0.5f,   1.0f, 0.0f,  0.0f,  1.0f, 0.0f, // Top-left
+     0.5f, -0.5f, -0.5f,   1.0f, 0.0f,  0.0f,  0.0f, 1.0f, // Bottom-right
+     0.5f,  0.5f, -0.5f,   1.0f, 0.0f,  0.0f,  1.0f, 1.0f, // Top-right         
+     0.5f, -0.5f, -0.5f,   1.0f, 0.0f,  0.0f,  0.0f, 1.0f, // Bottom-right
+     0.5f,  0.5f,  0.5f,   1.0f, 0.0f,  0.0f,  1.0f, 0.0f, // Top-left
+     0.5f, -0.5f,  0.5f,   1.0f, 0.0f,  0.0f,  0.0f, 0.0f, // Bottom-left     
+    // Bottom face
+    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f, // Top-right
+     0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f, // Top-left
+     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f, // Bottom-left
+     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f, // Bottom-left
+    -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f, // Bottom-right
+    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f, // Top-right
+    // Top face
+    -0.5f,  0.5f, -0.5f,   0.0f, 1.0f,  0.0f,  0.0f, 1.0f, // Top-left
+     0.5f,  0.5f , 0.5f,   0.0f, 1.0f,  0.0f,  1.0f, 0.0f, // Bottom-right
+     0.5f,  0.5f ,-0.5f,   0.0f, 1.0f,  0.0f,  1.0f, 1.0f, // Top-right     
+     0.5f,  0.5f , 0.5f,   0.0f, 1.0f,  0.0f,  1.0f, 0.0f, // Bottom-right
+    -0.5f,  0.5f ,-0.5f,   0.0f, 1.0f,  0.0f,  0.0f, 1.0f, // Top-left
+    -0.5f,  0.5f , 0.5f,   0.0f, 1.0f,  0.0f,  0.0f, 0.0f  // Bottom-left        
+};
+
+
+// Vertex data for the plane
+GLfloat planeVertices[] = {
+    // Positions            // Normals         // Texture Coords
+    -5.0f, 0.0f, -5.0f,    0.0f, 1.0f, 0.0f,   0.0f,  5.0f,
+     5.0f, 0.0f,  5.0f,    0.0f, 1.0f, 0.0f,   5.0f,  0.0f,
+     5.0f, 0.0f, -5.0f,    0.0f, 1.0f, 0.0f,   5.0f,  5.0f,
+     5.0f, 0.0f,  5.0f,    0.0f, 1.0f, 0.0f,   5.0f,  0.0f,
+    -5.0f, 0.0f, -5.0f,    0.0f, 1.0f, 0.0f,   0.0f,  5.0f,
+    -5.0f, 0.0f,  5.0f,    0.0f, 1.0f, 0.0f,   0.0f,  0.0f
+};
+
+void initVAOs() {
+    // Same as generateSphere()/generateCone(), with the LODs of both built in parallel
+    MeshData sphere, cone;
+    buildSphereMesh(sphere, 0.5f, 36, 18); // radius, sectors, stacks
+    buildConeMesh(cone, 0.5f, 1.0f, 36);   // radius, height, sectors
+    generateMeshLods({&sphere, &cone});
+    uploadProceduralMesh(sphere, sphereVAO, sphereVertexCount, sphereLodChain);
+    uploadProceduralMesh(cone, coneVAO, coneVertexCount, coneLodChain);
+    // Cube VAO and VBO
+    glGenVertexArrays(1, &cubeVAO);
+    glGenBuffers(1, &cubeVBO);
+    cachedBindVertexArray(cubeVAO);
+
+    cachedBindArrayBuffer(cubeVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), cubeVertices, GL_STATIC_DRAW);
+
+    // Positions
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)0);
+    // Normals
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
+    // Texture Coords
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(6 * sizeof(GLfloat)));
+
+    cachedBindVertexArray(0);
+
+    // Plane VAO and VBO
+    glGenVertexArrays(1, &planeVAO);
+    glGenBuffers(1, &planeVBO);
+    cachedBindVertexArray(planeVAO);
+
+    cachedBindArrayBuffer(planeVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(planeVertices), planeVertices, GL_STATIC_DRAW);
+
+    // Positions
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)0);
+    // Normals
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
+    // Texture Coords
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(6 * sizeof(GLfloat)));
+
+    cachedBindVertexArray(0);
+}
+MeshBuffers createMeshBuffers(const float* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount) {
+    MeshBuffers mesh;
+    glGenVertexArrays(1, &mesh.vao);
+    glGenBuffers(1, &mesh.vbo);
+    glGenBuffers(1, &mesh.ebo);
+    cachedBindVertexArray(mesh.vao);
+
+    cachedBindArrayBuffer(mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * 8 * sizeof(GLfloat), vertices, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(GLuint), indices, GL_STATIC_DRAW);
+
+    // Positions
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)0);
+    // Normals
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
+    // Texture Coords
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(6 * sizeof(GLfloat)));
+
+    cachedBindVertexArray(0);
+    mesh.indexCount = (int)indexCount;
+    return mesh;
+}
+
+void destroyMeshBuffers(MeshBuffers& mesh) {
+    // Deleting bound objects unbinds them behind the state cache's back
+    if (getGLStateCache().vertexArray == mesh.vao)
+        cachedBindVertexArray(0);
+    if (getGLStateCache().arrayBuffer == mesh.vbo)
+        cachedBindArrayBuffer(0);
+    glDeleteVertexArrays(1, &mesh.vao);
+    glDeleteBuffers(1, &mesh.vbo);
+    glDeleteBuffers(1, &mesh.ebo);
+    mesh = MeshBuffers();
+}
+
+void unloadSceneModel() {
+    for (ModelPrimitive& primitive : modelPrimitives)
+        destroyMeshBuffers(primitive.buffers);
+    modelPrimitives.clear();
+    modelInstances.clear();
+    modelMaterials.clear();
+    releaseTexturesSince(modelTextureMark);
+}
+
+// Fits the model bounds to a 1.5 unit box standing on the plane at (0, 0, 2)
+static void fitSceneModel(const float* boundsMin, const float* boundsMax) {
+    glm::vec3 extent(boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2]);
+    float largest = std::max(extent.x, std::max(extent.y, extent.z));
+    float fit = largest > 0.0f ? 1.5f / largest : 1.0f;
+    glm::vec3 anchor((boundsMin[0] + boundsMax[0]) * 0.5f, boundsMin[1], (boundsMin[2] + boundsMax[2]) * 0.5f);
+    sceneModelFit = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 2.0f));
+    sceneModelFit = glm::scale(sceneModelFit, glm::vec3(fit));
+    sceneModelFit = glm::translate(sceneModelFit, -anchor);
+}
+
+// A single mesh with the default material, drawn once
+static void setSingleMeshModel(const float* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount,
+                               const std::vector<MeshLod>& lods, const Meshlet* meshlets, size_t meshletCount,
+                               const float* boundsMin, const float* boundsMax) {
+    unloadSceneModel();
+    modelMaterials.push_back(ModelMaterial());
+    ModelPrimitive primitive;
+    primitive.buffers = createMeshBuffers(vertices, vertexCount, indices, indexCount);
+    primitive.lodChain = makeLodChain(lods, indexCount, boundsMin, boundsMax);
+    if (meshletCount > 0 && primitive.lodChain.lods[0].indexCount / 3 >= meshletMinTriangles) {
+        primitive.meshlets.assign(meshlets, meshlets + meshletCount);
+        primitive.indices.assign(indices, indices + indexCount);
+    }
+    modelPrimitives.push_back(primitive);
+    modelInstances.push_back(ModelInstance());
+    fitSceneModel(boundsMin, boundsMax);
+}
+
+static bool loadGltfModel(const char* path) {
+    auto begin = std::chrono::steady_clock::now();
+    GltfScene gltf;
+    GltfLoadStats stats;
+    if (!loadGltf(path, gltf, materialTextureSize, &stats))
+        return false;
+
+    auto lodBegin = std::chrono::steady_clock::now();
+    std::vector<MeshData*> meshes;
+    for (GltfPrimitive& primitive : gltf.primitives)
+        meshes.push_back(&primitive.mesh);
+    int lodThreads = generateMeshLods(meshes);
+    for (MeshData* mesh : meshes)
+        if (mesh->triangleCount() >= meshletMinTriangles)
+            buildMeshlets(*mesh);
+
+    auto uploadBegin = std::chrono::steady_clock::now();
+    unloadSceneModel();
+    modelMaterials.push_back(ModelMaterial());
+    std::vector<TextureSlot> imageSlots(gltf.images.size());
+    for (size_t i = 0; i < gltf.images.size(); ++i)
+        if (!gltf.images[i].rgb.empty())
+            imageSlots[i] = addTextureToArray(gltf.images[i].rgb.data(), gltf.images[i].width, gltf.images[i].height);
+    for (const GltfMaterial& source : gltf.materials) {
+        ModelMaterial material;
+        memcpy(material.diffuse, source.diffuse, sizeof(material.diffuse));
+        memcpy(material.specular, source.specular, sizeof(material.specular));
+        material.shininess = source.shininess;
+        material.alpha = source.alpha;
+        if (source.image >= 0)
+            material.texture = imageSlots[source.image];
+        modelMaterials.push_back(material);
+    }
+
+    size_t triangles = 0;
+    for (const GltfPrimitive& source : gltf.primitives) {
+        ModelPrimitive primitive;
+        primitive.buffers = createMeshBuffers(source.mesh.vertices.data(), source.mesh.vertexCount(),
+                                              source.mesh.indices.data(), source.mesh.indices.size());
+        primitive.lodChain = makeLodChain(source.mesh.lods, source.mesh.indices.size(), source.mesh.boundsMin,
+                                          source.mesh.boundsMax);
+        primitive.material = source.material + 1; // -1 (no material) becomes the default
+        if (!source.mesh.meshlets.empty()) {
+            primitive.meshlets = source.mesh.meshlets;
+            primitive.indices = source.mesh.indices;
+        }
+        modelPrimitives.push_back(primitive);
+    }
+    for (const GltfInstance& source : gltf.instances) {
+        ModelInstance instance;
+        instance.primitive = source.primitive;
+        instance.transform = glm::make_mat4(source.transform);
+        modelInstances.push_back(instance);
+        triangles += gltf.primitives[source.primitive].mesh.triangleCount();
+    }
+    fitSceneModel(gltf.boundsMin, gltf.boundsMax);
+
+    auto now = std::chrono::steady_clock::now();
+    double lodMs = std::chrono::duration<double, std::milli>(uploadBegin - lodBegin).count();
+    double uploadMs = std::chrono::duration<double, std::milli>(now - uploadBegin).count();
+    double totalMs = std::chrono::duration<double, std::milli>(now - begin).count();
+    std::cout << "Loaded " << path << ": " << gltf.primitives.size() << " primitives, " << gltf.instances.size()
+              << " instances, " << triangles << " triangles, " << gltf.materials.size() << " materials, "
+              << gltf.images.size() << " images, " << stats.bytes / (1024.0 * 1024.0) << " MB in " << totalMs
+              << " ms" << std::endl;
+    std::cout << "  read " << stats.readMs << " ms, json " << stats.jsonMs << " ms, decode " << stats.decodeMs
+              << " ms on " << stats.threads << " threads (accessors " << stats.accessorMs << " ms, images "
+              << stats.imageMs << " ms summed), nodes " << stats.nodesMs << " ms, LODs " << lodMs << " ms on "
+              << lodThreads << " threads, upload " << uploadMs << " ms" << std::endl;
+    return true;
+}
+
+// The cache is usable if it is at least as new as the source mesh
+static bool isMeshCacheFresh(const std::string& cachePath, const char* sourcePath) {
+    struct stat cacheStat, sourceStat;
+    if (stat(cachePath.c_str(), &cacheStat) != 0 || stat(sourcePath, &sourceStat) != 0)
+        return false;
+    return cacheStat.st_mtime >= sourceStat.st_mtime;
+}
+
+static bool hasSuffix(const std::string& text, const char* suffix) {
+    size_t length = strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+bool loadSceneModel(const char* path) {
+    CPU_PROFILE_FUNCTION();
+    auto begin = std::chrono::steady_clock::now();
+    auto elapsedMs = [&] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    };
+
+    std::string pathString = path;
+    if (hasSuffix(pathString, ".gltf") || hasSuffix(pathString, ".glb"))
+        return loadGltfModel(path);
+
+    // model.obj is cached as model.obj.mesh; a .mesh path is used as is
+    bool isCache = hasSuffix(pathString, ".mesh");
+    std::string cachePath = isCache ? pathString : pathString + ".mesh";
+
+    if (isCache || isMeshCacheFresh(cachePath, path)) {
+        MeshCacheFile cache;
+        if (openMeshCache(cachePath.c_str(), cache)) {
+            // Straight from the mapping into the buffers, no CPU-side conversion
+            const MeshCacheHeader& header = *cache.header;
+            std::vector<MeshLod> lods;
+            for (uint32_t i = 0; i < header.lodCount; ++i)
+                lods.push_back({cache.lods[i].firstIndex, cache.lods[i].indexCount, cache.lods[i].error});
+            setSingleMeshModel(cache.vertices, header.vertexCount, cache.indices, header.indexCount, lods,
+                               cache.meshlets, header.meshletCount, header.boundsMin, header.boundsMax);
+            std::cout << "Loaded " << cachePath << ": " << header.vertexCount << " vertices, "
+                      << lods[0].indexCount / 3 << " triangles, " << header.lodCount << " LODs, "
+                      << header.meshletCount << " meshlets, "
+                      << cache.file.size / (1024.0 * 1024.0) << " MB in " << elapsedMs() << " ms" << std::endl;
+            return true;
+        }
+        if (isCache)
+            return false;
+    }
+
+    MeshData mesh;
+    MeshLoadStats stats;
+    if (!loadMesh(path, mesh, &stats))
+        return false;
+    auto lodBegin = std::chrono::steady_clock::now();
+    generateMeshLods(mesh);
+    buildMeshlets(mesh);
+    double lodMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lodBegin).count();
+    setSingleMeshModel(mesh.vertices.data(), mesh.vertexCount(), mesh.indices.data(), mesh.indices.size(), mesh.lods,
+                       mesh.meshlets.data(), mesh.meshlets.size(), mesh.boundsMin, mesh.boundsMax);
+
+    std::cout << "Loaded " << path << ": " << mesh.vertexCount() << " vertices, " << mesh.triangleCount()
+              << " triangles, " << stats.fileBytes / (1024.0 * 1024.0) << " MB in " << elapsedMs() << " ms (map "
+              << stats.mapMs << ", parse " << stats.parseMs << " on " << stats.threads << " threads, weld "
+              << stats.weldMs << ", " << mesh.lods.size() << " LODs and " << mesh.meshlets.size() << " meshlets "
+              << lodMs << ")" << std::endl;
+
+    // Best effort: the next launch maps the cache instead of parsing
+    if (writeMeshCache(cachePath.c_str(), mesh))
+        std::cout << "Wrote mesh cache " << cachePath << std::endl;
+    return true;
+}
+
+void enableBlending() {
+    cachedSetEnabled(GL_BLEND, true);
+    cachedBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void disableBlending() {
+    cachedSetEnabled(GL_BLEND, false);
+}
+
+// Coarsest LOD whose error, scaled by the model matrix and projected at the
+// bounding sphere's nearest point, stays within lodErrorPixels
+static const MeshLod& selectLod(const LodChain& chain, const glm::mat4& model, const glm::vec3& cameraPos,
+                                float pixelsPerUnit) {
+    glm::vec3 center = glm::vec3(model * glm::vec4(chain.center, 1.0f));
+    float scale = std::max(glm::length(glm::vec3(model[0])),
+                           std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+    // Not closer than the near plane
+    float distance = std::max(glm::length(cameraPos - center) - chain.radius * scale, 1.0f);
+    for (size_t i = chain.lods.size() - 1; i > 0; --i)
+        if (chain.lods[i].error * scale * pixelsPerUnit / distance <= lodErrorPixels)
+            return chain.lods[i];
+    return chain.lods[0];
+}
+
+static void countDraw(long long triangles) {
+    renderStats.drawCalls++;
+    renderStats.triangles += triangles;
+}
+
+static void drawLod(const MeshLod& lod) {
+    glDrawElements(GL_TRIANGLES, lod.indexCount, GL_UNSIGNED_INT, (void*)(lod.firstIndex * sizeof(GLuint)));
+    countDraw(lod.indexCount / 3);
+}
+
+// Draws the meshlets of the LOD that are inside the frustum and not facing
+// away from the camera, culled straight into the frame's stream buffer. The
+// primitive's VAO must be bound; its own index buffer is bound back afterwards.
+static void drawCulledLod(const ModelPrimitive& primitive, const MeshLod& lod, const glm::mat4& viewProjection,
+                          const glm::mat4& model, const glm::vec3& cameraPos) {
+    size_t first = 0, count = 0;
+    findLodMeshlets(primitive.meshlets, lod.firstIndex, lod.indexCount, first, count);
+    float planes[6][4];
+    glm::mat4 clip = viewProjection * model;
+    extractFrustumPlanes(glm::value_ptr(clip), planes);
+    glm::vec3 eye = glm::vec3(glm::inverse(model) * glm::vec4(cameraPos, 1.0f));
+
+    MeshletCullStats stats;
+    StreamAllocation indices = streamAlloc(lod.indexCount * sizeof(GLuint), sizeof(GLuint));
+    size_t indexCount = cullMeshlets(primitive.meshlets.data() + first, count, primitive.indices.data(), planes,
+                                     glm::value_ptr(eye), (uint32_t*)indices.data, stats);
+    streamCommit(indices, indexCount * sizeof(GLuint));
+    renderStats.meshlets += stats.meshlets;
+    renderStats.meshletsFrustumCulled += stats.frustumCulled;
+    renderStats.meshletsBackfaceCulled += stats.backfaceCulled;
+    if (indexCount == 0)
+        return;
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices.buffer);
+    glDrawElements(GL_TRIANGLES, (GLsizei)indexCount, GL_UNSIGNED_INT, (void*)indices.offset);
+    countDraw(indexCount / 3);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, primitive.buffers.ebo);
+}
+
+void drawScene() {
+    CPU_PROFILE_FUNCTION();
+    renderStats = RenderStats();
+    nextStreamFrame();
+    // Включаем смешивание для прозрачных объектов
+    // (состояние меняем через кэш: повторные вызовы пропускаются, а GUI знает, что привязано)
+    enableBlending();
+
+    // Используем шейдерную программу
+    cachedUseProgram(shaderProgram);
+
+    // Получаем локации uniform-переменных
+    GLuint modelLoc = glGetUniformLocation(shaderProgram, "modelMatrix");
+    GLuint alphaLoc = glGetUniformLocation(shaderProgram, "alpha");
+
+    // Локации для материала
+    GLuint materialSpecularLoc = glGetUniformLocation(shaderProgram, "materialSpecular");
+    GLuint materialDiffuseLoc = glGetUniformLocation(shaderProgram, "materialDiffuse");
+    GLuint materialAmbientLoc = glGetUniformLocation(shaderProgram, "materialAmbient");
+    GLuint materialShininessLoc = glGetUniformLocation(shaderProgram, "materialShininess");
+    GLuint useTextureLoc = glGetUniformLocation(shaderProgram, "useTexture");
+
+    // Устанавливаем матрицы просмотра и проекции
+    glm::mat4 view = getCameraViewMatrix();
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)viewportWidth / (float)viewportHeight, 1.0f, 100.0f);
+    // Пикселей на единицу длины на расстоянии 1 — для выбора LOD
+    float pixelsPerUnit = viewportHeight / (2.0f * tanf(glm::radians(45.0f) * 0.5f));
+
+    // Параметры кадра пишем в кольцевой буфер и привязываем к блоку FrameUniforms
+    glm::vec3 lightPos(lightPosition[0], lightPosition[1], lightPosition[2]);
+    glm::vec3 cameraPos = getCameraPosition();
+    StreamAllocation frameBlock = streamAlloc(sizeof(FrameUniforms), streamUniformAlignment());
+    FrameUniforms frameUniforms = {};
+    memcpy(frameUniforms.viewMatrix, glm::value_ptr(view), sizeof(frameUniforms.viewMatrix));
+    memcpy(frameUniforms.projectionMatrix, glm::value_ptr(projection), sizeof(frameUniforms.projectionMatrix));
+    memcpy(frameUniforms.lightPos, glm::value_ptr(lightPos), 3 * sizeof(float));
+    memcpy(frameUniforms.viewPos, glm::value_ptr(cameraPos), 3 * sizeof(float));
+    memcpy(frameUniforms.lightColor, lightBaseColor, sizeof(frameUniforms.lightColor));
+    frameUniforms.lightIntensity = lightIntensity;
+    memcpy(frameBlock.data, &frameUniforms, sizeof(frameUniforms));
+    streamCommit(frameBlock, sizeof(frameUniforms));
+    glBindBufferRange(GL_UNIFORM_BUFFER, frameUniformsBinding, frameBlock.buffer, frameBlock.offset,
+                      sizeof(FrameUniforms));
+
+    // Все текстуры материалов лежат в одном текстурном массиве: привязываем его один раз,
+    // объекты отличаются только слоем и областью на слое
+    bindTextureArray(0);
+    glUniform1i(glGetUniformLocation(shaderProgram, "textureSampler"), 0);
+
+    // --- Рисуем куб (непрозрачный) ---
+    {
+        GPU_PROFILE_SCOPE("Cube");
+        glm::mat4 model = glm::mat4(1.0f);
+        model = glm::translate(model, glm::vec3(-2.0f, 2.0f, 0.0f));
+        model = glm::scale(model, glm::vec3(renderScale, renderScale, renderScale));
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+        // Устанавливаем параметры материала
+        //glUniform3f(materialSpecularLoc, 0.5f, 0.5f, 0.5f); // Средний спекулярный цвет
+        glUniform3f(materialDiffuseLoc, 1.0f, 1.0f, 1.0f);  // Диффузный цвет (будет использоваться текстура)
+        glUniform3f(materialAmbientLoc, 0.3f, 0.3f, 0.3f);  // Фоновый цвет
+        glUniform1f(materialShininessLoc, 32.0f);           // Средний коэффициент блеска
+
+        // Используем текстуру
+        glUniform1i(useTextureLoc, GL_TRUE);
+        setTextureSlotUniforms(shaderProgram, cubeTextureSlot);
+
+        cachedBindVertexArray(cubeVAO);
+        glDrawArrays(GL_TRIANGLES, 0, 36);
+        countDraw(36 / 3);
+        cachedBindVertexArray(0);
+    }
+
+    // --- Рисуем плоскость (очень отражающая) ---
+    {
+        GPU_PROFILE_SCOPE("Plane");
+        glm::mat4 model = glm::mat4(1.0f);
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+        // Устанавливаем параметры материала
+        glUniform3f(materialSpecularLoc, 1.0f, 1.0f, 1.0f); // Высокий спекулярный цвет для сильного отражения
+        glUniform3f(materialDiffuseLoc, 1.0f, 1.0f, 1.0f);  // Диффузный цвет (будет использоваться текстура)
+        glUniform3f(materialAmbientLoc, 0.3f, 0.3f, 0.3f);  // Фоновый цвет
+        glUniform1f(materialShininessLoc, 128.0f);          // Высокий коэффициент блеска
+
+        // Используем текстуру
+        glUniform1i(useTextureLoc, GL_TRUE);
+        setTextureSlotUniforms(shaderProgram, planeTextureSlot);
+
+        cachedBindVertexArray(planeVAO);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        countDraw(6 / 3);
+        cachedBindVertexArray(0);
+    }
+
+    // --- Рисуем конус (металлический, блестящий) ---
+    {
+        GPU_PROFILE_SCOPE("Cone");
+        glm::mat4 model = glm::mat4(1.0f);
+        model = glm::translate(model, glm::vec3(0.0f, 2.0f, 0.0f));
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+        // Устанавливаем параметры материала
+        glUniform3f(materialSpecularLoc, 1.0f, 1.0f, 1.0f); // Белый спекулярный цвет
+        glUniform3f(materialDiffuseLoc, 1.0f, 0.8f, 0.0f);  // Жёлтый диффузный цвет
+        glUniform3f(materialAmbientLoc, 0.3f, 0.3f, 0.3f);  // Фоновый цвет
+        glUniform1f(materialShininessLoc, 164.0f);          // Высокий коэффициент блеска
+
+        // Не используем текстуру
+        glUniform1i(useTextureLoc, GL_FALSE);
+
+        // Устанавливаем альфа-канал (полностью непрозрачный)
+        glUniform1f(alphaLoc, 1.0f);
+
+        cachedBindVertexArray(coneVAO);
+        drawLod(selectLod(coneLodChain, model, cameraPos, pixelsPerUnit));
+        cachedBindVertexArray(0);
+    }
+
+    // --- Импортированная модель ---
+    if (!modelInstances.empty()) {
+        GPU_PROFILE_SCOPE("Model");
+        glUniform3f(materialAmbientLoc, 0.3f, 0.3f, 0.3f);
+        for (const ModelInstance& instance : modelInstances) {
+            const ModelPrimitive& primitive = modelPrimitives[instance.primitive];
+            const ModelMaterial& material = modelMaterials[primitive.material];
+            glm::mat4 model = sceneModelFit * instance.transform;
+            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+            glUniform3fv(materialSpecularLoc, 1, material.specular);
+            glUniform3fv(materialDiffuseLoc, 1, material.diffuse);
+            glUniform1f(materialShininessLoc, material.shininess);
+            glUniform1f(alphaLoc, material.alpha);
+            bool textured = material.texture.layer >= 0;
+            glUniform1i(useTextureLoc, textured ? GL_TRUE : GL_FALSE);
+            if (textured)
+                setTextureSlotUniforms(shaderProgram, material.texture);
+
+            cachedBindVertexArray(primitive.buffers.vao);
+            const MeshLod& lod = selectLod(primitive.lodChain, model, cameraPos, pixelsPerUnit);
+            if (meshletCulling && !primitive.meshlets.empty())
+                drawCulledLod(primitive, lod, projection * view, model, cameraPos);
+            else
+                drawLod(lod);
+        }
+        cachedBindVertexArray(0);
+    }
+
+    // --- Рисуем сферу (прозрачная и отражающая) ---
+    {
+        GPU_PROFILE_SCOPE("Sphere");
+        glm::mat4 model = glm::mat4(1.0f);
+        model = glm::translate(model, glm::vec3(2.0f, 2.0f, 0.0f));
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+
+        // Устанавливаем параметры материала
+        glUniform3f(materialSpecularLoc, 0.8f, 0.8f, 0.8f); // Высокий спекулярный цвет для отражения
+        glUniform3f(materialDiffuseLoc, 0.0f, 1.0f, 0.0f);  // Зелёный диффузный цвет
+        glUniform3f(materialAmbientLoc, 0.3f, 0.3f, 0.3f);  // Фоновый цвет
+        glUniform1f(materialShininessLoc, 64.0f);           // Средний коэффициент блеска
+
+        // Устанавливаем альфа-канал (70% непрозрачность)
+        glUniform1f(alphaLoc, 0.7f);
+
+        // Не используем текстуру
+        glUniform1i(useTextureLoc, GL_FALSE);
+
+        cachedBindVertexArray(sphereVAO);
+        drawLod(selectLod(sphereLodChain, model, cameraPos, pixelsPerUnit));
+        cachedBindVertexArray(0);
+    }
+
+    // Отключаем смешивание после рисования
+    disableBlending();
+
+    // Отключаем шейдерную программу
+    cachedUseProgram(0);
+}
+
+// Fixed-timestep simulation step, returns true while the scene is still animating
+bool stepSimulation(double dt) {
+    CPU_PROFILE_FUNCTION();
+    previousScale = scale;
+    if (isScaling) {
+        float step = scaleSpeed * (float)dt;
+        if (std::fabs(targetScale - scale) <= step) {
+            scale = targetScale;
+            isScaling = false;
+        } else {
+            scale += targetScale > scale ? step : -step;
+        }
+    }
+    return isScaling || previousScale != scale;
+}
+
+bool initScene(const char* vertexShaderPath, const char* fragmentShaderPath) {
+    // Initialize textures: 64x64 material textures share one texture array
+    initTextureArray(materialTextureSize, materialTextureSize, 16);
+    std::vector<GLubyte> checkerboard(64 * 64 * 3);
+
+    GLubyte cubeColor1[3] = {255, 255, 255}; // white
+    GLubyte cubeColor2[3] = {0, 0, 0};       // black
+    fillCheckerboard(checkerboard.data(), 64, 64, cubeColor1, cubeColor2);
+    cubeTextureSlot = addTextureToArray(checkerboard.data(), 64, 64);
+
+    GLubyte planeColor1[3] = {192, 192, 192}; // light gray
+    GLubyte planeColor2[3] = {255, 255, 255}; // white
+    fillCheckerboard(checkerboard.data(), 64, 64, planeColor1, planeColor2);
+    planeTextureSlot = addTextureToArray(checkerboard.data(), 64, 64);
+    modelTextureMark = markTextureArray();
+
+    // Initialize VAOs and VBOs
+    initVAOs();
+
+    // Load shaders
+    shaderProgram = loadShaders(vertexShaderPath, fragmentShaderPath);
+    if (shaderProgram == 0)
+        return false;
+    GLuint frameBlockIndex = glGetUniformBlockIndex(shaderProgram, "FrameUniforms");
+    if (frameBlockIndex != GL_INVALID_INDEX)
+        glUniformBlockBinding(shaderProgram, frameBlockIndex, frameUniformsBinding);
+
+    initStreamBuffer(streamFrameBytes, GLEW_ARB_buffer_storage != 0);
+    // From here on every state change goes through the cache
+    syncGLStateCache();
+    return true;
+}
+
+void shutdownScene() {
+    unloadSceneModel();
+    shutdownStreamBuffer();
+    shutdownTextureArray();
+}
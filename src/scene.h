@@ -0,0 +1,90 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <GL/glew.h>
+#include <cstddef>
+
+// Light properties
+extern float lightPosition[3];
+extern float lightBaseColor[3];
+extern float lightDiffuse[4];
+extern float lightIntensity;
+
+// Animated cube scale: simulation state and the value interpolated for drawing.
+// Setting targetScale and isScaling starts the animation.
+extern float scale;
+extern float previousScale;
+extern float renderScale;
+extern float targetScale;
+extern bool isScaling;
+
+extern GLuint shaderProgram;
+
+// Procedural meshes built by generateSphere()/generateCone() (LOD 0 index
+// counts; the coarser LODs follow in the same index buffers)
+extern GLuint sphereVAO;
+extern int sphereVertexCount;
+extern GLuint coneVAO;
+extern int coneVertexCount;
+
+// Size of the render target drawScene() projects onto (window or offscreen FBO)
+extern int viewportWidth;
+extern int viewportHeight;
+
+// Screen-space error budget for LOD selection: the sphere, the cone and the
+// model draw their coarsest LOD (mesh_simplify.h) whose geometric error
+// projects to at most this many pixels. 0 always draws LOD 0.
+extern float lodErrorPixels;
+
+// Model primitives of at least meshletMinTriangles triangles are culled per
+// meshlet (meshlet.h) on the CPU and drawn from an index buffer built for the
+// frame; otherwise, and for smaller meshes, the whole LOD is drawn.
+extern bool meshletCulling;
+
+// Work submitted by the last drawScene() call
+struct RenderStats {
+    int drawCalls = 0;
+    long long triangles = 0;
+    int meshlets = 0;               // tested by meshlet culling
+    int meshletsFrustumCulled = 0;
+    int meshletsBackfaceCulled = 0;
+};
+extern RenderStats renderStats;
+
+// GPU copy of an indexed mesh in the initVAOs() vertex layout
+struct MeshBuffers {
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+    int indexCount = 0;
+};
+MeshBuffers createMeshBuffers(const float* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount);
+void destroyMeshBuffers(MeshBuffers& mesh);
+
+// Optional imported model, drawn in front of the procedural objects, scaled
+// to fit a 1.5 unit box standing on the plane. glTF/GLB scenes keep their
+// node hierarchy and materials (gltf_loader.h). OBJ/PLY meshes (mesh_loader.h)
+// are cached next to the source as <path>.mesh (mesh_cache.h) and mapped from
+// there on the next launch; a .mesh path is loaded directly. LODs are
+// generated on load (stored in the cache for OBJ/PLY).
+bool loadSceneModel(const char* path);
+// Also releases the texture array layers loaded for the model's materials
+void unloadSceneModel();
+
+void generateSphere(float radius, int sectorCount, int stackCount);
+void generateCone(float radius, float height, int sectorCount);
+GLuint loadShaders(const char* vertex_file_path, const char* fragment_file_path);
+void fillCheckerboard(GLubyte* textureData, int texWidth, int texHeight, GLubyte color1[3], GLubyte color2[3]);
+GLuint generateCheckerboardTexture(int texWidth, int texHeight, GLubyte color1[3], GLubyte color2[3]);
+void initVAOs();
+
+// Textures, geometry and the shader program; false if the shaders can't be loaded
+bool initScene(const char* vertexShaderPath, const char* fragmentShaderPath);
+void shutdownScene();
+
+void drawScene();
+
+// Fixed-timestep simulation step, returns true while the scene is still animating
+bool stepSimulation(double dt);
+
+#endif // SCENE_H
@@ -0,0 +1,211 @@
+#include "stream_buffer.h"
+#include "cpu_profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// The GPU may still read the two frames before this one
+static const int streamRegionCount = 3;
+
+static GLuint streamBuffer = 0;
+static char* persistentData = nullptr; // whole buffer, mapped for its lifetime
+static size_t regionSize = 0;
+static int region = 0;          // region the current frame writes to
+static size_t cursor = 0;       // next free byte, absolute offset in the buffer
+static size_t frameDemand = 0;  // bytes asked for this frame, overflows included
+static bool frameOverflowed = false;
+static GLsync regionFences[streamRegionCount] = {};
+
+// Allocations that don't fit: staged in memory, then orphaned into a plain buffer
+static GLuint overflowBuffer = 0;
+static std::vector<char> overflowData;
+
+static size_t uniformAlignment = 256;
+static StreamBufferStats stats;
+
+static size_t alignUp(size_t value, size_t alignment)
+{
+    return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+static void createStreamStorage(size_t frameBytes)
+{
+    // Every region starts uniform-aligned, so offsets inside it keep their alignment
+    regionSize = alignUp(frameBytes, uniformAlignment);
+    size_t totalSize = regionSize * streamRegionCount;
+
+    glGenBuffers(1, &streamBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, streamBuffer);
+    if (stats.persistent) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags);
+        persistentData = (char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags);
+        if (!persistentData) {
+            // Immutable storage can't be respecified: start over with a mutable buffer
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            glDeleteBuffers(1, &streamBuffer);
+            glGenBuffers(1, &streamBuffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, streamBuffer);
+            stats.persistent = false;
+        }
+    }
+    if (!stats.persistent)
+        glBufferData(GL_COPY_WRITE_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    region = 0;
+    cursor = 0;
+    stats.frameCapacity = regionSize;
+}
+
+static void destroyStreamStorage()
+{
+    for (GLsync& fence : regionFences) {
+        if (fence) {
+            glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (persistentData) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, streamBuffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        persistentData = nullptr;
+    }
+    if (streamBuffer != 0) {
+        glDeleteBuffers(1, &streamBuffer);
+        streamBuffer = 0;
+    }
+}
+
+void initStreamBuffer(size_t frameBytes, bool persistent)
+{
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    uniformAlignment = alignment > 0 ? (size_t)alignment : 256;
+
+    stats = StreamBufferStats();
+    stats.persistent = persistent;
+    createStreamStorage(frameBytes);
+    frameDemand = 0;
+    frameOverflowed = false;
+}
+
+void shutdownStreamBuffer()
+{
+    destroyStreamStorage();
+    if (overflowBuffer != 0) {
+        glDeleteBuffers(1, &overflowBuffer);
+        overflowBuffer = 0;
+    }
+    overflowData = std::vector<char>();
+}
+
+void nextStreamFrame()
+{
+    if (streamBuffer == 0)
+        return;
+    CPU_PROFILE_FUNCTION();
+
+    regionFences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    stats.frameBytes = frameDemand;
+
+    if (frameOverflowed) {
+        // Too small for a whole frame: wait for the GPU once and reallocate
+        // at the next power of two, so steady growth settles quickly
+        size_t size = regionSize;
+        while (size < frameDemand)
+            size *= 2;
+        destroyStreamStorage();
+        createStreamStorage(size);
+        frameDemand = 0;
+        frameOverflowed = false;
+        return;
+    }
+    frameDemand = 0;
+
+    region = (region + 1) % streamRegionCount;
+    cursor = region * regionSize;
+    GLsync& fence = regionFences[region];
+    if (!fence)
+        return;
+    if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+        // The GPU is more than two frames behind
+        auto start = std::chrono::steady_clock::now();
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_TIMEOUT_EXPIRED) {
+        }
+        stats.stalls++;
+        stats.stallMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+StreamAllocation streamAlloc(size_t size, size_t alignment)
+{
+    StreamAllocation allocation;
+    allocation.size = size;
+    stats.allocations++;
+    frameDemand += size + alignment;
+
+    size_t offset = alignUp(cursor, alignment);
+    if (streamBuffer != 0 && offset + size <= (region + 1) * regionSize) {
+        if (persistentData) {
+            allocation.data = persistentData + offset;
+        } else {
+            // Unsynchronized: the region's fence already guarantees the GPU is done with it
+            glBindBuffer(GL_COPY_WRITE_BUFFER, streamBuffer);
+            allocation.data = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, size,
+                                               GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                                   GL_MAP_UNSYNCHRONIZED_BIT);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        if (allocation.data) {
+            allocation.buffer = streamBuffer;
+            allocation.offset = offset;
+            cursor = offset + size;
+            return allocation;
+        }
+    }
+
+    stats.overflows++;
+    frameOverflowed = streamBuffer != 0;
+    if (overflowBuffer == 0)
+        glGenBuffers(1, &overflowBuffer);
+    if (overflowData.size() < size)
+        overflowData.resize(size);
+    allocation.data = overflowData.data();
+    allocation.buffer = overflowBuffer;
+    allocation.offset = 0;
+    return allocation;
+}
+
+void streamCommit(const StreamAllocation& allocation, size_t usedSize)
+{
+    usedSize = std::min(usedSize, allocation.size);
+    if (allocation.buffer == overflowBuffer) {
+        // Orphans the previous contents, draws already queued keep theirs
+        glBindBuffer(GL_COPY_WRITE_BUFFER, overflowBuffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, usedSize, allocation.data, GL_STREAM_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        return;
+    }
+    if (!persistentData) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, streamBuffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    cursor = allocation.offset + usedSize;
+}
+
+size_t streamUniformAlignment()
+{
+    return uniformAlignment;
+}
+
+StreamBufferStats getStreamBufferStats()
+{
+    return stats;
+}
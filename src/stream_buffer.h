@@ -0,0 +1,51 @@
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#include <GL/glew.h>
+#include <cstddef>
+
+// Ring allocator for data rewritten every frame (uniform blocks, streamed
+// indices and vertices) that avoids glBufferData reallocations: one buffer
+// split into three per-frame regions, each guarded by a fence so the CPU only
+// writes where the GPU has finished reading. With ARB_buffer_storage the
+// buffer stays persistently mapped; otherwise every allocation maps its range
+// with GL_MAP_UNSYNCHRONIZED_BIT, relying on the same fences.
+
+struct StreamAllocation {
+    void* data = nullptr; // write up to size bytes here, then streamCommit()
+    GLuint buffer = 0;    // bind this buffer...
+    GLintptr offset = 0;  // ...at this offset (a multiple of the requested alignment)
+    size_t size = 0;
+};
+
+struct StreamBufferStats {
+    bool persistent = false;     // persistently mapped (ARB_buffer_storage)
+    size_t frameCapacity = 0;    // bytes of each per-frame region
+    size_t frameBytes = 0;       // used by the last finished frame
+    long long allocations = 0;
+    long long overflows = 0;     // did not fit the region, uploaded with glBufferData instead
+    long long stalls = 0;        // frames that had to wait for the GPU to release their region
+    double stallMs = 0.0;        // total time spent in those waits
+};
+
+// Needs a current context. Regions grow (after a full GPU wait) once a frame
+// overflows them, so frameBytes is only the starting size.
+void initStreamBuffer(size_t frameBytes, bool persistent);
+void shutdownStreamBuffer();
+
+// Call once at the start of every frame: fences the previous region and
+// waits, if needed, until the GPU is done with the one that comes next
+void nextStreamFrame();
+
+// Space for size bytes in the current region. Only one allocation may be open
+// at a time: fill it and commit it before the next one and before drawing.
+StreamAllocation streamAlloc(size_t size, size_t alignment);
+// usedSize (<= the allocated size) returns the unused tail to the region
+void streamCommit(const StreamAllocation& allocation, size_t usedSize);
+
+// Alignment required for glBindBufferRange(GL_UNIFORM_BUFFER, ...)
+size_t streamUniformAlignment();
+
+StreamBufferStats getStreamBufferStats();
+
+#endif // STREAM_BUFFER_H
@@ -0,0 +1,214 @@
+#include "texture_array.h"
+#include "gl_state_cache.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Static copy of stb_rect_pack; stbrp_setup_heuristic() is never called
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui/imstb_rectpack.h"
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// One layer shared by several odd-sized textures
+struct AtlasLayer {
+    int layer;
+    stbrp_context context;
+    std::vector<stbrp_node> nodes;
+    std::vector<stbrp_rect> rects; // in packing order, replayed by releaseTexturesSince()
+};
+
+static GLuint arrayTextureID = 0;
+static int arrayWidth = 0;
+static int arrayHeight = 0;
+static int arrayLayerCapacity = 0;
+static int arrayLayerCount = 0;
+// stbrp_context keeps pointers into itself, so the layers must not move
+static std::vector<std::unique_ptr<AtlasLayer>> atlasLayers;
+
+// Texels around every packed texture, filled with its wrapped-around edges so
+// filtering at the UV window border samples what GL_REPEAT would
+static const int atlasPadding = 1;
+
+static void initAtlasContext(AtlasLayer& atlas)
+{
+    atlas.nodes.resize(arrayWidth);
+    stbrp_init_target(&atlas.context, arrayWidth, arrayHeight, atlas.nodes.data(), (int)atlas.nodes.size());
+}
+
+void initTextureArray(int layerWidth, int layerHeight, int maxLayers)
+{
+    GLint maxArrayLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxArrayLayers);
+
+    arrayWidth = layerWidth;
+    arrayHeight = layerHeight;
+    arrayLayerCapacity = std::min(maxLayers, (int)maxArrayLayers);
+    arrayLayerCount = 0;
+    atlasLayers.clear();
+
+    glGenTextures(1, &arrayTextureID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, arrayTextureID);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGB8, arrayWidth, arrayHeight, arrayLayerCapacity,
+                 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void shutdownTextureArray()
+{
+    if (arrayTextureID != 0) {
+        glDeleteTextures(1, &arrayTextureID);
+        arrayTextureID = 0;
+    }
+    atlasLayers.clear();
+    arrayLayerCount = 0;
+}
+
+static void uploadToLayer(int layer, int x, int y, int width, int height, const GLubyte* rgbData)
+{
+    glBindTexture(GL_TEXTURE_2D_ARRAY, arrayTextureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // RGB rows are not 4-byte aligned for odd widths
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, y, layer, width, height, 1,
+                    GL_RGB, GL_UNSIGNED_BYTE, rgbData);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+TextureSlot addTextureToArray(const GLubyte* rgbData, int width, int height)
+{
+    TextureSlot slot;
+
+    if (arrayTextureID == 0 || width > arrayWidth || height > arrayHeight) {
+        std::cerr << "Texture " << width << "x" << height << " does not fit the texture array ("
+                  << arrayWidth << "x" << arrayHeight << ")" << std::endl;
+        return slot;
+    }
+
+    // Same-size textures take a whole layer
+    if (width == arrayWidth && height == arrayHeight) {
+        if (arrayLayerCount >= arrayLayerCapacity) {
+            std::cerr << "Texture array is full (" << arrayLayerCapacity << " layers)" << std::endl;
+            return slot;
+        }
+        slot.layer = arrayLayerCount++;
+        uploadToLayer(slot.layer, 0, 0, width, height, rgbData);
+        return slot;
+    }
+
+    // Odd-sized textures are packed into shared atlas layers
+    stbrp_rect rect = {};
+    rect.w = width + atlasPadding * 2;
+    rect.h = height + atlasPadding * 2;
+    if (rect.w > arrayWidth || rect.h > arrayHeight) {
+        std::cerr << "Texture " << width << "x" << height << " does not fit an atlas layer with its padding" << std::endl;
+        return slot;
+    }
+
+    AtlasLayer* target = nullptr;
+    for (auto& atlas : atlasLayers) {
+        if (stbrp_pack_rects(&atlas->context, &rect, 1) && rect.was_packed) {
+            target = atlas.get();
+            break;
+        }
+    }
+
+    if (target == nullptr) {
+        if (arrayLayerCount >= arrayLayerCapacity) {
+            std::cerr << "Texture array is full (" << arrayLayerCapacity << " layers)" << std::endl;
+            return slot;
+        }
+        // An empty layer always takes a rect no larger than itself
+        auto atlas = std::make_unique<AtlasLayer>();
+        atlas->layer = arrayLayerCount++;
+        initAtlasContext(*atlas);
+        stbrp_pack_rects(&atlas->context, &rect, 1);
+        target = atlas.get();
+        atlasLayers.push_back(std::move(atlas));
+    }
+    target->rects.push_back(rect);
+
+    // Texture plus its wrapped border, uploaded in one go
+    int paddedWidth = rect.w, paddedHeight = rect.h;
+    std::vector<GLubyte> padded((size_t)paddedWidth * paddedHeight * 3);
+    for (int y = 0; y < paddedHeight; ++y) {
+        int sourceY = (y - atlasPadding + height) % height;
+        for (int x = 0; x < paddedWidth; ++x) {
+            int sourceX = (x - atlasPadding + width) % width;
+            const GLubyte* source = rgbData + ((size_t)sourceY * width + sourceX) * 3;
+            std::copy(source, source + 3, &padded[((size_t)y * paddedWidth + x) * 3]);
+        }
+    }
+    uploadToLayer(target->layer, rect.x, rect.y, paddedWidth, paddedHeight, padded.data());
+
+    slot.layer = target->layer;
+    slot.uvOffset[0] = (float)(rect.x + atlasPadding) / arrayWidth;
+    slot.uvOffset[1] = (float)(rect.y + atlasPadding) / arrayHeight;
+    slot.uvScale[0] = (float)width / arrayWidth;
+    slot.uvScale[1] = (float)height / arrayHeight;
+    return slot;
+}
+
+TextureArrayMark markTextureArray()
+{
+    TextureArrayMark mark;
+    mark.layerCount = arrayLayerCount;
+    for (const auto& atlas : atlasLayers)
+        mark.atlasRects.push_back(atlas->rects.size());
+    return mark;
+}
+
+void releaseTexturesSince(const TextureArrayMark& mark)
+{
+    if (arrayTextureID == 0)
+        return;
+    arrayLayerCount = std::min(arrayLayerCount, mark.layerCount);
+    atlasLayers.resize(std::min(atlasLayers.size(), mark.atlasRects.size()));
+
+    // stbrp can't free a rect: repack the ones kept, in their original order,
+    // which puts every one of them back where it was
+    for (size_t i = 0; i < atlasLayers.size(); ++i) {
+        AtlasLayer& atlas = *atlasLayers[i];
+        if (atlas.rects.size() == mark.atlasRects[i])
+            continue;
+        atlas.rects.resize(mark.atlasRects[i]);
+        initAtlasContext(atlas);
+        for (stbrp_rect& rect : atlas.rects)
+            stbrp_pack_rects(&atlas.context, &rect, 1);
+    }
+}
+
+void bindTextureArray(GLuint unit)
+{
+    cachedActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, arrayTextureID);
+}
+
+void setTextureSlotUniforms(GLuint program, const TextureSlot& slot)
+{
+    glUniform1f(glGetUniformLocation(program, "textureLayer"), (float)slot.layer);
+    glUniform4f(glGetUniformLocation(program, "textureUVRect"),
+                slot.uvOffset[0], slot.uvOffset[1], slot.uvScale[0], slot.uvScale[1]);
+}
+
+GLuint getTextureArrayID()
+{
+    return arrayTextureID;
+}
+
+int getTextureArrayLayerCount()
+{
+    return arrayLayerCount;
+}
@@ -0,0 +1,46 @@
+#ifndef TEXTURE_ARRAY_H
+#define TEXTURE_ARRAY_H
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+// Where a material texture lives inside the shared GL_TEXTURE_2D_ARRAY:
+// the layer index and the UV window it occupies on that layer
+// (offset 0 / scale 1 for textures that fill a whole layer).
+struct TextureSlot {
+    int layer = -1;
+    float uvOffset[2] = {0.0f, 0.0f};
+    float uvScale[2] = {1.0f, 1.0f};
+};
+
+// Creates the array texture. Every layer is layerWidth x layerHeight RGB;
+// maxLayers is clamped to GL_MAX_ARRAY_TEXTURE_LAYERS.
+void initTextureArray(int layerWidth, int layerHeight, int maxLayers);
+void shutdownTextureArray();
+
+// Uploads an RGB texture and returns its slot. Textures with the layer size
+// get a layer of their own, smaller ones are packed (imstb_rectpack) into
+// shared atlas layers. Returns a slot with layer == -1 when it doesn't fit.
+TextureSlot addTextureToArray(const GLubyte* rgbData, int width, int height);
+
+// Textures added after a mark can be released together, e.g. a model's when
+// it is replaced; their layers and atlas space are reused by later uploads.
+struct TextureArrayMark {
+    int layerCount = 0;
+    std::vector<size_t> atlasRects; // rects held by each atlas layer
+};
+TextureArrayMark markTextureArray();
+void releaseTexturesSince(const TextureArrayMark& mark);
+
+// Binds the array to the given texture unit; one bind serves every textured object.
+void bindTextureArray(GLuint unit);
+
+// Sets the per-object layer/UV uniforms (textureLayer, textureUVRect).
+void setTextureSlotUniforms(GLuint program, const TextureSlot& slot);
+
+GLuint getTextureArrayID();
+int getTextureArrayLayerCount();
+
+#endif // TEXTURE_ARRAY_H
@@ -0,0 +1,57 @@
+// Converts OBJ/PLY meshes to the binary .mesh cache format (see src/mesh_cache.h)
+// so the app can map them at startup instead of parsing. The LOD chain
+// (mesh_simplify.h) and the meshlets (meshlet.h) are generated here and
+// stored with the mesh.
+//
+//   mesh_convert input.obj|input.ply [output.mesh]
+//
+// Without an output path the cache is written next to the input as <input>.mesh,
+// which is where loadSceneModel() looks for it.
+
+#include "mesh_cache.h"
+#include "mesh_loader.h"
+#include "mesh_simplify.h"
+#include "meshlet.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " input.obj|input.ply [output.mesh]" << std::endl;
+        return 1;
+    }
+    std::string inputPath = argv[1];
+    std::string outputPath = argc == 3 ? argv[2] : inputPath + ".mesh";
+
+    MeshData mesh;
+    MeshLoadStats stats;
+    if (!loadMesh(inputPath.c_str(), mesh, &stats))
+        return 1;
+    std::cout << inputPath << ": " << mesh.vertexCount() << " vertices, " << mesh.triangleCount() << " triangles"
+              << " (map " << stats.mapMs << " ms, parse " << stats.parseMs << " ms on " << stats.threads
+              << " threads, weld " << stats.weldMs << " ms)" << std::endl;
+
+    auto lodBegin = std::chrono::steady_clock::now();
+    generateMeshLods(mesh);
+    double lodMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lodBegin).count();
+    std::cout << mesh.lods.size() << " LODs in " << lodMs << " ms:";
+    for (const MeshLod& lod : mesh.lods)
+        std::cout << " " << lod.indexCount / 3 << " (error " << lod.error << ")";
+    std::cout << std::endl;
+
+    auto meshletBegin = std::chrono::steady_clock::now();
+    buildMeshlets(mesh);
+    double meshletMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - meshletBegin).count();
+    std::cout << mesh.meshlets.size() << " meshlets in " << meshletMs << " ms" << std::endl;
+
+    auto begin = std::chrono::steady_clock::now();
+    if (!writeMeshCache(outputPath.c_str(), mesh))
+        return 1;
+    double writeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "Wrote " << outputPath << " in " << writeMs << " ms" << std::endl;
+    return 0;
+}